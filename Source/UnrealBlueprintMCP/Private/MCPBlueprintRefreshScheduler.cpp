@@ -0,0 +1,185 @@
+#include "MCPBlueprintRefreshScheduler.h"
+#include "Engine/Blueprint.h"
+#include "Editor.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "BlueprintCompilationManager.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/UObjectGlobals.h"
+
+FMCPBlueprintRefreshScheduler::FMCPBlueprintRefreshScheduler()
+	: DelaySeconds(0.2)
+{
+}
+
+FMCPBlueprintRefreshScheduler::~FMCPBlueprintRefreshScheduler()
+{
+	Shutdown();
+}
+
+void FMCPBlueprintRefreshScheduler::Start()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPBlueprintRefreshScheduler::Tick));
+		PreSaveHandle = FCoreUObjectDelegates::OnObjectPreSave.AddRaw(this, &FMCPBlueprintRefreshScheduler::HandleObjectPreSave);
+		PreBeginPIEHandle = FEditorDelegates::PreBeginPIE.AddRaw(this, &FMCPBlueprintRefreshScheduler::HandlePreBeginPIE);
+	}
+}
+
+void FMCPBlueprintRefreshScheduler::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		FCoreUObjectDelegates::OnObjectPreSave.Remove(PreSaveHandle);
+		FEditorDelegates::PreBeginPIE.Remove(PreBeginPIEHandle);
+		TickerHandle.Reset();
+		PreSaveHandle.Reset();
+		PreBeginPIEHandle.Reset();
+
+		// Nothing may be left with stale nodes once the server stops; edits made while it is
+		// stopped are refreshed right away, so only a running scheduler has anything pending
+		FlushAll();
+	}
+}
+
+void FMCPBlueprintRefreshScheduler::SetDelay(double Seconds)
+{
+	DelaySeconds.store(FMath::Max(0.0, Seconds), std::memory_order_relaxed);
+}
+
+void FMCPBlueprintRefreshScheduler::MarkDirty(UBlueprint& Blueprint, bool bCompile)
+{
+	check(IsInGameThread());
+	Edits.Increment();
+
+	// Stopped, or no delay: refresh right away, as every edit used to
+	if (!TickerHandle.IsValid() || DelaySeconds.load(std::memory_order_relaxed) <= 0.0)
+	{
+		TArray<FPending> Entries;
+		Entries.Add({&Blueprint, bCompile});
+		Refresh(MoveTemp(Entries));
+		return;
+	}
+
+	LastEditSeconds = FPlatformTime::Seconds();
+	for (FPending& Pending : PendingBlueprints)
+	{
+		if (Pending.Blueprint.Get() == &Blueprint)
+		{
+			Pending.bCompile |= bCompile;
+			Coalesced.Increment();
+			return;
+		}
+	}
+	PendingBlueprints.Add({&Blueprint, bCompile});
+	PendingCount.Set(PendingBlueprints.Num());
+}
+
+void FMCPBlueprintRefreshScheduler::Flush(TConstArrayView<UBlueprint*> Blueprints)
+{
+	check(IsInGameThread());
+
+	TArray<FPending> Entries;
+	for (int32 Index = PendingBlueprints.Num() - 1; Index >= 0; --Index)
+	{
+		UBlueprint* Pending = PendingBlueprints[Index].Blueprint.Get();
+		if (Pending && Blueprints.Contains(Pending))
+		{
+			Entries.Insert(PendingBlueprints[Index], 0);
+			PendingBlueprints.RemoveAt(Index);
+		}
+	}
+	if (Entries.Num() > 0)
+	{
+		PendingCount.Set(PendingBlueprints.Num());
+		ForcedFlushes.Increment();
+		Refresh(MoveTemp(Entries));
+	}
+}
+
+void FMCPBlueprintRefreshScheduler::FlushAll()
+{
+	check(IsInGameThread());
+
+	// Refreshing can run arbitrary editor code, which may edit and mark another Blueprint
+	TArray<FPending> Entries = MoveTemp(PendingBlueprints);
+	PendingBlueprints.Reset();
+	PendingCount.Set(0);
+	Refresh(MoveTemp(Entries));
+}
+
+void FMCPBlueprintRefreshScheduler::Refresh(TArray<FPending>&& Entries)
+{
+	TArray<UBlueprint*, TInlineAllocator<8>> ToCompile;
+	for (const FPending& Pending : Entries)
+	{
+		UBlueprint* Blueprint = Pending.Blueprint.Get();
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		// Mark Blueprint as modified and regenerate
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
+		Refreshes.Increment();
+
+		if (Pending.bCompile)
+		{
+			ToCompile.Add(Blueprint);
+		}
+	}
+
+	// Blueprints that depend on each other are compiled and reinstanced once, together
+	if (ToCompile.Num() > 0)
+	{
+		for (UBlueprint* Blueprint : ToCompile)
+		{
+			FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+		}
+		FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+		Compiles.Add(ToCompile.Num());
+		CompilePasses.Increment();
+	}
+}
+
+bool FMCPBlueprintRefreshScheduler::Tick(float DeltaTime)
+{
+	if (PendingBlueprints.Num() > 0 && FPlatformTime::Seconds() - LastEditSeconds >= DelaySeconds.load(std::memory_order_relaxed))
+	{
+		FlushAll();
+	}
+	return true;
+}
+
+void FMCPBlueprintRefreshScheduler::HandleObjectPreSave(UObject* Object, FObjectPreSaveContext Context)
+{
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+	{
+		Flush(*Blueprint);
+	}
+}
+
+void FMCPBlueprintRefreshScheduler::HandlePreBeginPIE(bool bIsSimulating)
+{
+	if (PendingBlueprints.Num() > 0)
+	{
+		ForcedFlushes.Increment();
+		FlushAll();
+	}
+}
+
+FMCPBlueprintRefreshStats FMCPBlueprintRefreshScheduler::GetStats() const
+{
+	FMCPBlueprintRefreshStats Stats;
+	Stats.DelayMs = DelaySeconds.load(std::memory_order_relaxed) * 1000.0;
+	Stats.Pending = PendingCount.GetValue();
+	Stats.Edits = Edits.GetValue();
+	Stats.Refreshes = Refreshes.GetValue();
+	Stats.Coalesced = Coalesced.GetValue();
+	Stats.Compiles = Compiles.GetValue();
+	Stats.CompilePasses = CompilePasses.GetValue();
+	Stats.ForcedFlushes = ForcedFlushes.GetValue();
+	return Stats;
+}
@@ -0,0 +1,357 @@
+#include "MCPConnectionReactor.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+
+FMCPConnection::FMCPConnection(FMCPLocalSocket* InSocket, int32 MaxHeaderBytes, int64 MaxBodyBytes)
+	: Socket(InSocket)
+	, Parser(MaxHeaderBytes, MaxBodyBytes)
+{
+}
+
+FMCPConnectionReactor::FMCPConnectionReactor()
+	: Thread(nullptr)
+	, WakeReader(nullptr)
+	, WakeWriter(nullptr)
+	, bAcceptingParks(false)
+	, bStopping(false)
+	, bCloseIdle(false)
+	, Wheel(TickSeconds, NumSlots)
+	, TimerWheel(TickSeconds, NumSlots)
+{
+}
+
+FMCPConnectionReactor::~FMCPConnectionReactor()
+{
+	Shutdown();
+}
+
+bool FMCPConnectionReactor::Start(FConnectionCallback InOnReady, FConnectionCallback InOnClose)
+{
+	if (Thread)
+	{
+		return false;
+	}
+
+	if (!FMCPLocalSocket::CreatePair(WakeReader, WakeWriter))
+	{
+		return false;
+	}
+	WakeReader->SetNonBlocking(true);
+	WakeWriter->SetNonBlocking(true);
+
+	OnReady = MoveTemp(InOnReady);
+	OnClose = MoveTemp(InOnClose);
+	bStopping = false;
+	bCloseIdle = false;
+	{
+		FScopeLock Lock(&IncomingLock);
+		bAcceptingParks = true;
+	}
+
+	Thread = FRunnableThread::Create(this, TEXT("MCPConnectionReactor"));
+	if (!Thread)
+	{
+		Shutdown();
+		return false;
+	}
+	return true;
+}
+
+void FMCPConnectionReactor::Shutdown()
+{
+	{
+		FScopeLock Lock(&IncomingLock);
+		bAcceptingParks = false;
+	}
+
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	// The thread is gone, so whatever it was watching is ours to close
+	TArray<FMCPConnection*> Remaining = MoveTemp(Parked);
+	Parked.Reset();
+	TArray<FTimer> RemainingTimers;
+	{
+		FScopeLock Lock(&IncomingLock);
+		Remaining.Append(MoveTemp(Incoming));
+		Incoming.Reset();
+		RemainingTimers = MoveTemp(IncomingTimers);
+		IncomingTimers.Reset();
+	}
+
+	// Nothing will advance the timers any more, so whatever they were waiting to give up on goes now
+	for (FTimerCallback& Callback : Timers)
+	{
+		Callback();
+	}
+	Timers.Empty();
+	TimerWheel = FMCPTimerWheel(TickSeconds, NumSlots);
+	for (FTimer& Timer : RemainingTimers)
+	{
+		Timer.Callback();
+	}
+
+	for (FMCPConnection* Connection : Remaining)
+	{
+		Wheel.Cancel(Connection->TimerId);
+		Connection->TimerId = INDEX_NONE;
+		Connection->ParkedIndex = INDEX_NONE;
+		ParkedConnections.Decrement();
+		OnClose(Connection);
+	}
+
+	delete WakeReader;
+	delete WakeWriter;
+	WakeReader = nullptr;
+	WakeWriter = nullptr;
+}
+
+void FMCPConnectionReactor::Park(FMCPConnection* Connection)
+{
+	bool bWasEmpty = false;
+	{
+		FScopeLock Lock(&IncomingLock);
+		if (bAcceptingParks)
+		{
+			bWasEmpty = Incoming.Num() == 0;
+			Incoming.Add(Connection);
+			ParkedConnections.Increment();
+			Connection = nullptr;
+		}
+	}
+
+	if (Connection)
+	{
+		OnClose(Connection);
+	}
+	else if (bWasEmpty)
+	{
+		// Later parks find Incoming non-empty and know a wake-up is already on its way
+		Wake();
+	}
+}
+
+void FMCPConnectionReactor::AddTimer(double DeadlineSeconds, FTimerCallback Callback)
+{
+	bool bAdded = false;
+	bool bWasEmpty = false;
+	{
+		FScopeLock Lock(&IncomingLock);
+		if (bAcceptingParks)
+		{
+			bWasEmpty = IncomingTimers.Num() == 0;
+			IncomingTimers.Add(FTimer{DeadlineSeconds, MoveTemp(Callback)});
+			bAdded = true;
+		}
+	}
+
+	if (!bAdded)
+	{
+		Callback();
+	}
+	else if (bWasEmpty)
+	{
+		Wake();
+	}
+}
+
+void FMCPConnectionReactor::CloseIdleConnections()
+{
+	bCloseIdle = true;
+	Wake();
+}
+
+FMCPConnectionReactorStats FMCPConnectionReactor::GetStats() const
+{
+	FMCPConnectionReactorStats Stats;
+	Stats.ParkedConnections = ParkedConnections.GetValue();
+	Stats.IdleTimeouts = IdleTimeouts.GetValue();
+	Stats.ReadTimeouts = ReadTimeouts.GetValue();
+	Stats.WriteTimeouts = WriteTimeouts.GetValue();
+	return Stats;
+}
+
+uint32 FMCPConnectionReactor::Run()
+{
+	TArray<FMCPConnection*> Adopting;
+	TArray<FTimer> AddingTimers;
+	TArray<FMCPConnection*> Ready;
+	TArray<FMCPConnection*> Closed;
+	TArray<UPTRINT> Expired;
+
+	while (!bStopping)
+	{
+		{
+			FScopeLock Lock(&IncomingLock);
+			Swap(Adopting, Incoming);
+			Swap(AddingTimers, IncomingTimers);
+		}
+		for (FMCPConnection* Connection : Adopting)
+		{
+			Adopt(Connection, Closed);
+		}
+		Adopting.Reset();
+		for (FTimer& Timer : AddingTimers)
+		{
+			const int32 Index = Timers.Add(MoveTemp(Timer.Callback));
+			TimerWheel.Schedule(Timer.DeadlineSeconds, (UPTRINT)Index);
+		}
+		AddingTimers.Reset();
+
+		if (bCloseIdle)
+		{
+			for (int32 Index = Parked.Num() - 1; Index >= 0; --Index)
+			{
+				FMCPConnection* Connection = Parked[Index];
+				if (Connection->Phase == EMCPConnectionPhase::Idle)
+				{
+					Unpark(Connection);
+					Closed.Add(Connection);
+				}
+			}
+		}
+
+		// Closing does not need to wait for the poll
+		for (FMCPConnection* Connection : Closed)
+		{
+			OnClose(Connection);
+		}
+		Closed.Reset();
+
+		// Entry 0 is the wake socket; the rest mirror Parked index for index
+		PollEntries.SetNum(Parked.Num() + 1, EAllowShrinking::No);
+		PollEntries[0].Socket = WakeReader;
+		PollEntries[0].Condition = ESocketWaitConditions::WaitForRead;
+		for (int32 Index = 0; Index < Parked.Num(); ++Index)
+		{
+			PollEntries[Index + 1].Socket = Parked[Index]->Socket;
+			PollEntries[Index + 1].Condition = Parked[Index]->Phase == EMCPConnectionPhase::Writing
+				? ESocketWaitConditions::WaitForWrite
+				: ESocketWaitConditions::WaitForRead;
+		}
+
+		// With nothing parked and no timers there are no deadlines to watch, so only Wake() ends the wait
+		const bool bHasDeadlines = Parked.Num() > 0 || Timers.Num() > 0;
+		const FTimespan WaitTime = bHasDeadlines ? FTimespan::FromSeconds(Wheel.GetTickSeconds()) : FTimespan::FromSeconds(-1.0);
+		if (FMCPLocalSocket::Poll(PollEntries, WaitTime) < 0)
+		{
+			// Interrupted or out of resources; back off briefly rather than spin on a persistent error
+			PollEntries.SetNum(0, EAllowShrinking::No);
+			FPlatformProcess::SleepNoStats(0.001f);
+		}
+
+		if (PollEntries.Num() > 0 && PollEntries[0].bReady)
+		{
+			uint8 Discard[64];
+			int32 BytesRead = 0;
+			while (WakeReader->Recv(Discard, sizeof(Discard), BytesRead) && BytesRead > 0)
+			{
+			}
+		}
+
+		// Walk backwards so Unpark()'s swap-removal only moves entries that were already checked
+		for (int32 Index = FMath::Min(Parked.Num(), PollEntries.Num() - 1) - 1; Index >= 0; --Index)
+		{
+			if (PollEntries[Index + 1].bReady)
+			{
+				FMCPConnection* Connection = Parked[Index];
+				Unpark(Connection);
+				Ready.Add(Connection);
+			}
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		TimerWheel.Advance(Now, Expired);
+		for (UPTRINT Key : Expired)
+		{
+			FTimerCallback Callback = MoveTemp(Timers[(int32)Key]);
+			Timers.RemoveAt((int32)Key);
+			Callback();
+		}
+		Expired.Reset();
+
+		Wheel.Advance(Now, Expired);
+		for (UPTRINT Key : Expired)
+		{
+			FMCPConnection* Connection = (FMCPConnection*)Key;
+			Connection->TimerId = INDEX_NONE;
+			Unpark(Connection);
+			switch (Connection->Phase)
+			{
+			case EMCPConnectionPhase::Idle:
+				IdleTimeouts.Increment();
+				break;
+			case EMCPConnectionPhase::Reading:
+				ReadTimeouts.Increment();
+				break;
+			case EMCPConnectionPhase::Writing:
+				WriteTimeouts.Increment();
+				break;
+			}
+			Closed.Add(Connection);
+		}
+		Expired.Reset();
+
+		for (FMCPConnection* Connection : Ready)
+		{
+			OnReady(Connection);
+		}
+		for (FMCPConnection* Connection : Closed)
+		{
+			OnClose(Connection);
+		}
+		Ready.Reset();
+		Closed.Reset();
+	}
+	return 0;
+}
+
+void FMCPConnectionReactor::Stop()
+{
+	bStopping = true;
+	Wake();
+}
+
+void FMCPConnectionReactor::Wake()
+{
+	// A full pipe already guarantees a wake-up, so a failed send needs no retry
+	const uint8 Byte = 0;
+	int32 BytesSent = 0;
+	if (WakeWriter)
+	{
+		WakeWriter->Send(&Byte, 1, BytesSent);
+	}
+}
+
+void FMCPConnectionReactor::Adopt(FMCPConnection* Connection, TArray<FMCPConnection*>& OutClosed)
+{
+	if (bCloseIdle && Connection->Phase == EMCPConnectionPhase::Idle)
+	{
+		ParkedConnections.Decrement();
+		OutClosed.Add(Connection);
+		return;
+	}
+
+	Connection->ParkedIndex = Parked.Add(Connection);
+	Connection->TimerId = Wheel.Schedule(Connection->Deadline, (UPTRINT)Connection);
+}
+
+void FMCPConnectionReactor::Unpark(FMCPConnection* Connection)
+{
+	Wheel.Cancel(Connection->TimerId);
+	Connection->TimerId = INDEX_NONE;
+
+	const int32 Index = Connection->ParkedIndex;
+	Parked.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Index < Parked.Num())
+	{
+		Parked[Index]->ParkedIndex = Index;
+	}
+	Connection->ParkedIndex = INDEX_NONE;
+	ParkedConnections.Decrement();
+}
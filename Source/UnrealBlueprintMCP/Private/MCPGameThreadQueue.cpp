@@ -0,0 +1,196 @@
+#include "MCPGameThreadQueue.h"
+#include "Misc/ScopeExit.h"
+
+namespace MCPGameThreadQueue
+{
+	static void UpdateMax(std::atomic<int64>& Max, int64 Value)
+	{
+		int64 Current = Max.load(std::memory_order_relaxed);
+		while (Value > Current && !Max.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	static void UpdateMax(std::atomic<int32>& Max, int32 Value)
+	{
+		int32 Current = Max.load(std::memory_order_relaxed);
+		while (Value > Current && !Max.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+		{
+		}
+	}
+}
+
+double FMCPLatencyHistogramSnapshot::GetBucketUpperMs(int32 Index)
+{
+	return (double)(1ll << Index) / 1000.0;
+}
+
+double FMCPLatencyHistogramSnapshot::GetPercentileMs(double Fraction) const
+{
+	const int64 Target = FMath::Max<int64>(1, (int64)FMath::CeilToDouble(Fraction * (double)Count));
+	int64 Seen = 0;
+	for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+	{
+		Seen += Buckets[Index];
+		if (Seen >= Target)
+		{
+			return FMath::Min(GetBucketUpperMs(Index), MaxMs);
+		}
+	}
+	return MaxMs;
+}
+
+FMCPLatencyHistogram::FMCPLatencyHistogram()
+	: Count(0)
+	, TotalMicroseconds(0)
+	, MaxMicroseconds(0)
+{
+	for (std::atomic<int64>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+void FMCPLatencyHistogram::Add(double Seconds)
+{
+	const int64 Microseconds = FMath::Max<int64>(0, (int64)(Seconds * 1000000.0));
+	const int32 Index = Microseconds <= 1 ? 0 : FMath::Min<int32>(NumBuckets - 1, (int32)FMath::CeilLogTwo64((uint64)Microseconds));
+	Buckets[Index].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	TotalMicroseconds.fetch_add(Microseconds, std::memory_order_relaxed);
+	MCPGameThreadQueue::UpdateMax(MaxMicroseconds, Microseconds);
+}
+
+FMCPLatencyHistogramSnapshot FMCPLatencyHistogram::GetSnapshot() const
+{
+	FMCPLatencyHistogramSnapshot Snapshot;
+	Snapshot.Buckets.SetNum(NumBuckets);
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Snapshot.Buckets[Index] = Buckets[Index].load(std::memory_order_relaxed);
+		Snapshot.Count += Snapshot.Buckets[Index];
+	}
+	Snapshot.TotalMs = (double)TotalMicroseconds.load(std::memory_order_relaxed) / 1000.0;
+	Snapshot.MaxMs = (double)MaxMicroseconds.load(std::memory_order_relaxed) / 1000.0;
+	return Snapshot;
+}
+
+FMCPGameThreadQueue::FMCPGameThreadQueue()
+	: BudgetSeconds(0.005)
+	, PeakQueueDepth(0)
+	, MaxTasksPerDrain(0)
+{
+}
+
+FMCPGameThreadQueue::~FMCPGameThreadQueue()
+{
+	Shutdown();
+}
+
+void FMCPGameThreadQueue::Start()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPGameThreadQueue::Tick));
+	}
+}
+
+void FMCPGameThreadQueue::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+void FMCPGameThreadQueue::SetBudget(double Seconds)
+{
+	BudgetSeconds.store(FMath::Max(0.0, Seconds), std::memory_order_relaxed);
+}
+
+void FMCPGameThreadQueue::Enqueue(TUniqueFunction<void()>&& Task)
+{
+	FTask Queued;
+	Queued.Function = MoveTemp(Task);
+	Queued.EnqueueSeconds = FPlatformTime::Seconds();
+	MCPGameThreadQueue::UpdateMax(PeakQueueDepth, QueueDepth.Increment());
+	Tasks.Enqueue(MoveTemp(Queued));
+}
+
+int32 FMCPGameThreadQueue::Drain(double InBudgetSeconds)
+{
+	check(IsInGameThread());
+
+	// A task that pumps the ticker itself, e.g. through a modal dialog, must not start a nested drain
+	if (bDraining)
+	{
+		return 0;
+	}
+	bDraining = true;
+	ON_SCOPE_EXIT { bDraining = false; };
+
+	const double DrainStart = FPlatformTime::Seconds();
+	double Now = DrainStart;
+	int32 TasksRun = 0;
+	FTask Task;
+	while (Tasks.Dequeue(Task))
+	{
+		QueueDepth.Decrement();
+		const double TaskStart = Now;
+		QueueWait.Add(TaskStart - Task.EnqueueSeconds);
+
+		Task.Function();
+		Task.Function = nullptr;
+
+		Now = FPlatformTime::Seconds();
+		Execute.Add(Now - TaskStart);
+		++TasksRun;
+		if (Now - DrainStart >= InBudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (TasksRun > 0)
+	{
+		const double Elapsed = Now - DrainStart;
+		DrainTime.Add(Elapsed);
+		Drains.Increment();
+		TasksExecuted.Add(TasksRun);
+		MCPGameThreadQueue::UpdateMax(MaxTasksPerDrain, TasksRun);
+		if (Elapsed > InBudgetSeconds)
+		{
+			OverBudgetDrains.Increment();
+		}
+	}
+	return TasksRun;
+}
+
+bool FMCPGameThreadQueue::Tick(float DeltaTime)
+{
+	if (QueueDepth.GetValue() > 0)
+	{
+		FrameTime.Add(DeltaTime);
+		Drain(BudgetSeconds.load(std::memory_order_relaxed));
+	}
+	return true;
+}
+
+FMCPGameThreadQueueStats FMCPGameThreadQueue::GetStats() const
+{
+	FMCPGameThreadQueueStats Stats;
+	Stats.BudgetMs = BudgetSeconds.load(std::memory_order_relaxed) * 1000.0;
+	Stats.QueueDepth = QueueDepth.GetValue();
+	Stats.PeakQueueDepth = PeakQueueDepth.load(std::memory_order_relaxed);
+	Stats.TasksExecuted = TasksExecuted.GetValue();
+	Stats.Drains = Drains.GetValue();
+	Stats.MaxTasksPerDrain = MaxTasksPerDrain.load(std::memory_order_relaxed);
+	Stats.OverBudgetDrains = OverBudgetDrains.GetValue();
+	Stats.SkippedCalls = SkippedCalls.GetValue();
+	Stats.QueueWait = QueueWait.GetSnapshot();
+	Stats.Execute = Execute.GetSnapshot();
+	Stats.DrainTime = DrainTime.GetSnapshot();
+	Stats.FrameTime = FrameTime.GetSnapshot();
+	return Stats;
+}
@@ -0,0 +1,368 @@
+#include "MCPHttpRequestParser.h"
+
+namespace MCPHttpRequestParser
+{
+	/** Smallest receive we suggest; keeps syscall count sane for header-only traffic */
+	static constexpr int32 MinReadSize = 4 * 1024;
+
+	/** Largest receive we suggest while a body is pending */
+	static constexpr int32 MaxReadSize = 1024 * 1024;
+
+	/** Buffers that grew beyond this for one large request are released after it is consumed */
+	static constexpr int32 RetainedBufferBytes = 256 * 1024;
+
+	static bool IsTokenChar(ANSICHAR Char)
+	{
+		return Char > 32 && Char < 127 && !FCStringAnsi::Strchr("()<>@,;:\\\"/[]?={}", Char);
+	}
+
+	static bool HasConnectionToken(const FString& HeaderValue, const TCHAR* Token)
+	{
+		TArray<FString> Tokens;
+		HeaderValue.ParseIntoArray(Tokens, TEXT(","));
+		for (const FString& Candidate : Tokens)
+		{
+			if (Candidate.TrimStartAndEnd().Equals(Token, ESearchCase::IgnoreCase))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+const FString* FMCPHttpRequest::FindHeader(const TCHAR* LowerCaseName) const
+{
+	for (const TPair<FString, FString>& Header : Headers)
+	{
+		if (Header.Key.Equals(LowerCaseName, ESearchCase::CaseSensitive))
+		{
+			return &Header.Value;
+		}
+	}
+	return nullptr;
+}
+
+bool FMCPHttpRequest::IsKeepAlive() const
+{
+	// HTTP/1.1 connections are persistent by default, HTTP/1.0 ones only when asked for
+	const FString* Connection = FindHeader(TEXT("connection"));
+	if (Version == TEXT("HTTP/1.0"))
+	{
+		return Connection && MCPHttpRequestParser::HasConnectionToken(*Connection, TEXT("keep-alive"));
+	}
+	return !Connection || !MCPHttpRequestParser::HasConnectionToken(*Connection, TEXT("close"));
+}
+
+void FMCPHttpRequest::Reset()
+{
+	Method.Reset();
+	Target.Reset();
+	Version.Reset();
+	Headers.Reset();
+	Body = TArrayView<const uint8>();
+}
+
+FMCPHttpRequestParser::FMCPHttpRequestParser(int32 InMaxHeaderBytes, int64 InMaxBodyBytes)
+	: ValidBytes(0)
+	, ScanOffset(0)
+	, LineStart(0)
+	, BodyStart(0)
+	, ContentLength(0)
+	, MaxHeaderBytes(InMaxHeaderBytes)
+	, MaxBodyBytes(InMaxBodyBytes)
+	, State(EState::RequestLine)
+	, ErrorStatusCode(0)
+{
+}
+
+uint8* FMCPHttpRequestParser::GetWriteBuffer(int32 MinBytes)
+{
+	if (Buffer.Num() - ValidBytes < MinBytes)
+	{
+		Buffer.SetNumUninitialized(ValidBytes + MinBytes, EAllowShrinking::No);
+	}
+	return Buffer.GetData() + ValidBytes;
+}
+
+void FMCPHttpRequestParser::CommitWrite(int32 BytesWritten)
+{
+	check(BytesWritten >= 0 && ValidBytes + BytesWritten <= Buffer.Num());
+	ValidBytes += BytesWritten;
+}
+
+int32 FMCPHttpRequestParser::GetRecommendedReadSize() const
+{
+	if (State == EState::Body)
+	{
+		const int64 Remaining = ContentLength - (ValidBytes - BodyStart);
+		return (int32)FMath::Clamp<int64>(Remaining, MCPHttpRequestParser::MinReadSize, MCPHttpRequestParser::MaxReadSize);
+	}
+	return MCPHttpRequestParser::MinReadSize;
+}
+
+int32 FMCPHttpRequestParser::FindLineEnd(int32& OutNextLineStart)
+{
+	const uint8* Data = Buffer.GetData();
+	for (int32 Index = ScanOffset; Index < ValidBytes; ++Index)
+	{
+		if (Data[Index] == '\n')
+		{
+			OutNextLineStart = Index + 1;
+			const int32 LineEnd = (Index > LineStart && Data[Index - 1] == '\r') ? Index - 1 : Index;
+			return LineEnd - LineStart;
+		}
+	}
+
+	// Remember how far we got so the next Parse() does not rescan these bytes
+	ScanOffset = ValidBytes;
+	return INDEX_NONE;
+}
+
+EMCPHttpParseResult FMCPHttpRequestParser::Parse()
+{
+	while (true)
+	{
+		switch (State)
+		{
+		case EState::RequestLine:
+		case EState::Headers:
+		{
+			int32 NextLineStart = 0;
+			const int32 LineLength = FindLineEnd(NextLineStart);
+			if (LineLength == INDEX_NONE)
+			{
+				if (ValidBytes > MaxHeaderBytes)
+				{
+					return SetError(431, TEXT("Request header fields too large"));
+				}
+				return EMCPHttpParseResult::NeedMoreData;
+			}
+			if (NextLineStart > MaxHeaderBytes)
+			{
+				return SetError(431, TEXT("Request header fields too large"));
+			}
+
+			const ANSICHAR* Line = (const ANSICHAR*)Buffer.GetData() + LineStart;
+			if (State == EState::RequestLine)
+			{
+				// Empty lines before the request line are ignored (RFC 9112 section 2.2)
+				if (LineLength > 0)
+				{
+					if (!ParseRequestLine(Line, LineLength))
+					{
+						return SetError(400, TEXT("Malformed request line"));
+					}
+					State = EState::Headers;
+				}
+			}
+			else if (LineLength == 0)
+			{
+				BodyStart = NextLineStart;
+				if (!OnHeadersComplete())
+				{
+					return EMCPHttpParseResult::Error;
+				}
+				State = EState::Body;
+			}
+			else if (!ParseHeaderLine(Line, LineLength))
+			{
+				return SetError(400, TEXT("Malformed header field"));
+			}
+
+			LineStart = NextLineStart;
+			ScanOffset = NextLineStart;
+			break;
+		}
+
+		case EState::Body:
+			if ((int64)(ValidBytes - BodyStart) < ContentLength)
+			{
+				return EMCPHttpParseResult::NeedMoreData;
+			}
+			Request.Body = TArrayView<const uint8>(Buffer.GetData() + BodyStart, (int32)ContentLength);
+			State = EState::Complete;
+			return EMCPHttpParseResult::Complete;
+
+		case EState::Complete:
+			return EMCPHttpParseResult::Complete;
+
+		case EState::Error:
+		default:
+			return EMCPHttpParseResult::Error;
+		}
+	}
+}
+
+void FMCPHttpRequestParser::ConsumeRequest()
+{
+	// After an error the stream position is unknown, so everything buffered is discarded
+	const int32 RequestEnd = (State == EState::Complete) ? BodyStart + (int32)ContentLength : ValidBytes;
+	const int32 Remaining = ValidBytes - RequestEnd;
+	if (Remaining > 0)
+	{
+		FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + RequestEnd, Remaining);
+	}
+	ValidBytes = Remaining;
+
+	if (Buffer.Max() > MCPHttpRequestParser::RetainedBufferBytes && ValidBytes <= MCPHttpRequestParser::RetainedBufferBytes)
+	{
+		Buffer.SetNum(ValidBytes);
+		Buffer.Shrink();
+	}
+
+	State = EState::RequestLine;
+	ScanOffset = 0;
+	LineStart = 0;
+	BodyStart = 0;
+	ContentLength = 0;
+	ErrorStatusCode = 0;
+	ErrorMessage.Reset();
+	Request.Reset();
+}
+
+bool FMCPHttpRequestParser::ParseRequestLine(const ANSICHAR* Line, int32 Length)
+{
+	// method SP request-target SP HTTP-version
+	int32 FirstSpace = INDEX_NONE;
+	int32 SecondSpace = INDEX_NONE;
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		if (Line[Index] == ' ')
+		{
+			if (FirstSpace == INDEX_NONE)
+			{
+				FirstSpace = Index;
+			}
+			else if (SecondSpace == INDEX_NONE)
+			{
+				SecondSpace = Index;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+
+	if (FirstSpace <= 0 || SecondSpace <= FirstSpace + 1 || SecondSpace >= Length - 1)
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < FirstSpace; ++Index)
+	{
+		if (!MCPHttpRequestParser::IsTokenChar(Line[Index]))
+		{
+			return false;
+		}
+	}
+
+	Request.Method = FString::ConstructFromPtrSize(Line, FirstSpace);
+	Request.Target = FString::ConstructFromPtrSize(Line + FirstSpace + 1, SecondSpace - FirstSpace - 1);
+	Request.Version = FString::ConstructFromPtrSize(Line + SecondSpace + 1, Length - SecondSpace - 1);
+	return Request.Version == TEXT("HTTP/1.1") || Request.Version == TEXT("HTTP/1.0");
+}
+
+bool FMCPHttpRequestParser::ParseHeaderLine(const ANSICHAR* Line, int32 Length)
+{
+	// Obsolete line folding is rejected rather than unfolded (RFC 9112 section 5.2)
+	if (Line[0] == ' ' || Line[0] == '\t')
+	{
+		return false;
+	}
+
+	int32 Colon = INDEX_NONE;
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		if (Line[Index] == ':')
+		{
+			Colon = Index;
+			break;
+		}
+		if (!MCPHttpRequestParser::IsTokenChar(Line[Index]))
+		{
+			return false;
+		}
+	}
+
+	if (Colon <= 0)
+	{
+		return false;
+	}
+
+	FString Name = FString::ConstructFromPtrSize(Line, Colon);
+	Name.ToLowerInline();
+	FString Value = FString::ConstructFromPtrSize(Line + Colon + 1, Length - Colon - 1);
+	Value.TrimStartAndEndInline();
+
+	Request.Headers.Emplace(MoveTemp(Name), MoveTemp(Value));
+	return true;
+}
+
+bool FMCPHttpRequestParser::OnHeadersComplete()
+{
+	if (const FString* TransferEncoding = Request.FindHeader(TEXT("transfer-encoding")))
+	{
+		if (!TransferEncoding->Equals(TEXT("identity"), ESearchCase::IgnoreCase))
+		{
+			SetError(501, TEXT("Transfer-Encoding request bodies are not supported; send Content-Length"));
+			return false;
+		}
+	}
+
+	ContentLength = 0;
+	bool bHasContentLength = false;
+	for (const TPair<FString, FString>& Header : Request.Headers)
+	{
+		if (Header.Key != TEXT("content-length"))
+		{
+			continue;
+		}
+
+		const FString& Value = Header.Value;
+		if (Value.IsEmpty() || Value.Len() > 18)
+		{
+			SetError(400, TEXT("Invalid Content-Length"));
+			return false;
+		}
+
+		int64 Parsed = 0;
+		for (TCHAR Char : Value)
+		{
+			if (Char < TEXT('0') || Char > TEXT('9'))
+			{
+				SetError(400, TEXT("Invalid Content-Length"));
+				return false;
+			}
+			Parsed = Parsed * 10 + (Char - TEXT('0'));
+		}
+
+		// Repeated Content-Length fields must agree (RFC 9110 section 8.6)
+		if (bHasContentLength && Parsed != ContentLength)
+		{
+			SetError(400, TEXT("Conflicting Content-Length fields"));
+			return false;
+		}
+		ContentLength = Parsed;
+		bHasContentLength = true;
+	}
+
+	if (ContentLength > MaxBodyBytes)
+	{
+		SetError(413, FString::Printf(TEXT("Request body of %lld bytes exceeds the %lld byte limit"), ContentLength, MaxBodyBytes));
+		return false;
+	}
+
+	// Size the buffer for the whole request once instead of growing it chunk by chunk
+	Buffer.Reserve(BodyStart + (int32)ContentLength);
+	return true;
+}
+
+EMCPHttpParseResult FMCPHttpRequestParser::SetError(int32 StatusCode, const FString& Message)
+{
+	State = EState::Error;
+	ErrorStatusCode = StatusCode;
+	ErrorMessage = Message;
+	return EMCPHttpParseResult::Error;
+}
@@ -0,0 +1,382 @@
+#include "MCPHttpResponse.h"
+
+void FMCPHttpResponse::Reset()
+{
+	Header.Reset();
+	Body.Reset();
+	BytesCopied = 0;
+	Allocations = 0;
+	BodyStreamer.Reset();
+	ContentEncoding = NAME_None;
+}
+
+void FMCPHttpResponse::Append(TArray<uint8>& Buffer, const void* Data, int32 Length)
+{
+	if (Length <= 0)
+	{
+		return;
+	}
+
+	const int32 OldMax = Buffer.Max();
+	Buffer.Append((const uint8*)Data, Length);
+	if (Buffer.Max() != OldMax)
+	{
+		++Allocations;
+	}
+	BytesCopied += Length;
+}
+
+void FMCPHttpResponse::SetBody(const ANSICHAR* Utf8, int32 Length)
+{
+	Body.Reset();
+	Append(Body, Utf8, Length);
+}
+
+void FMCPHttpResponse::SetBody(const FString& Text)
+{
+	FTCHARToUTF8 Utf8(*Text, Text.Len());
+	SetBody((const ANSICHAR*)Utf8.Get(), Utf8.Length());
+}
+
+bool FMCPHttpResponse::CompressBody(FName FormatName, ECompressionFlags Flags)
+{
+	if (Body.Num() == 0)
+	{
+		return false;
+	}
+
+	// Gzip adds a larger header/trailer than the zlib bound accounts for
+	const int32 Bound = FCompression::CompressMemoryBound(FormatName, Body.Num(), Flags) + 32;
+	const int32 OldScratchMax = Scratch.Max();
+	Scratch.SetNumUninitialized(Bound, EAllowShrinking::No);
+	if (Scratch.Max() != OldScratchMax)
+	{
+		++Allocations;
+	}
+
+	int32 CompressedSize = Bound;
+	if (!FCompression::CompressMemory(FormatName, Scratch.GetData(), CompressedSize, Body.GetData(), Body.Num(), Flags) ||
+		CompressedSize >= Body.Num())
+	{
+		Scratch.Reset();
+		return false;
+	}
+
+	Scratch.SetNum(CompressedSize, EAllowShrinking::No);
+	Swap(Body, Scratch);
+	Scratch.Reset();
+	BytesCopied += CompressedSize;
+	ContentEncoding = FormatName;
+	return true;
+}
+
+FName FMCPHttpResponse::NegotiateContentEncoding(const FString* AcceptEncoding)
+{
+	if (!AcceptEncoding || AcceptEncoding->IsEmpty())
+	{
+		return NAME_None;
+	}
+
+	float GzipQuality = -1.0f;
+	float DeflateQuality = -1.0f;
+	float WildcardQuality = -1.0f;
+
+	TArray<FString> Codings;
+	AcceptEncoding->ParseIntoArray(Codings, TEXT(","));
+	for (const FString& Coding : Codings)
+	{
+		// coding [ ";" "q=" qvalue ]
+		FString Name = Coding;
+		float Quality = 1.0f;
+		int32 Semicolon = INDEX_NONE;
+		if (Coding.FindChar(TEXT(';'), Semicolon))
+		{
+			Name = Coding.Left(Semicolon);
+			FString Parameter = Coding.Mid(Semicolon + 1).TrimStartAndEnd();
+			if (Parameter.StartsWith(TEXT("q="), ESearchCase::IgnoreCase))
+			{
+				Quality = FCString::Atof(*Parameter.Mid(2));
+			}
+		}
+		Name.TrimStartAndEndInline();
+
+		if (Name.Equals(TEXT("gzip"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("x-gzip"), ESearchCase::IgnoreCase))
+		{
+			GzipQuality = Quality;
+		}
+		else if (Name.Equals(TEXT("deflate"), ESearchCase::IgnoreCase))
+		{
+			DeflateQuality = Quality;
+		}
+		else if (Name == TEXT("*"))
+		{
+			WildcardQuality = Quality;
+		}
+	}
+
+	// Codings not listed explicitly fall back to the wildcard's quality
+	if (GzipQuality < 0.0f)
+	{
+		GzipQuality = WildcardQuality;
+	}
+	if (DeflateQuality < 0.0f)
+	{
+		DeflateQuality = WildcardQuality;
+	}
+
+	if (GzipQuality > 0.0f && GzipQuality >= DeflateQuality)
+	{
+		return NAME_Gzip;
+	}
+	if (DeflateQuality > 0.0f)
+	{
+		return NAME_Zlib;
+	}
+	return NAME_None;
+}
+
+const ANSICHAR* FMCPHttpResponse::GetContentEncodingToken(FName FormatName)
+{
+	// HTTP "deflate" is the zlib format (RFC 9110 section 8.4.1.2), not raw deflate
+	if (FormatName == NAME_Gzip)
+	{
+		return "gzip";
+	}
+	if (FormatName == NAME_Zlib)
+	{
+		return "deflate";
+	}
+	return "identity";
+}
+
+void FMCPHttpResponse::BeginHeaders(int32 StatusCode)
+{
+	Header.Reset();
+
+	ANSICHAR StatusLine[64];
+	const int32 Length = FCStringAnsi::Snprintf(StatusLine, sizeof(StatusLine), "HTTP/1.1 %d %s\r\n", StatusCode, GetReasonPhrase(StatusCode));
+	Append(Header, StatusLine, FMath::Min<int32>(Length, sizeof(StatusLine) - 1));
+}
+
+void FMCPHttpResponse::AddHeader(const ANSICHAR* Name, const ANSICHAR* Value)
+{
+	Append(Header, Name, FCStringAnsi::Strlen(Name));
+	Append(Header, ": ", 2);
+	Append(Header, Value, FCStringAnsi::Strlen(Value));
+	Append(Header, "\r\n", 2);
+}
+
+void FMCPHttpResponse::AddHeader(const ANSICHAR* Name, const FString& Value)
+{
+	FTCHARToUTF8 Utf8(*Value, Value.Len());
+	Append(Header, Name, FCStringAnsi::Strlen(Name));
+	Append(Header, ": ", 2);
+	Append(Header, Utf8.Get(), Utf8.Length());
+	Append(Header, "\r\n", 2);
+}
+
+void FMCPHttpResponse::AddHeader(const ANSICHAR* Name, int64 Value)
+{
+	ANSICHAR Digits[32];
+	FCStringAnsi::Snprintf(Digits, sizeof(Digits), "%lld", Value);
+	AddHeader(Name, Digits);
+}
+
+void FMCPHttpResponse::AddRawHeaders(const uint8* Data, int32 Length)
+{
+	Append(Header, Data, Length);
+}
+
+void FMCPHttpResponse::FinishHeaders()
+{
+	Append(Header, "\r\n", 2);
+}
+
+const ANSICHAR* FMCPHttpResponse::GetReasonPhrase(int32 StatusCode)
+{
+	switch (StatusCode)
+	{
+	case 101: return "Switching Protocols";
+	case 200: return "OK";
+	case 204: return "No Content";
+	case 400: return "Bad Request";
+	case 403: return "Forbidden";
+	case 413: return "Content Too Large";
+	case 426: return "Upgrade Required";
+	case 431: return "Request Header Fields Too Large";
+	case 501: return "Not Implemented";
+	case 503: return "Service Unavailable";
+	default: return "Unknown";
+	}
+}
+
+namespace MCPHttpResponse
+{
+	static void AppendLine(TArray<uint8>& Buffer, const FString& Line)
+	{
+		FTCHARToUTF8 Utf8(*Line, Line.Len());
+		Buffer.Append((const uint8*)Utf8.Get(), Utf8.Length());
+		Buffer.Append((const uint8*)"\r\n", 2);
+	}
+
+	/** Header names and values from settings must not be able to inject extra lines */
+	static bool IsSafeHeaderText(const FString& Text)
+	{
+		int32 Index = INDEX_NONE;
+		return !Text.FindChar(TEXT('\r'), Index) && !Text.FindChar(TEXT('\n'), Index);
+	}
+}
+
+TSharedRef<const FMCPHttpHeaderBlock, ESPMode::ThreadSafe> FMCPHttpHeaderBlock::Build(
+	bool bInEnableCORS,
+	const TArray<FString>& InAllowedOrigins,
+	const TMap<FString, FString>& CustomHeaders,
+	int32 TimeoutSeconds,
+	int32 MaxRequestsPerConnection,
+	bool bCompressionEnabled)
+{
+	using namespace MCPHttpResponse;
+
+	TSharedRef<FMCPHttpHeaderBlock, ESPMode::ThreadSafe> Block = MakeShared<FMCPHttpHeaderBlock, ESPMode::ThreadSafe>();
+
+	// Connection persistence
+	AppendLine(Block->KeepAliveLines, TEXT("Connection: keep-alive"));
+	AppendLine(Block->KeepAliveLines, FString::Printf(TEXT("Keep-Alive: timeout=%d, max=%d"), TimeoutSeconds, MaxRequestsPerConnection));
+	AppendLine(Block->CloseLines, TEXT("Connection: close"));
+
+	// CORS headers; the allowed origin itself is matched per request
+	Block->bEnableCORS = bInEnableCORS;
+	if (bInEnableCORS)
+	{
+		for (const FString& Origin : InAllowedOrigins)
+		{
+			const FString Trimmed = Origin.TrimStartAndEnd();
+			if (!Trimmed.IsEmpty())
+			{
+				Block->AllowedOrigins.Add(Trimmed.ToLower());
+			}
+		}
+
+		// Allow all origins when none are configured (less secure, but useful for development)
+		Block->bAllowAnyOrigin = Block->AllowedOrigins.Num() == 0;
+		if (Block->bAllowAnyOrigin)
+		{
+			AppendLine(Block->StaticLines, TEXT("Access-Control-Allow-Origin: *"));
+		}
+		AppendLine(Block->StaticLines, TEXT("Access-Control-Allow-Methods: GET, POST, OPTIONS"));
+		AppendLine(Block->StaticLines, TEXT("Access-Control-Allow-Headers: Content-Type, Authorization"));
+		AppendLine(Block->StaticLines, TEXT("Access-Control-Max-Age: 86400"));
+	}
+
+	// Responses may be compressed depending on the request, so caches must key on Accept-Encoding
+	if (bCompressionEnabled)
+	{
+		AppendLine(Block->StaticLines, TEXT("Vary: Accept-Encoding"));
+	}
+
+	// Custom headers from settings
+	for (const TPair<FString, FString>& Header : CustomHeaders)
+	{
+		if (Header.Key.IsEmpty() || !IsSafeHeaderText(Header.Key) || !IsSafeHeaderText(Header.Value))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MCP Server: Ignoring invalid custom header '%s'"), *Header.Key);
+			continue;
+		}
+		AppendLine(Block->StaticLines, FString::Printf(TEXT("%s: %s"), *Header.Key, *Header.Value));
+	}
+
+	// Security headers (always applied)
+	AppendLine(Block->StaticLines, TEXT("X-Content-Type-Options: nosniff")); // Prevent MIME type sniffing
+	if (!bInEnableCORS)
+	{
+		AppendLine(Block->StaticLines, TEXT("X-Frame-Options: DENY")); // Prevent iframe embedding (unless CORS is enabled)
+	}
+
+	return Block;
+}
+
+bool FMCPHttpHeaderBlock::IsOriginAllowed(const FString& Origin) const
+{
+	return AllowedOrigins.Contains(Origin.ToLower());
+}
+
+FMCPChunkedArchive::FMCPChunkedArchive(TFunction<bool(const uint8*, int32)> InSink, int32 InChunkBytes)
+	: Sink(MoveTemp(InSink))
+	, ChunkBytes(FMath::Max(1024, InChunkBytes))
+	, BodyBytes(0)
+	, ChunkCount(0)
+{
+	SetIsSaving(true);
+	SetIsPersistent(false);
+
+	// Size line + payload + CRLF, plus room for the terminating chunk on the final send
+	Buffer.Reserve(SizeLineBytes + ChunkBytes + 2 + 5);
+	Buffer.SetNumUninitialized(SizeLineBytes);
+}
+
+void FMCPChunkedArchive::Serialize(void* Data, int64 Length)
+{
+	const uint8* Source = (const uint8*)Data;
+	while (Length > 0 && !IsError())
+	{
+		const int32 Space = SizeLineBytes + ChunkBytes - Buffer.Num();
+		const int32 ToCopy = (int32)FMath::Min<int64>(Space, Length);
+		Buffer.Append(Source, ToCopy);
+		Source += ToCopy;
+		Length -= ToCopy;
+		BodyBytes += ToCopy;
+
+		if (Buffer.Num() == SizeLineBytes + ChunkBytes)
+		{
+			FlushChunk(false);
+		}
+	}
+}
+
+bool FMCPChunkedArchive::Finish()
+{
+	return FlushChunk(true) && !IsError();
+}
+
+bool FMCPChunkedArchive::FlushChunk(bool bLastChunk)
+{
+	if (IsError())
+	{
+		return false;
+	}
+
+	const int32 PayloadBytes = Buffer.Num() - SizeLineBytes;
+	int32 Start = 0;
+	if (PayloadBytes > 0)
+	{
+		// Leading zeros are valid in chunk-size (RFC 9112 section 7.1)
+		ANSICHAR SizeLine[SizeLineBytes + 1];
+		FCStringAnsi::Snprintf(SizeLine, sizeof(SizeLine), "%08X\r\n", PayloadBytes);
+		FMemory::Memcpy(Buffer.GetData(), SizeLine, SizeLineBytes);
+		Buffer.Append((const uint8*)"\r\n", 2);
+	}
+	else
+	{
+		// Nothing buffered: skip the size line entirely rather than sending an empty (terminating) chunk
+		Start = SizeLineBytes;
+	}
+
+	if (bLastChunk)
+	{
+		Buffer.Append((const uint8*)"0\r\n\r\n", 5);
+	}
+
+	bool bSent = true;
+	if (Buffer.Num() > Start)
+	{
+		bSent = Sink(Buffer.GetData() + Start, Buffer.Num() - Start);
+		++ChunkCount;
+	}
+
+	Buffer.SetNumUninitialized(SizeLineBytes, EAllowShrinking::No);
+	if (!bSent)
+	{
+		SetError();
+	}
+	return bSent;
+}
@@ -0,0 +1,682 @@
+#include "MCPJsonReader.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace MCPJsonReader
+{
+	static bool IsDigit(uint8 Char)
+	{
+		return Char >= '0' && Char <= '9';
+	}
+
+	static int32 HexValue(uint8 Char)
+	{
+		if (Char >= '0' && Char <= '9') return Char - '0';
+		if (Char >= 'a' && Char <= 'f') return Char - 'a' + 10;
+		if (Char >= 'A' && Char <= 'F') return Char - 'A' + 10;
+		return -1;
+	}
+
+	/** Read the 4 hex digits of a \u escape; the scanner has already checked they are there */
+	static uint32 ReadHex4(const UTF8CHAR* Digits)
+	{
+		uint32 Value = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			Value = (Value << 4) | (uint32)HexValue((uint8)Digits[Index]);
+		}
+		return Value;
+	}
+
+	static void AppendUtf8(TArray<UTF8CHAR>& Out, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Out.Add((UTF8CHAR)CodePoint);
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out.Add((UTF8CHAR)(0xC0 | (CodePoint >> 6)));
+			Out.Add((UTF8CHAR)(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add((UTF8CHAR)(0xE0 | (CodePoint >> 12)));
+			Out.Add((UTF8CHAR)(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add((UTF8CHAR)(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add((UTF8CHAR)(0xF0 | (CodePoint >> 18)));
+			Out.Add((UTF8CHAR)(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add((UTF8CHAR)(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add((UTF8CHAR)(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	/** Decode the escapes of a scanned string into Out */
+	static void Unescape(FUtf8StringView Raw, TArray<UTF8CHAR>& Out)
+	{
+		Out.Reset(Raw.Len());
+		const UTF8CHAR* Char = Raw.GetData();
+		const UTF8CHAR* RawEnd = Char + Raw.Len();
+		while (Char < RawEnd)
+		{
+			if (*Char != '\\')
+			{
+				Out.Add(*Char++);
+				continue;
+			}
+
+			const uint8 Escape = (uint8)Char[1];
+			Char += 2;
+			switch (Escape)
+			{
+			case 'b': Out.Add('\b'); break;
+			case 'f': Out.Add('\f'); break;
+			case 'n': Out.Add('\n'); break;
+			case 'r': Out.Add('\r'); break;
+			case 't': Out.Add('\t'); break;
+			case 'u':
+			{
+				uint32 CodePoint = ReadHex4(Char);
+				Char += 4;
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && RawEnd - Char >= 6 && Char[0] == '\\' && Char[1] == 'u')
+				{
+					const uint32 Low = ReadHex4(Char + 2);
+					if (Low >= 0xDC00 && Low <= 0xDFFF)
+					{
+						CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+						Char += 6;
+					}
+				}
+				// Unpaired surrogates cannot be encoded as UTF-8
+				AppendUtf8(Out, (CodePoint >= 0xD800 && CodePoint <= 0xDFFF) ? 0xFFFD : CodePoint);
+				break;
+			}
+			default:
+				// '"', '\\' and '/' stand for themselves
+				Out.Add((UTF8CHAR)Escape);
+				break;
+			}
+		}
+	}
+
+	static bool KeyIs(FUtf8StringView Key, const char* Name)
+	{
+		const int32 Length = FCStringAnsi::Strlen(Name);
+		return Key.Len() == Length && FMemory::Memcmp(Key.GetData(), Name, Length) == 0;
+	}
+}
+
+FMCPJsonReader::FMCPJsonReader(FUtf8StringView InJson)
+	: Begin(InJson.GetData())
+	, Cursor(InJson.GetData())
+	, End(InJson.GetData() + InJson.Len())
+{
+}
+
+void FMCPJsonReader::SkipWhitespace()
+{
+	while (Cursor < End && (*Cursor == ' ' || *Cursor == '\n' || *Cursor == '\r' || *Cursor == '\t'))
+	{
+		++Cursor;
+	}
+}
+
+bool FMCPJsonReader::Fail(const TCHAR* What)
+{
+	if (Error.IsEmpty())
+	{
+		Error = FString::Printf(TEXT("%s at offset %d"), What, (int32)(Cursor - Begin));
+	}
+	return false;
+}
+
+bool FMCPJsonReader::Expect(UTF8CHAR Char, const TCHAR* What)
+{
+	SkipWhitespace();
+	if (Cursor == End || *Cursor != Char)
+	{
+		return Fail(What);
+	}
+	++Cursor;
+	return true;
+}
+
+EMCPJsonToken FMCPJsonReader::Peek()
+{
+	if (HasError())
+	{
+		return EMCPJsonToken::Error;
+	}
+
+	SkipWhitespace();
+	if (Cursor == End)
+	{
+		return EMCPJsonToken::Error;
+	}
+
+	switch ((uint8)*Cursor)
+	{
+	case '{': return EMCPJsonToken::Object;
+	case '[': return EMCPJsonToken::Array;
+	case '"': return EMCPJsonToken::String;
+	case 't':
+	case 'f': return EMCPJsonToken::Boolean;
+	case 'n': return EMCPJsonToken::Null;
+	default:
+		return (*Cursor == '-' || MCPJsonReader::IsDigit((uint8)*Cursor)) ? EMCPJsonToken::Number : EMCPJsonToken::Error;
+	}
+}
+
+bool FMCPJsonReader::EnterContainer(UTF8CHAR Open)
+{
+	if (HasError() || !Expect(Open, Open == '{' ? TEXT("Expected an object") : TEXT("Expected an array")))
+	{
+		return false;
+	}
+	if (++Depth > MaxDepth)
+	{
+		return Fail(TEXT("Nesting too deep"));
+	}
+	bFirstInContainer = true;
+	return true;
+}
+
+bool FMCPJsonReader::NextInContainer(UTF8CHAR Close)
+{
+	if (HasError())
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	if (Cursor == End)
+	{
+		return Fail(Close == '}' ? TEXT("Unterminated object") : TEXT("Unterminated array"));
+	}
+
+	// A comma is consumed together with the member or element after it, so "[1,]" fails on the ']'
+	if (*Cursor == Close)
+	{
+		++Cursor;
+		--Depth;
+		bFirstInContainer = false;
+		return false;
+	}
+
+	if (!bFirstInContainer && !Expect(',', Close == '}' ? TEXT("Expected ',' or '}'") : TEXT("Expected ',' or ']'")))
+	{
+		return false;
+	}
+	bFirstInContainer = false;
+	return true;
+}
+
+bool FMCPJsonReader::BeginObject()
+{
+	return EnterContainer('{');
+}
+
+bool FMCPJsonReader::NextMember(FUtf8StringView& OutKey)
+{
+	if (!NextInContainer('}'))
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	if (Cursor == End || *Cursor != '"')
+	{
+		return Fail(TEXT("Expected a member name"));
+	}
+	return ReadStringInternal(OutKey) && Expect(':', TEXT("Expected ':'"));
+}
+
+bool FMCPJsonReader::BeginArray()
+{
+	return EnterContainer('[');
+}
+
+bool FMCPJsonReader::NextElement()
+{
+	return NextInContainer(']');
+}
+
+bool FMCPJsonReader::ScanString(FUtf8StringView& OutRaw, bool& bOutEscaped)
+{
+	bOutEscaped = false;
+	const UTF8CHAR* Start = Cursor + 1;
+	const UTF8CHAR* Char = Start;
+	while (Char < End)
+	{
+		const uint8 Byte = (uint8)*Char;
+		if (Byte == '"')
+		{
+			OutRaw = FUtf8StringView(Start, (int32)(Char - Start));
+			Cursor = Char + 1;
+			return true;
+		}
+		if (Byte == '\\')
+		{
+			bOutEscaped = true;
+			if (End - Char < 2)
+			{
+				break;
+			}
+			const uint8 Escape = (uint8)Char[1];
+			if (Escape == 'u')
+			{
+				if (End - Char < 6 || MCPJsonReader::HexValue((uint8)Char[2]) < 0 || MCPJsonReader::HexValue((uint8)Char[3]) < 0 ||
+					MCPJsonReader::HexValue((uint8)Char[4]) < 0 || MCPJsonReader::HexValue((uint8)Char[5]) < 0)
+				{
+					Cursor = Char;
+					return Fail(TEXT("Invalid \\u escape"));
+				}
+				Char += 6;
+				continue;
+			}
+			if (!FCStringAnsi::Strchr("\"\\/bfnrt", (ANSICHAR)Escape) || Escape == 0)
+			{
+				Cursor = Char;
+				return Fail(TEXT("Invalid escape"));
+			}
+			Char += 2;
+			continue;
+		}
+		if (Byte < 0x20)
+		{
+			Cursor = Char;
+			return Fail(TEXT("Control character in string"));
+		}
+		++Char;
+	}
+
+	Cursor = End;
+	return Fail(TEXT("Unterminated string"));
+}
+
+bool FMCPJsonReader::ReadStringInternal(FUtf8StringView& Out)
+{
+	if (HasError())
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	if (Cursor == End || *Cursor != '"')
+	{
+		return Fail(TEXT("Expected a string"));
+	}
+
+	FUtf8StringView Raw;
+	bool bEscaped = false;
+	if (!ScanString(Raw, bEscaped))
+	{
+		return false;
+	}
+
+	// Most strings have no escapes and are handed out in place
+	if (!bEscaped)
+	{
+		Out = Raw;
+		return true;
+	}
+	MCPJsonReader::Unescape(Raw, Scratch);
+	Out = FUtf8StringView(Scratch.GetData(), Scratch.Num());
+	return true;
+}
+
+bool FMCPJsonReader::ReadStringView(FUtf8StringView& Out)
+{
+	return ReadStringInternal(Out);
+}
+
+bool FMCPJsonReader::ReadString(FString& Out)
+{
+	FUtf8StringView Text;
+	if (!ReadStringInternal(Text))
+	{
+		return false;
+	}
+	Out.Reset(Text.Len());
+	Out.AppendChars(Text.GetData(), Text.Len());
+	return true;
+}
+
+bool FMCPJsonReader::ScanNumber(FUtf8StringView& OutRaw)
+{
+	const UTF8CHAR* Start = Cursor;
+	const UTF8CHAR* Char = Cursor;
+	auto SkipDigits = [&Char, this]()
+	{
+		const UTF8CHAR* First = Char;
+		while (Char < End && MCPJsonReader::IsDigit((uint8)*Char))
+		{
+			++Char;
+		}
+		return Char > First;
+	};
+
+	if (Char < End && *Char == '-')
+	{
+		++Char;
+	}
+	if (Char < End && *Char == '0')
+	{
+		++Char;
+	}
+	else if (!SkipDigits())
+	{
+		return Fail(TEXT("Invalid number"));
+	}
+	if (Char < End && *Char == '.')
+	{
+		++Char;
+		if (!SkipDigits())
+		{
+			return Fail(TEXT("Invalid number"));
+		}
+	}
+	if (Char < End && (*Char == 'e' || *Char == 'E'))
+	{
+		++Char;
+		if (Char < End && (*Char == '+' || *Char == '-'))
+		{
+			++Char;
+		}
+		if (!SkipDigits())
+		{
+			return Fail(TEXT("Invalid number"));
+		}
+	}
+
+	OutRaw = FUtf8StringView(Start, (int32)(Char - Start));
+	Cursor = Char;
+	return true;
+}
+
+bool FMCPJsonReader::ReadNumber(double& Out)
+{
+	if (Peek() != EMCPJsonToken::Number)
+	{
+		return Fail(TEXT("Expected a number"));
+	}
+
+	FUtf8StringView Raw;
+	if (!ScanNumber(Raw))
+	{
+		return false;
+	}
+
+	// Atod wants a terminated string; numbers longer than this are rare enough to copy to the heap
+	ANSICHAR Buffer[64];
+	if (Raw.Len() < UE_ARRAY_COUNT(Buffer))
+	{
+		FMemory::Memcpy(Buffer, Raw.GetData(), Raw.Len());
+		Buffer[Raw.Len()] = 0;
+		Out = FCStringAnsi::Atod(Buffer);
+	}
+	else
+	{
+		TArray<ANSICHAR> LongNumber((const ANSICHAR*)Raw.GetData(), Raw.Len());
+		LongNumber.Add(0);
+		Out = FCStringAnsi::Atod(LongNumber.GetData());
+	}
+	return true;
+}
+
+bool FMCPJsonReader::ScanLiteral(const char* Literal, int32 Length)
+{
+	if (End - Cursor < Length || FMemory::Memcmp(Cursor, Literal, Length) != 0)
+	{
+		return Fail(TEXT("Invalid literal"));
+	}
+	Cursor += Length;
+	return true;
+}
+
+bool FMCPJsonReader::ReadBool(bool& bOut)
+{
+	const EMCPJsonToken Token = Peek();
+	if (Token != EMCPJsonToken::Boolean)
+	{
+		return Fail(TEXT("Expected true or false"));
+	}
+	bOut = *Cursor == 't';
+	return bOut ? ScanLiteral("true", 4) : ScanLiteral("false", 5);
+}
+
+bool FMCPJsonReader::ReadNull()
+{
+	if (Peek() != EMCPJsonToken::Null)
+	{
+		return Fail(TEXT("Expected null"));
+	}
+	return ScanLiteral("null", 4);
+}
+
+bool FMCPJsonReader::SkipValue(FUtf8StringView* OutRaw)
+{
+	const EMCPJsonToken Token = Peek();
+	const UTF8CHAR* Start = Cursor;
+	bool bOk = false;
+	switch (Token)
+	{
+	case EMCPJsonToken::Object:
+	{
+		FUtf8StringView Key;
+		if (BeginObject())
+		{
+			while (NextMember(Key) && SkipValue())
+			{
+			}
+		}
+		bOk = !HasError();
+		break;
+	}
+	case EMCPJsonToken::Array:
+		if (BeginArray())
+		{
+			while (NextElement() && SkipValue())
+			{
+			}
+		}
+		bOk = !HasError();
+		break;
+	case EMCPJsonToken::String:
+	{
+		FUtf8StringView Raw;
+		bool bEscaped = false;
+		bOk = ScanString(Raw, bEscaped);
+		break;
+	}
+	case EMCPJsonToken::Number:
+	{
+		FUtf8StringView Raw;
+		bOk = ScanNumber(Raw);
+		break;
+	}
+	case EMCPJsonToken::Boolean:
+	{
+		bool bValue = false;
+		bOk = ReadBool(bValue);
+		break;
+	}
+	case EMCPJsonToken::Null:
+		bOk = ReadNull();
+		break;
+	default:
+		bOk = Fail(TEXT("Expected a value"));
+		break;
+	}
+
+	if (bOk && OutRaw)
+	{
+		*OutRaw = FUtf8StringView(Start, (int32)(Cursor - Start));
+	}
+	return bOk;
+}
+
+TSharedPtr<FJsonValue> FMCPJsonReader::ReadValue()
+{
+	switch (Peek())
+	{
+	case EMCPJsonToken::String:
+	{
+		FString Value;
+		return ReadString(Value) ? MakeShared<FJsonValueString>(Value) : TSharedPtr<FJsonValue>();
+	}
+	case EMCPJsonToken::Number:
+	{
+		double Value = 0.0;
+		return ReadNumber(Value) ? MakeShared<FJsonValueNumber>(Value) : TSharedPtr<FJsonValue>();
+	}
+	case EMCPJsonToken::Boolean:
+	{
+		bool bValue = false;
+		return ReadBool(bValue) ? MakeShared<FJsonValueBoolean>(bValue) : TSharedPtr<FJsonValue>();
+	}
+	case EMCPJsonToken::Null:
+		return ReadNull() ? MakeShared<FJsonValueNull>() : TSharedPtr<FJsonValue>();
+	case EMCPJsonToken::Object:
+	case EMCPJsonToken::Array:
+	{
+		// Containers are rare here; check them once, then let the stock reader build the tree
+		FUtf8StringView Raw;
+		if (!SkipValue(&Raw))
+		{
+			return nullptr;
+		}
+		TSharedPtr<FJsonValue> Value;
+		TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(Raw);
+		FJsonSerializer::Deserialize(Reader, Value);
+		return Value;
+	}
+	default:
+		Fail(TEXT("Expected a value"));
+		return nullptr;
+	}
+}
+
+bool FMCPJsonReader::AtEnd()
+{
+	if (HasError())
+	{
+		return false;
+	}
+	SkipWhitespace();
+	return Cursor == End || Fail(TEXT("Unexpected text after the value"));
+}
+
+bool FMCPJsonRpcEnvelope::Read(FMCPJsonReader& Reader, FMCPJsonRpcEnvelope& Out)
+{
+	Out.bIsObject = false;
+	Out.bVersion2 = false;
+	Out.bHasMethod = false;
+	Out.Method.Reset();
+	Out.Id.Reset();
+	Out.Params.Reset();
+
+	if (Reader.Peek() != EMCPJsonToken::Object)
+	{
+		return Reader.SkipValue();
+	}
+
+	Out.bIsObject = true;
+	Reader.BeginObject();
+
+	FUtf8StringView Key;
+	while (Reader.NextMember(Key))
+	{
+		// Like FJsonObject, a repeated member replaces the earlier one
+		if (MCPJsonReader::KeyIs(Key, "jsonrpc"))
+		{
+			FUtf8StringView Version;
+			if (Reader.Peek() == EMCPJsonToken::String)
+			{
+				Out.bVersion2 = Reader.ReadStringView(Version) && MCPJsonReader::KeyIs(Version, "2.0");
+			}
+			else
+			{
+				Out.bVersion2 = false;
+				Reader.SkipValue();
+			}
+		}
+		else if (MCPJsonReader::KeyIs(Key, "method"))
+		{
+			Out.bHasMethod = Reader.Peek() == EMCPJsonToken::String;
+			if (Out.bHasMethod)
+			{
+				Reader.ReadString(Out.Method);
+			}
+			else
+			{
+				Out.Method.Reset();
+				Reader.SkipValue();
+			}
+		}
+		else if (MCPJsonReader::KeyIs(Key, "id"))
+		{
+			Out.Id = Reader.ReadValue();
+		}
+		else if (MCPJsonReader::KeyIs(Key, "params"))
+		{
+			// Only checked here; the method's handler decides how to decode it
+			Out.Params.Reset();
+			if (Reader.Peek() == EMCPJsonToken::Null)
+			{
+				Reader.ReadNull();
+			}
+			else
+			{
+				Reader.SkipValue(&Out.Params);
+			}
+		}
+		else
+		{
+			Reader.SkipValue();
+		}
+
+		if (Reader.HasError())
+		{
+			return false;
+		}
+	}
+	return !Reader.HasError();
+}
+
+EMCPJsonRpcBody FMCPJsonRpcEnvelope::ReadBody(FUtf8StringView Body, FMCPJsonRpcEnvelope& OutRequest, TArray<FMCPJsonRpcEnvelope>& OutBatch, FString& OutError)
+{
+	FMCPJsonReader Reader(Body);
+	EMCPJsonRpcBody Kind = EMCPJsonRpcBody::Other;
+
+	switch (Reader.Peek())
+	{
+	case EMCPJsonToken::Object:
+		Kind = EMCPJsonRpcBody::Request;
+		Read(Reader, OutRequest);
+		break;
+	case EMCPJsonToken::Array:
+		Kind = EMCPJsonRpcBody::Batch;
+		OutBatch.Reset();
+		if (Reader.BeginArray())
+		{
+			while (Reader.NextElement() && Read(Reader, OutBatch.AddDefaulted_GetRef()))
+			{
+			}
+		}
+		break;
+	default:
+		Reader.SkipValue();
+		break;
+	}
+
+	if (!Reader.AtEnd())
+	{
+		OutError = Reader.GetError();
+		return EMCPJsonRpcBody::Malformed;
+	}
+	return Kind;
+}
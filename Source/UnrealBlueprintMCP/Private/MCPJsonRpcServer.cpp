@@ -1,8 +1,25 @@
 #include "MCPJsonRpcServer.h"
 #include "MCPServerSettings.h"
+#include "MCPHttpRequestParser.h"
+#include "MCPWorkerPool.h"
+#include "MCPHttpResponse.h"
+#include "MCPWebSocket.h"
+#include "MCPLocalSocket.h"
+#include "MCPMethodRegistry.h"
+#include "MCPMethodParams.h"
+#include "MCPParamsBinding.h"
+#include "MCPJsonReader.h"
+#include "MCPJsonWriter.h"
+#include "MCPResultCache.h"
+#include "UObject/StructOnScope.h"
+#include "UObject/UObjectGlobals.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeRWLock.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Engine/Blueprint.h"
+#include "Editor.h"
+#include "UObject/Package.h"
 #include "HAL/PlatformFilemanager.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/Event.h" // For FEvent
@@ -17,6 +34,7 @@
 #include "Factories/BlueprintFactory.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "ScopedTransaction.h"
 // Blueprint Graph node includes - Updated for UE 5.6
 #include "K2Node_Event.h"
 #include "K2Node_CallFunction.h"
@@ -37,18 +55,21 @@ int32 FMCPJsonRpcServer::LastUsedPort = 8080;
 
 FMCPJsonRpcServer::FMCPJsonRpcServer()
 	: ServerSocket(nullptr)
+	, PendingServerSocket(nullptr)
 	, ServerThread(nullptr)
+	, LocalServerSocket(nullptr)
 	, ServerPort(8080)
 	, bIsRunning(false)
 	, bStopRequested(false)
+	, bForceClose(false)
+	, WorkDrainedEvent(FPlatformProcess::GetSynchEventFromPool())
 	, ServerStartTime(FDateTime::MinValue())
-	, AppliedMaxConnections(10)
-	, AppliedTimeoutSeconds(30)
-	, bAppliedEnableCORS(false)
-	, bAppliedEnableAuth(false)
+	, Config(MakeShared<FMCPServerConfig, ESPMode::ThreadSafe>())
 {
 	// Initialize fallback ports
 	FallbackPorts = {8080, 8081, 8082, 8083, 8084, 8090, 9000, 9001};
+
+	RegisterBuiltinMethods();
 	
 	// Apply initial settings from UMCPServerSettings
 	const UMCPServerSettings* Settings = UMCPServerSettings::Get();
@@ -61,6 +82,12 @@ FMCPJsonRpcServer::FMCPJsonRpcServer()
 FMCPJsonRpcServer::~FMCPJsonRpcServer()
 {
 	StopServer();
+
+	// Methods another server instance registered since then are not ours to remove
+	FMCPMethodRegistry::Get().UnregisterAll(this);
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkDrainedEvent);
+	WorkDrainedEvent = nullptr;
 }
 
 bool FMCPJsonRpcServer::StartServer(int32 Port)
@@ -71,74 +98,108 @@ bool FMCPJsonRpcServer::StartServer(int32 Port)
 		return false;
 	}
 
-	ServerPort = Port;
-
-	// Create server socket
-	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-	if (!SocketSubsystem)
-	{
-		LogMessage(TEXT("Failed to get socket subsystem"));
-		return false;
-	}
+	ServerPort.store(Port);
 
-	ServerSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("MCPJsonRpcServer"), false);
+	ServerSocket = CreateTcpListener(Port);
 	if (!ServerSocket)
 	{
-		LogMessage(TEXT("Failed to create server socket"));
 		return false;
 	}
 
-	// Allow socket reuse
-	ServerSocket->SetReuseAddr(true);
-
-	// Bind to port - SECURITY FIX: Only bind to localhost for security
-	TSharedRef<FInternetAddr> LocalAddr = SocketSubsystem->CreateInternetAddr();
-	bool bIsValid = false;
-	LocalAddr->SetIp(TEXT("127.0.0.1"), bIsValid); // localhost only - prevents external network access
-	if (!bIsValid)
+	// Start the connection worker pool, sized from MaxClientConnections
+	const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> StartConfig = GetConfig();
+	if (!WorkerPool.Start(StartConfig->MaxConnections, StartConfig->ConnectionQueueSize))
 	{
-		LogMessage(TEXT("Failed to set localhost IP address"));
-		ServerSocket->Close();
-		SocketSubsystem->DestroySocket(ServerSocket);
+		LogMessage(TEXT("Failed to create connection worker pool"));
+		delete ServerSocket;
 		ServerSocket = nullptr;
 		return false;
 	}
-	LocalAddr->SetPort(ServerPort);
 
-	if (!ServerSocket->Bind(*LocalAddr))
+	// Parked connections come back through the pool when their socket is ready
+	const bool bReactorStarted = Reactor.Start(
+		[this](FMCPConnection* Connection) { DispatchConnection(Connection); },
+		[this](FMCPConnection* Connection) { CloseConnection(Connection); });
+	if (!bReactorStarted)
 	{
-		LogMessage(FString::Printf(TEXT("Failed to bind to port %d"), ServerPort));
-		ServerSocket->Close();
-		SocketSubsystem->DestroySocket(ServerSocket);
+		LogMessage(TEXT("Failed to start connection reactor"));
+		WorkerPool.Shutdown();
+		delete ServerSocket;
 		ServerSocket = nullptr;
 		return false;
 	}
 
-	// Start listening
-	if (!ServerSocket->Listen(8))
-	{
-		LogMessage(TEXT("Failed to listen on socket"));
-		ServerSocket->Close();
-		SocketSubsystem->DestroySocket(ServerSocket);
-		ServerSocket = nullptr;
-		return false;
-	}
+	// Editor work from connections is drained once per frame from here on
+	GameThreadQueue.Start();
+	RefreshScheduler.Start();
 
 	// Start server thread
+	bStopRequested = false;
+	bForceClose = false;
+	bRetireServerSocket = false;
 	ServerThread = FRunnableThread::Create(this, TEXT("MCPJsonRpcServerThread"));
 	if (!ServerThread)
 	{
 		LogMessage(TEXT("Failed to create server thread"));
-		ServerSocket->Close();
-		SocketSubsystem->DestroySocket(ServerSocket);
+		RefreshScheduler.Shutdown();
+		GameThreadQueue.Shutdown();
+		Reactor.Shutdown();
+		WorkerPool.Shutdown();
+		delete ServerSocket;
 		ServerSocket = nullptr;
 		return false;
 	}
 
+	StartLocalListener();
+
 	bIsRunning = true;
 	ServerStartTime = FDateTime::Now();
-	LastUsedPort = ServerPort;
-	LogMessage(FString::Printf(TEXT("Server started on port %d at %s"), ServerPort, *ServerStartTime.ToString()));
+	LastUsedPort = Port;
+	RegisterNotificationSources();
+	LogMessage(FString::Printf(TEXT("Server started on port %d at %s"), Port, *ServerStartTime.ToString()));
+	return true;
+}
+
+FMCPLocalSocket* FMCPJsonRpcServer::CreateTcpListener(int32 Port)
+{
+	// A native socket rather than the socket subsystem's, so the reactor can poll its connections.
+	// It binds to 127.0.0.1 only, which keeps the server off the external network.
+	FString Error;
+	FMCPLocalSocket* Listener = FMCPLocalSocket::CreateTcpListener(Port, 8, Error);
+	if (!Listener)
+	{
+		LogMessage(Error);
+	}
+	return Listener;
+}
+
+bool FMCPJsonRpcServer::RebindPort(int32 NewPort)
+{
+	// Listening first means clients that switch to the new port queue in its backlog instead of being refused
+	FMCPLocalSocket* NewSocket = CreateTcpListener(NewPort);
+	if (!NewSocket)
+	{
+		LogMessage(FString::Printf(TEXT("Keeping port %d; port %d is not available"), ServerPort.load(), NewPort));
+		return false;
+	}
+
+	// Retire the old accept loop and hand the new listener to the server thread, which swaps it in
+	// once the old loop has accepted whatever is already in its backlog. Waiting for that here
+	// would stall the editor for as long as the loop takes to notice.
+	{
+		FScopeLock Lock(&ServerSocketLock);
+
+		// A listener from an earlier rebind that was never swapped in has accepted nothing
+		delete PendingServerSocket;
+		PendingServerSocket = NewSocket;
+		bRetireServerSocket = true;
+	}
+
+	const int32 OldPort = ServerPort.exchange(NewPort);
+	LastUsedPort = NewPort;
+	WakeTcpListener(OldPort);
+
+	LogMessage(FString::Printf(TEXT("Moving listener from port %d to %d"), OldPort, NewPort));
 	return true;
 }
 
@@ -149,7 +210,15 @@ void FMCPJsonRpcServer::StopServer()
 		return;
 	}
 
+	// Let WebSocket clients know this is a planned shutdown rather than a dropped connection
+	UnregisterNotificationSources();
+	TSharedPtr<FJsonObject> StatusParams = MakeShareable(new FJsonObject);
+	StatusParams->SetStringField(TEXT("status"), TEXT("stopping"));
+	BroadcastNotification(TEXT("server.status"), StatusParams);
+
+	// Stop accepting first, so the port is free again as soon as the drain below completes
 	bStopRequested = true;
+	WakeAcceptLoop();
 
 	// Wait for thread to finish
 	if (ServerThread)
@@ -159,18 +228,44 @@ void FMCPJsonRpcServer::StopServer()
 		ServerThread = nullptr;
 	}
 
-	// Close server socket
-	if (ServerSocket)
+	StopLocalListener();
+
+	// Close server socket, and the one a rebind the thread did not get to would have moved to
+	delete ServerSocket;
+	ServerSocket = nullptr;
+	delete PendingServerSocket;
+	PendingServerSocket = nullptr;
+
+	// Idle keep-alive connections close right away; busy ones observe bStopRequested and answer
+	// their current request first
+	Reactor.CloseIdleConnections();
+	const uint64 DrainStartCycles = FPlatformTime::Cycles64();
+	const int32 OutstandingAtStop = OutstandingWork.GetValue();
+	const bool bDrained = DrainOutstandingWork(DrainTimeoutSeconds);
+	LastDrainCycles.Set((int64)(FPlatformTime::Cycles64() - DrainStartCycles));
+	if (!bDrained)
 	{
-		ServerSocket->Close();
-		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ServerSocket);
-		ServerSocket = nullptr;
+		DrainTimeouts.Increment();
+		LogMessage(FString::Printf(TEXT("Drain timed out with %d operations outstanding; closing remaining connections"), OutstandingWork.GetValue()));
 	}
 
+	// Drop clients still trickling a request in or a response out, abandon queued ones, and wait
+	// for in-progress ones, which now observe bForceClose; a worker still waiting for the game
+	// thread cancels its call and returns, since nothing pumps the queue while this joins them
+	bForceClose = true;
+	Reactor.Shutdown();
+	WorkerPool.Shutdown();
+
+	// Game-thread tasks queued by connections that timed out still reference this server
+	DrainOutstandingWork(DrainTimeoutSeconds);
+	GameThreadQueue.Shutdown();
+	RefreshScheduler.Shutdown();
+
 	bIsRunning = false;
 	ServerStartTime = FDateTime::MinValue();
 	ConnectedClientCount.Reset();
-	LogMessage(TEXT("Server stopped"));
+	LogMessage(FString::Printf(TEXT("Server stopped (drained %d operations in %.1f ms)"),
+		OutstandingAtStop, FPlatformTime::ToMilliseconds64(LastDrainCycles.GetValue())));
 }
 
 bool FMCPJsonRpcServer::Init()
@@ -182,272 +277,1834 @@ uint32 FMCPJsonRpcServer::Run()
 {
 	while (!bStopRequested)
 	{
-		if (!ServerSocket)
-		{
-			break;
-		}
+		RunAcceptLoop(ServerSocket, bRetireServerSocket);
 
-		// Check for pending connections
-		bool bHasPendingConnection = false;
-		if (ServerSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+		// A loop retired by RebindPort() continues on the new listener; anything else ends the thread
+		FMCPLocalSocket* OldSocket = nullptr;
 		{
-			// Accept connection
-			FSocket* ClientSocket = ServerSocket->Accept(TEXT("MCPJsonRpcClient"));
-			if (ClientSocket)
+			FScopeLock Lock(&ServerSocketLock);
+			if (bStopRequested || !PendingServerSocket)
 			{
-				// Handle client in async task to avoid blocking
-				AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, ClientSocket]()
-				{
-					HandleClientConnection(ClientSocket);
-				});
+				break;
 			}
+			OldSocket = ServerSocket;
+			ServerSocket = PendingServerSocket;
+			PendingServerSocket = nullptr;
+			bRetireServerSocket = false;
 		}
 
-		// Sleep for a short time to avoid busy waiting
-		FPlatformProcess::Sleep(0.01f);
+		// Connections already accepted on the old port are unaffected; only the listener moves
+		delete OldSocket;
 	}
-
 	return 0;
 }
 
-void FMCPJsonRpcServer::Stop()
-{
-	bStopRequested = true;
-}
-
-void FMCPJsonRpcServer::Exit()
+void FMCPJsonRpcServer::BeginWork()
 {
-	// Cleanup
+	OutstandingWork.Increment();
 }
 
-void FMCPJsonRpcServer::HandleClientConnection(FSocket* ClientSocket)
+void FMCPJsonRpcServer::EndWork()
 {
-	if (!ClientSocket)
+	if (OutstandingWork.Decrement() == 0)
 	{
-		return;
+		WorkDrainedEvent->Trigger();
 	}
+}
 
-	// Increment connected client count
-	ConnectedClientCount.Increment();
-
-	// Read HTTP request
-	TArray<uint8> ReceivedData;
-	uint8 Buffer[1024];
-	int32 BytesRead = 0;
+bool FMCPJsonRpcServer::DrainOutstandingWork(double TimeoutSeconds)
+{
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
 
-	// Configure socket for non-blocking mode with timeout handling
-	ClientSocket->SetNonBlocking(true);
-	
-	// Timeout handling for UE 5.6 compatibility
-	double StartTime = FPlatformTime::Seconds();
-	const double TimeoutSeconds = 5.0;
-	bool bRequestComplete = false;
+	// From inside a queued task, the queue cannot be drained again, so there is nothing to pump
+	const bool bPumpGameThread = IsInGameThread() && !GameThreadQueue.IsDraining();
 
-	while (!bRequestComplete && (FPlatformTime::Seconds() - StartTime) < TimeoutSeconds)
+	while (OutstandingWork.GetValue() > 0)
 	{
-		ESocketConnectionState ConnectionState = ClientSocket->GetConnectionState();
-		if (ConnectionState != SCS_Connected)
+		const double Remaining = Deadline - FPlatformTime::Seconds();
+		if (Remaining <= 0.0)
 		{
-			break;
+			return false;
 		}
 
-		if (ClientSocket->Recv(Buffer, sizeof(Buffer) - 1, BytesRead))
+		if (bPumpGameThread)
 		{
-			if (BytesRead > 0)
-			{
-				ReceivedData.Append(Buffer, BytesRead);
-				
-				// Check if we have a complete HTTP request (look for double CRLF)
-				FString RequestStr = FString::ConstructFromPtrSize((char*)ReceivedData.GetData(), ReceivedData.Num());
-				if (RequestStr.Contains(TEXT("\r\n\r\n")))
-				{
-					bRequestComplete = true;
-					break;
-				}
-			}
+			// Workers may be blocked in ExecuteOnGameThread, which only completes if the game thread runs it
+			GameThreadQueue.Drain(Remaining);
+			WorkDrainedEvent->Wait(FTimespan::FromMilliseconds(FMath::Min(Remaining * 1000.0, 5.0)));
 		}
 		else
 		{
-			// No data available, sleep briefly to avoid busy waiting
-			FPlatformProcess::Sleep(0.001f);
+			WorkDrainedEvent->Wait(FTimespan::FromSeconds(FMath::Min(Remaining, StopPollIntervalSeconds)));
 		}
 	}
+	return true;
+}
 
-	if (ReceivedData.Num() > 0)
+void FMCPJsonRpcServer::RunAcceptLoop(FMCPLocalSocket* Listener, const FThreadSafeBool& bRetired)
+{
+	while (!bStopRequested && !bRetired)
 	{
-		FString RequestData = FString::ConstructFromPtrSize((char*)ReceivedData.GetData(), ReceivedData.Num());
-		FString Response = ProcessHttpRequest(RequestData);
+		if (!Listener)
+		{
+			break;
+		}
 
-		// Send response
-		if (!Response.IsEmpty())
+		// Block until the listen socket becomes readable. StopServer() wakes this wait with a
+		// loopback connection, so the timeout is only a safety net and the idle server costs nothing.
+		if (!Listener->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(AcceptWaitTimeoutSeconds)))
+		{
+			continue;
+		}
+
+		// Drain every connection already queued in the backlog before waiting again; a retiring
+		// listener keeps draining so nothing that reached it before the handover is dropped
+		bool bHasPendingConnection = false;
+		while (!bStopRequested && Listener->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
 		{
-			FTCHARToUTF8 ResponseUTF8(*Response);
-			ClientSocket->Send((uint8*)ResponseUTF8.Get(), ResponseUTF8.Length(), BytesRead);
+			FMCPLocalSocket* ClientSocket = static_cast<FMCPLocalSocket*>(Listener->Accept(TEXT("MCPJsonRpcClient")));
+			if (!ClientSocket)
+			{
+				break;
+			}
+
+			// Never block on the client; headers and body go out as separate sends, so Nagle must not hold back the second one
+			ClientSocket->SetNonBlocking(true);
+			ClientSocket->SetNoDelay(true);
+
+			// A connection counts as in-flight work until it closes, so a drain does not abandon it
+			BeginWork();
+			ConnectedClientCount.Increment();
+			TotalConnectionsAccepted.Increment();
+			if (ClientSocket->GetProtocol() == FMCPLocalSocket::ProtocolName)
+			{
+				LocalConnectionsAccepted.Increment();
+			}
+
+			DispatchConnection(new FMCPConnection(ClientSocket, MaxHttpHeaderBytes, MaxHttpBodyBytes));
 		}
 	}
+}
 
-	// Close client socket
-	ClientSocket->Close();
-	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ClientSocket);
-	
-	// Decrement connected client count
-	ConnectedClientCount.Decrement();
+void FMCPJsonRpcServer::Stop()
+{
+	bStopRequested = true;
+	WakeAcceptLoop();
 }
 
-FString FMCPJsonRpcServer::ProcessHttpRequest(const FString& RequestData)
+void FMCPJsonRpcServer::WakeAcceptLoop()
 {
-	// Simple HTTP parsing - look for JSON content
-	TArray<FString> Lines;
-	RequestData.ParseIntoArrayLines(Lines);
+	WakeTcpListener(ServerPort.load());
+	WakeLocalListener();
+}
 
-	if (Lines.Num() == 0)
+void FMCPJsonRpcServer::WakeTcpListener(int32 Port)
+{
+	// Connecting to our own listener makes the blocking Wait() in Run() return immediately.
+	// A stopping loop exits without accepting it, and it is discarded with the listen socket; a
+	// retiring listener accepts it with the rest of its backlog, and it is then closed like any
+	// client that disconnects without sending a request.
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem || !ServerSocket)
 	{
-		return CreateHttpResponse(TEXT("{\"error\":\"Empty request\"}"));
+		return;
 	}
 
-	// Check if it's a POST request
-	if (!Lines[0].StartsWith(TEXT("POST")))
+	FSocket* WakeSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("MCPJsonRpcWake"), false);
+	if (!WakeSocket)
 	{
-		// Return a simple OK response for GET requests
-		return CreateHttpResponse(TEXT("{\"status\":\"MCP JSON-RPC Server\",\"version\":\"1.0\"}"));
+		return;
 	}
 
-	// Find the JSON content (after the headers)
-	FString JsonContent;
-	bool bFoundContent = false;
-	for (const FString& Line : Lines)
+	TSharedRef<FInternetAddr> WakeAddr = SocketSubsystem->CreateInternetAddr();
+	bool bIsValid = false;
+	WakeAddr->SetIp(TEXT("127.0.0.1"), bIsValid);
+	WakeAddr->SetPort(Port);
+	if (bIsValid)
 	{
-		if (bFoundContent)
-		{
-			JsonContent += Line;
-		}
-		else if (Line.IsEmpty())
-		{
-			bFoundContent = true;
-		}
+		WakeSocket->Connect(*WakeAddr);
 	}
 
-	if (JsonContent.IsEmpty())
+	WakeSocket->Close();
+	SocketSubsystem->DestroySocket(WakeSocket);
+}
+
+void FMCPJsonRpcServer::WakeLocalListener()
+{
+	// Same trick for the local listener
+	if (LocalServerSocket)
 	{
-		return CreateHttpResponse(TEXT("{\"error\":\"No JSON content found\"}"));
+		delete FMCPLocalSocket::ConnectTo(ActiveLocalSocketPath);
 	}
+}
 
-	// Parse JSON
-	TSharedPtr<FJsonObject> JsonRequest;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonContent);
-	
-	if (!FJsonSerializer::Deserialize(Reader, JsonRequest) || !JsonRequest.IsValid())
+void FMCPJsonRpcServer::StartLocalListener()
+{
+	const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> LocalConfig = GetConfig();
+	if (!LocalConfig->bEnableLocalSocket)
 	{
-		return CreateHttpResponse(TEXT("{\"error\":\"Invalid JSON\"}"));
+		return;
 	}
 
-	// Process JSON-RPC request
-	TSharedPtr<FJsonObject> JsonResponse = ProcessJsonRpcRequest(JsonRequest);
-	
-	// Convert response to string
-	FString ResponseContent;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseContent);
-	FJsonSerializer::Serialize(JsonResponse.ToSharedRef(), Writer);
+	FString Error;
+	FMCPLocalSocket* Listener = FMCPLocalSocket::CreateListener(LocalConfig->LocalSocketPath, 8, Error);
+	if (!Listener)
+	{
+		LogMessage(FString::Printf(TEXT("Local socket disabled: %s"), *Error));
+		return;
+	}
 
-	return CreateHttpResponse(ResponseContent);
+	LocalServerSocket = Listener;
+	ActiveLocalSocketPath = LocalConfig->LocalSocketPath;
+	bRetireLocalListener = false;
+	LocalAcceptLoop = Async(EAsyncExecution::Thread, [this, Listener]()
+	{
+		RunAcceptLoop(Listener, bRetireLocalListener);
+	});
+	LogMessage(FString::Printf(TEXT("Serving local socket %s"), *ActiveLocalSocketPath));
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::ProcessJsonRpcRequest(TSharedPtr<FJsonObject> Request)
+void FMCPJsonRpcServer::StopLocalListener()
 {
-	if (!Request.IsValid())
+	if (!LocalServerSocket)
 	{
-		return CreateErrorResponse(-32600, TEXT("Invalid Request"));
+		return;
 	}
 
-	// Get request ID
-	TSharedPtr<FJsonValue> Id = Request->TryGetField(TEXT("id"));
+	// Also used to reopen the listener while the server keeps running, so retire it explicitly
+	bRetireLocalListener = true;
+	WakeLocalListener();
+	if (LocalAcceptLoop.IsValid())
+	{
+		LocalAcceptLoop.Wait();
+		LocalAcceptLoop = TFuture<void>();
+	}
 
-	// Check JSON-RPC version
-	FString JsonRpc;
-	if (!Request->TryGetStringField(TEXT("jsonrpc"), JsonRpc) || JsonRpc != TEXT("2.0"))
+	delete LocalServerSocket;
+	LocalServerSocket = nullptr;
+	FMCPLocalSocket::DeleteSocketFile(ActiveLocalSocketPath);
+	ActiveLocalSocketPath.Empty();
+}
+
+void FMCPJsonRpcServer::Exit()
+{
+	// Cleanup
+}
+
+void FMCPJsonRpcServer::DispatchConnection(FMCPConnection* Connection)
+{
+	// Hand the connection to the dedicated worker pool; answer 503 right away when it is saturated
+	const bool bAdmitted = WorkerPool.TryEnqueue(
+		[this, Connection]()
+		{
+			ServeConnection(Connection);
+		},
+		[this, Connection]()
+		{
+			CloseConnection(Connection);
+		});
+
+	if (bAdmitted)
 	{
-		return CreateErrorResponse(-32600, TEXT("Invalid Request - jsonrpc field must be '2.0'"), Id);
+		return;
 	}
 
-	// Get method name
-	FString Method;
-	if (!Request->TryGetStringField(TEXT("method"), Method))
+	// A 503 must not land in the middle of a response, so finish that one here; it is only a non-blocking send
+	if (Connection->Phase == EMCPConnectionPhase::Writing)
 	{
-		return CreateErrorResponse(-32600, TEXT("Invalid Request - missing method"), Id);
+		if (!SendBufferedResponse(Connection))
+		{
+			return;
+		}
+		if (Connection->bCloseAfterResponse)
+		{
+			CloseConnection(Connection);
+			return;
+		}
+
+		Connection->Phase = EMCPConnectionPhase::Idle;
+		if (!Connection->Parser.HasBufferedData())
+		{
+			Connection->Deadline = FPlatformTime::Seconds() + GetConfig()->TimeoutSeconds;
+			Reactor.Park(Connection);
+			return;
+		}
 	}
+	RejectClientConnection(Connection);
+}
 
-	// Get parameters
-	TSharedPtr<FJsonObject> Params = Request->GetObjectField(TEXT("params"));
+void FMCPJsonRpcServer::ServeConnection(FMCPConnection* Connection)
+{
+	FMCPHttpRequestParser& Parser = Connection->Parser;
+	FMCPHttpResponse& Response = Connection->Response;
 
-	// Handle different methods
-	TSharedPtr<FJsonObject> Result;
-	if (Method == TEXT("ping"))
+	// Back from the reactor with the rest of a response to send
+	if (Connection->Phase == EMCPConnectionPhase::Writing)
 	{
-		Result = HandlePing(Params);
+		if (!SendBufferedResponse(Connection))
+		{
+			return;
+		}
+		if (Connection->bCloseAfterResponse)
+		{
+			CloseConnection(Connection);
+			return;
+		}
+		Connection->Phase = EMCPConnectionPhase::Idle;
 	}
-	else if (Method == TEXT("getBlueprints"))
+
+	// Back from the game thread with the answer to the request that was waiting for it
+	if (Connection->bAwaitingGameThread && !SendPendingResponse(Connection))
 	{
-		Result = HandleGetBlueprints(Params);
+		return;
 	}
-	else if (Method == TEXT("getActors"))
+
+	// Serve requests until the client asks to close, goes idle, or hits the per-connection cap.
+	// A stopping server ends the loop through bKeepAlive, after the request in progress is answered.
+	while (!bForceClose)
 	{
-		Result = HandleGetActors(Params);
+		// Settings applied while this connection is open take effect from its next request
+		const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> RequestConfig = GetConfig();
+
+		bool bConnectionLost = false;
+		const EMCPHttpParseResult ParseResult = ReceiveHttpRequest(*Connection, bConnectionLost);
+		if (ParseResult == EMCPHttpParseResult::NeedMoreData)
+		{
+			// While draining, only a request that has started arriving is worth waiting for
+			if (bConnectionLost || (bStopRequested && !Parser.HasBufferedData()))
+			{
+				break;
+			}
+
+			// Nothing to do until the client sends more, so give the worker back and let the reactor
+			// watch the socket. A request gets TimeoutSeconds from its first byte; trickling more
+			// bytes does not extend it.
+			const double Now = FPlatformTime::Seconds();
+			if (!Parser.HasBufferedData())
+			{
+				Connection->Phase = EMCPConnectionPhase::Idle;
+				Connection->Deadline = Now + RequestConfig->TimeoutSeconds;
+			}
+			else if (Connection->Phase != EMCPConnectionPhase::Reading)
+			{
+				Connection->Phase = EMCPConnectionPhase::Reading;
+				Connection->Deadline = Now + RequestConfig->TimeoutSeconds;
+			}
+			Reactor.Park(Connection);
+			return;
+		}
+
+		Response.Reset();
+		bool bKeepAlive = false;
+		if (ParseResult == EMCPHttpParseResult::Complete)
+		{
+			const FMCPHttpRequest& Request = Parser.GetRequest();
+
+			++Connection->RequestsServed;
+			TotalRequestsServed.Increment();
+			if (Connection->RequestsServed > 1)
+			{
+				ReusedConnectionRequests.Increment();
+			}
+
+			if (IsWebSocketUpgrade(Request))
+			{
+				// The connection either switches protocols for good or gets an error and closes
+				const bool bAccepted = AcceptWebSocketUpgrade(Request, Response);
+				Parser.ConsumeRequest();
+				if (bAccepted)
+				{
+					// A session keeps its worker for its whole lifetime
+					if (SendHttpResponse(Connection->Socket, Response))
+					{
+						ServeWebSocket(Connection->Socket, Parser.GetBufferedBytes());
+					}
+					ActiveWebSocketSessions.Decrement();
+					break;
+				}
+			}
+			else
+			{
+				// A draining server answers this request with Connection: close
+				bKeepAlive = Request.IsKeepAlive() && !bStopRequested &&
+					(RequestConfig->MaxRequestsPerConnection <= 0 || Connection->RequestsServed < RequestConfig->MaxRequestsPerConnection);
+
+				// Set before a deferred request hands the connection over, for the worker that answers it
+				Connection->bCloseAfterResponse = !bKeepAlive;
+				if (!ProcessHttpRequest(Connection, Request, bKeepAlive, Response))
+				{
+					// The request stays in the parser until SendPendingResponse() answers it
+					return;
+				}
+				Parser.ConsumeRequest();
+			}
+		}
+		else
+		{
+			LogMessage(FString::Printf(TEXT("Rejecting malformed request: %s"), *Parser.GetErrorMessage()));
+			CreateHttpErrorResponse(Parser.GetErrorStatusCode(), Parser.GetErrorMessage(), Response);
+		}
+
+		// Send response
+		Connection->bCloseAfterResponse = !bKeepAlive;
+		if (Response.IsStreamed())
+		{
+			// The body is generated while it is sent, so a streamed response keeps its worker
+			if (!SendHttpResponse(Connection->Socket, Response))
+			{
+				break;
+			}
+		}
+		else
+		{
+			Connection->BytesSent = 0;
+			if (!SendBufferedResponse(Connection))
+			{
+				return;
+			}
+		}
+
+		if (!bKeepAlive)
+		{
+			break;
+		}
+		Connection->Phase = EMCPConnectionPhase::Idle;
 	}
-	else if (Method == TEXT("resources.list"))
+
+	CloseConnection(Connection);
+}
+
+bool FMCPJsonRpcServer::SendPendingResponse(FMCPConnection* Connection)
+{
+	Connection->bAwaitingGameThread = false;
+	const TSharedPtr<FJsonObject> PendingResponse = MoveTemp(Connection->PendingResponse);
+	const TFunction<void(FMCPJsonWriter&)> PendingStream = MoveTemp(Connection->PendingStream);
+	const TFunction<int32(TArray<uint8>&)> PendingBatch = MoveTemp(Connection->PendingBatch);
+	if (bForceClose)
 	{
-		Result = HandleResourcesList(Params);
+		CloseConnection(Connection);
+		return false;
 	}
-	else if (Method == TEXT("resources.get"))
+
+	FMCPHttpResponse& Response = Connection->Response;
+	if (PendingBatch)
 	{
-		Result = HandleResourcesGet(Params);
+		WriteBatchResponse(Response, PendingBatch, !Connection->bCloseAfterResponse, Connection->Parser.GetRequest());
 	}
-	else if (Method == TEXT("resources.create"))
+	else if (PendingStream)
 	{
-		Result = HandleResourcesCreate(Params);
+		// Buffered rather than chunked, so the body goes out through the reactor like any other
+		// deferred response instead of keeping this worker until the client has read it
+		FMCPJsonWriter Writer(Response.Body);
+		PendingStream(Writer);
+		Response.BytesCopied += Response.Body.Num();
+		CreateHttpResponse(Response, !Connection->bCloseAfterResponse, Connection->Parser.GetRequest());
 	}
-	else if (Method == TEXT("tools.create_blueprint"))
+	else
 	{
-		Result = HandleToolsCreateBlueprint(Params);
+		WriteJsonBody(Response, *PendingResponse);
+		CreateHttpResponse(Response, !Connection->bCloseAfterResponse, Connection->Parser.GetRequest());
 	}
-	else if (Method == TEXT("tools.add_variable"))
+	Connection->Parser.ConsumeRequest();
+
+	Connection->BytesSent = 0;
+	if (!SendBufferedResponse(Connection))
 	{
-		Result = HandleToolsAddVariable(Params);
+		return false;
 	}
-	else if (Method == TEXT("tools.add_function"))
+	if (Connection->bCloseAfterResponse)
 	{
-		Result = HandleToolsAddFunction(Params);
+		CloseConnection(Connection);
+		return false;
 	}
-	else if (Method == TEXT("tools.edit_graph"))
+	Connection->Phase = EMCPConnectionPhase::Idle;
+	return true;
+}
+
+void FMCPJsonRpcServer::CloseConnection(FMCPConnection* Connection)
+{
+	CloseClientSocket(Connection->Socket);
+	delete Connection;
+
+	ConnectedClientCount.Decrement();
+	EndWork();
+}
+
+void FMCPJsonRpcServer::RejectClientConnection(FMCPConnection* Connection)
+{
+	RejectedConnections.Increment();
+
+	// The socket is idle with an empty send buffer, so this small write does not block the caller
+	FMCPHttpResponse Response;
+	CreateHttpErrorResponse(503, TEXT("Server busy, retry shortly"), Response);
+	for (const TArray<uint8>* Segment : { &Response.Header, &Response.Body })
 	{
-		Result = HandleToolsEditGraph(Params);
+		int32 BytesSent = 0;
+		Connection->Socket->Send(Segment->GetData(), Segment->Num(), BytesSent);
 	}
-	else if (Method == TEXT("prompts.list"))
+
+	CloseConnection(Connection);
+}
+
+void FMCPJsonRpcServer::CloseClientSocket(FSocket* ClientSocket)
+{
+	ClientSocket->Close();
+
+	// Native sockets are not owned by the socket subsystem
+	if (FMCPLocalSocket::IsLocalSocket(ClientSocket))
 	{
-		Result = HandlePromptsList(Params);
+		delete ClientSocket;
+		return;
 	}
-	else if (Method == TEXT("prompts.get"))
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ClientSocket);
+}
+
+bool FMCPJsonRpcServer::IsWebSocketUpgrade(const FMCPHttpRequest& Request)
+{
+	const FString* Upgrade = Request.FindHeader(TEXT("upgrade"));
+	const FString* Connection = Request.FindHeader(TEXT("connection"));
+	if (Request.Method != TEXT("GET") || !Upgrade || !Connection || !Upgrade->TrimStartAndEnd().Equals(TEXT("websocket"), ESearchCase::IgnoreCase))
 	{
-		Result = HandlePromptsGet(Params);
+		return false;
 	}
-	else
+
+	// Connection is a token list, e.g. "keep-alive, Upgrade"
+	TArray<FString> Tokens;
+	Connection->ParseIntoArray(Tokens, TEXT(","));
+	for (const FString& Token : Tokens)
 	{
-		return CreateErrorResponse(-32601, TEXT("Method not found"), Id);
+		if (Token.TrimStartAndEnd().Equals(TEXT("upgrade"), ESearchCase::IgnoreCase))
+		{
+			return true;
+		}
 	}
+	return false;
+}
 
-	// Create success response
-	TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject);
-	Response->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
-	Response->SetObjectField(TEXT("result"), Result);
-	if (Id.IsValid())
+bool FMCPJsonRpcServer::AcceptWebSocketUpgrade(const FMCPHttpRequest& Request, FMCPHttpResponse& OutResponse)
+{
+	const FString* Version = Request.FindHeader(TEXT("sec-websocket-version"));
+	const FString* Key = Request.FindHeader(TEXT("sec-websocket-key"));
+	if (!Version || Version->TrimStartAndEnd() != TEXT("13"))
 	{
-		Response->SetField(TEXT("id"), Id);
+		CreateHttpErrorResponse(426, TEXT("Unsupported WebSocket version"), OutResponse);
+		return false;
+	}
+	if (!Key || !FMCPWebSocket::IsValidClientKey(*Key))
+	{
+		CreateHttpErrorResponse(400, TEXT("Invalid Sec-WebSocket-Key"), OutResponse);
+		return false;
 	}
 
-	return Response;
-}
+	// Browsers always send Origin; hold WebSocket pages to the same allow-list as fetch()
+	const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> UpgradeConfig = GetConfig();
+	const TSharedRef<const FMCPHttpHeaderBlock, ESPMode::ThreadSafe>& Block = UpgradeConfig->HeaderBlock;
+	const FString* Origin = Request.FindHeader(TEXT("origin"));
+	if (Origin && Block->bEnableCORS && !Block->bAllowAnyOrigin && !Block->IsOriginAllowed(*Origin))
+	{
+		CreateHttpErrorResponse(403, TEXT("Origin not allowed"), OutResponse);
+		return false;
+	}
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandlePing(TSharedPtr<FJsonObject> Params)
-{
+	// Sessions hold a pool worker for their lifetime, so leave at least half the workers for HTTP
+	const int32 MaxSessions = FMath::Max(1, UpgradeConfig->MaxConnections / 2);
+	if (ActiveWebSocketSessions.Increment() > MaxSessions)
+	{
+		ActiveWebSocketSessions.Decrement();
+		CreateHttpErrorResponse(503, TEXT("Too many WebSocket sessions"), OutResponse);
+		return false;
+	}
+
+	OutResponse.BeginHeaders(101);
+	OutResponse.AddHeader("Upgrade", "websocket");
+	OutResponse.AddHeader("Connection", "Upgrade");
+	OutResponse.AddHeader("Sec-WebSocket-Accept", FMCPWebSocket::ComputeAcceptKey(*Key));
+	OutResponse.FinishHeaders();
+	return true;
+}
+
+void FMCPJsonRpcServer::ServeWebSocket(FSocket* ClientSocket, TArrayView<const uint8> InitialBytes)
+{
+	TSharedRef<FMCPWebSocketSession, ESPMode::ThreadSafe> Session =
+		MakeShared<FMCPWebSocketSession, ESPMode::ThreadSafe>(ClientSocket, MaxWebSocketOutboxBytes);
+	{
+		FScopeLock Lock(&WebSocketSessionsLock);
+		WebSocketSessions.Add(Session);
+	}
+	WebSocketSessionsOpened.Increment();
+
+	FMCPWebSocketFrameParser FrameParser(MaxHttpBodyBytes);
+	FrameParser.Append(InitialBytes);
+
+	FMCPWebSocketMessage Message;
+	TArray<uint8> JsonScratch;
+	TArray<uint8> FrameScratch;
+	double LastReceiveTime = FPlatformTime::Seconds();
+	double PingSentTime = 0.0;
+	uint16 CloseCode = 0;
+	bool bPeerClosed = false;
+
+	while (!bStopRequested && !Session->IsClosed())
+	{
+		// Answer every complete message before waiting again
+		EMCPWebSocketParseResult ParseResult = EMCPWebSocketParseResult::NeedMoreData;
+		while (CloseCode == 0 && !bPeerClosed && (ParseResult = FrameParser.Parse(Message)) == EMCPWebSocketParseResult::Message)
+		{
+			switch (Message.Opcode)
+			{
+			case EMCPWebSocketOpcode::Text:
+				WebSocketMessagesReceived.Increment();
+				HandleWebSocketMessage(*Session, Message.Payload, JsonScratch, FrameScratch);
+				break;
+
+			case EMCPWebSocketOpcode::Ping:
+				FrameScratch.Reset();
+				FMCPWebSocket::EncodeFrame(EMCPWebSocketOpcode::Pong, Message.Payload.GetData(), Message.Payload.Num(), FrameScratch);
+				Session->Send(FrameScratch);
+				break;
+
+			case EMCPWebSocketOpcode::Pong:
+				PingSentTime = 0.0;
+				break;
+
+			case EMCPWebSocketOpcode::Close:
+				// Echo the status code to complete the closing handshake
+				FrameScratch.Reset();
+				FMCPWebSocket::EncodeFrame(EMCPWebSocketOpcode::Close, Message.Payload.GetData(), FMath::Min(Message.Payload.Num(), 2), FrameScratch);
+				Session->Send(FrameScratch);
+				bPeerClosed = true;
+				break;
+
+			default:
+				// JSON-RPC is text only (1003: unsupported data)
+				CloseCode = 1003;
+				break;
+			}
+		}
+		if (ParseResult == EMCPWebSocketParseResult::Error)
+		{
+			CloseCode = FrameParser.GetCloseCode();
+		}
+		if (CloseCode != 0 || bPeerClosed || Session->IsClosed())
+		{
+			break;
+		}
+
+		// Ping idle clients and drop those that stopped answering
+		const double Now = FPlatformTime::Seconds();
+		if (PingSentTime > 0.0 && Now - PingSentTime > (double)GetConfig()->TimeoutSeconds)
+		{
+			LogMessage(TEXT("Closing WebSocket session: ping timed out"));
+			break;
+		}
+		if (PingSentTime == 0.0 && Now - LastReceiveTime > WebSocketPingIntervalSeconds)
+		{
+			FrameScratch.Reset();
+			FMCPWebSocket::EncodeFrame(EMCPWebSocketOpcode::Ping, nullptr, 0, FrameScratch);
+			Session->Send(FrameScratch);
+			PingSentTime = Now;
+		}
+
+		// Also wake for writability while frames are waiting for a slow reader
+		const ESocketWaitConditions::Type WaitCondition = Session->HasPendingOutput()
+			? ESocketWaitConditions::WaitForReadOrWrite
+			: ESocketWaitConditions::WaitForRead;
+		if (!ClientSocket->Wait(WaitCondition, FTimespan::FromSeconds(StopPollIntervalSeconds)))
+		{
+			continue;
+		}
+		if (!Session->Flush())
+		{
+			break;
+		}
+
+		const int32 ReadSize = 16 * 1024;
+		int32 BytesRead = 0;
+		if (!ClientSocket->Recv(FrameParser.GetWriteBuffer(ReadSize), ReadSize, BytesRead))
+		{
+			if (ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() == SE_EWOULDBLOCK)
+			{
+				// Woken for writability only
+				continue;
+			}
+			break;
+		}
+		if (BytesRead <= 0)
+		{
+			// Peer closed the TCP connection without a Close frame
+			break;
+		}
+		FrameParser.CommitWrite(BytesRead);
+		LastReceiveTime = FPlatformTime::Seconds();
+	}
+
+	// Start the closing handshake ourselves (1001: going away when the server stops)
+	if (!bPeerClosed && (CloseCode != 0 || bStopRequested))
+	{
+		FrameScratch.Reset();
+		FMCPWebSocket::EncodeCloseFrame(CloseCode != 0 ? CloseCode : 1001, FrameScratch);
+		Session->Send(FrameScratch);
+	}
+
+	// Give queued frames (e.g. the Close) a short grace period to leave
+	const double FlushDeadline = FPlatformTime::Seconds() + 1.0;
+	while (Session->HasPendingOutput() && FPlatformTime::Seconds() < FlushDeadline &&
+		ClientSocket->Wait(ESocketWaitConditions::WaitForWrite, FTimespan::FromSeconds(0.1)) && Session->Flush())
+	{
+	}
+
+	Session->MarkClosed();
+	{
+		FScopeLock Lock(&WebSocketSessionsLock);
+		WebSocketSessions.Remove(Session);
+	}
+}
+
+bool FMCPJsonRpcServer::HandleWebSocketMessage(FMCPWebSocketSession& Session, const TArray<uint8>& Payload, TArray<uint8>& JsonScratch, TArray<uint8>& FrameScratch)
+{
+	FMCPJsonRpcEnvelope JsonRequest;
+	TArray<FMCPJsonRpcEnvelope> Batch;
+	const EMCPJsonRpcBody BodyKind = ReadJsonRpcBody(Payload, JsonRequest, Batch);
+
+	JsonScratch.Reset();
+	if (BodyKind == EMCPJsonRpcBody::Malformed)
+	{
+		SerializeJsonUtf8(*CreateErrorResponse(-32700, TEXT("Parse error")), JsonScratch);
+	}
+	else if (BodyKind == EMCPJsonRpcBody::Batch)
+	{
+		if (Batch.Num() == 0 || Batch.Num() > MaxBatchEntries)
+		{
+			const FString ErrorMessage = Batch.Num() == 0
+				? FString(TEXT("Invalid Request - empty batch"))
+				: FString::Printf(TEXT("Invalid Request - batch exceeds %d entries"), MaxBatchEntries);
+			SerializeJsonUtf8(*CreateErrorResponse(-32600, ErrorMessage), JsonScratch);
+		}
+		else if (ProcessJsonRpcBatch(Batch, JsonScratch) == 0)
+		{
+			return true;
+		}
+	}
+	else if (BodyKind == EMCPJsonRpcBody::Request)
+	{
+		if (TSharedPtr<FJsonObject> RateLimitError = CheckRateLimit(JsonRequest))
+		{
+			if (JsonRequest.IsNotification())
+			{
+				return true;
+			}
+			SerializeJsonUtf8(*RateLimitError, JsonScratch);
+		}
+		else
+		{
+			// Notifications are executed but never answered
+			FMCPResultStreamer Streamer;
+			TSharedPtr<FJsonObject> JsonResponse = ProcessJsonRpcRequest(JsonRequest, Streamer);
+			if (JsonRequest.IsNotification())
+			{
+				return true;
+			}
+			if (Streamer)
+			{
+				// A message is framed as a whole, so streamed results go into one buffer
+				FMCPJsonWriter Writer(JsonScratch);
+				WriteStreamedJsonRpcResponse(Writer, Streamer, JsonRequest.Id);
+			}
+			else
+			{
+				SerializeJsonUtf8(*JsonResponse, JsonScratch);
+			}
+		}
+	}
+	else
+	{
+		SerializeJsonUtf8(*CreateErrorResponse(-32600, TEXT("Invalid Request")), JsonScratch);
+	}
+
+	FrameScratch.Reset();
+	FMCPWebSocket::EncodeFrame(EMCPWebSocketOpcode::Text, JsonScratch.GetData(), JsonScratch.Num(), FrameScratch);
+	return Session.Send(FrameScratch);
+}
+
+void FMCPJsonRpcServer::BroadcastNotification(const FString& Method, TSharedPtr<FJsonObject> Params)
+{
+	{
+		FScopeLock Lock(&WebSocketSessionsLock);
+		if (WebSocketSessions.Num() == 0)
+		{
+			return;
+		}
+	}
+
+	TSharedPtr<FJsonObject> Notification = MakeShareable(new FJsonObject);
+	Notification->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+	Notification->SetStringField(TEXT("method"), Method);
+	if (Params.IsValid())
+	{
+		Notification->SetObjectField(TEXT("params"), Params);
+	}
+
+	// Serialize and frame once, then queue the same bytes to every session
+	TArray<uint8> Json;
+	SerializeJsonUtf8(*Notification, Json);
+	TArray<uint8> Frame;
+	FMCPWebSocket::EncodeFrame(EMCPWebSocketOpcode::Text, Json.GetData(), Json.Num(), Frame);
+
+	FScopeLock Lock(&WebSocketSessionsLock);
+	for (const TSharedRef<FMCPWebSocketSession, ESPMode::ThreadSafe>& Session : WebSocketSessions)
+	{
+		if (Session->Send(Frame))
+		{
+			NotificationsSent.Increment();
+		}
+	}
+}
+
+void FMCPJsonRpcServer::RegisterNotificationSources()
+{
+	check(IsInGameThread());
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	auto BroadcastAssetChange = [this](const TCHAR* Change, const FAssetData& AssetData, const FString* OldObjectPath)
+	{
+		// The initial scan reports every asset in the project; only live edits are interesting
+		IAssetRegistry* Registry = IAssetRegistry::Get();
+		if (ActiveWebSocketSessions.GetValue() == 0 || !Registry || Registry->IsLoadingAssets())
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject);
+		Params->SetStringField(TEXT("change"), Change);
+		Params->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
+		Params->SetStringField(TEXT("path"), AssetData.GetObjectPathString());
+		Params->SetStringField(TEXT("class"), AssetData.AssetClassPath.GetAssetName().ToString());
+		if (OldObjectPath)
+		{
+			Params->SetStringField(TEXT("old_path"), *OldObjectPath);
+		}
+		BroadcastNotification(TEXT("assets.changed"), Params);
+	};
+
+	// Cached results are dropped for every change, including those of the initial scan
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddLambda([this, BroadcastAssetChange](const FAssetData& AssetData)
+	{
+		InvalidateCachedResults(AssetData);
+		BroadcastAssetChange(TEXT("added"), AssetData, nullptr);
+	});
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddLambda([this, BroadcastAssetChange](const FAssetData& AssetData)
+	{
+		InvalidateCachedResults(AssetData);
+		BroadcastAssetChange(TEXT("removed"), AssetData, nullptr);
+	});
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddLambda([this, BroadcastAssetChange](const FAssetData& AssetData, const FString& OldObjectPath)
+	{
+		const FString OldPackageName = FSoftObjectPath(OldObjectPath).GetLongPackageName();
+		ResultCache.Invalidate(FName(*OldPackageName));
+		ResultCache.Invalidate(FName(*FPackageName::GetLongPackagePath(OldPackageName)));
+		InvalidateCachedResults(AssetData);
+		BroadcastAssetChange(TEXT("renamed"), AssetData, &OldObjectPath);
+	});
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddLambda([this](const FAssetData& AssetData)
+	{
+		InvalidateCachedResults(AssetData);
+	});
+
+	// Blueprint edits change resources.get results long before the asset is saved. Modify() runs
+	// on every edit in the editor, so anything outside a Blueprint is let through cheaply.
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddLambda([this](UObject* Object)
+	{
+		const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+		if (!Blueprint && Object)
+		{
+			Blueprint = Object->GetTypedOuter<UBlueprint>();
+		}
+		if (Blueprint)
+		{
+			ResultCache.Invalidate(Blueprint->GetPackage()->GetFName());
+		}
+	});
+
+	if (GEditor)
+	{
+		// OnBlueprintCompiled has no payload, so remember which blueprints went into the compile
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddLambda([this](UBlueprint* Blueprint)
+		{
+			if (Blueprint)
+			{
+				ResultCache.Invalidate(Blueprint->GetPackage()->GetFName());
+			}
+			CompilingBlueprints.AddUnique(Blueprint);
+		});
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]()
+		{
+			for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : CompilingBlueprints)
+			{
+				if (UBlueprint* Blueprint = WeakBlueprint.Get())
+				{
+					TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject);
+					Params->SetStringField(TEXT("name"), Blueprint->GetName());
+					Params->SetStringField(TEXT("path"), Blueprint->GetPathName());
+					Params->SetStringField(TEXT("status"), Blueprint->Status == BS_Error ? TEXT("error") : TEXT("success"));
+					BroadcastNotification(TEXT("blueprints.compiled"), Params);
+				}
+			}
+			CompilingBlueprints.Reset();
+		});
+	}
+}
+
+void FMCPJsonRpcServer::UnregisterNotificationSources()
+{
+	check(IsInGameThread());
+
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	ObjectModifiedHandle.Reset();
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+	BlueprintPreCompileHandle.Reset();
+	BlueprintCompiledHandle.Reset();
+	CompilingBlueprints.Reset();
+
+	// Nothing would invalidate what is cached from here on
+	ResultCache.Empty();
+}
+
+void FMCPJsonRpcServer::InvalidateCachedResults(const FAssetData& AssetData)
+{
+	ResultCache.Invalidate(AssetData.PackagePath);
+	ResultCache.Invalidate(AssetData.PackageName);
+}
+
+EMCPHttpParseResult FMCPJsonRpcServer::ReceiveHttpRequest(FMCPConnection& Connection, bool& bOutConnectionLost)
+{
+	FMCPHttpRequestParser& Parser = Connection.Parser;
+	bOutConnectionLost = false;
+
+	while (true)
+	{
+		// Pipelined bytes from the previous read may already hold a full request
+		const EMCPHttpParseResult ParseResult = Parser.Parse();
+		if (ParseResult != EMCPHttpParseResult::NeedMoreData)
+		{
+			return ParseResult;
+		}
+
+		// Receive straight into the parser's buffer; the socket is non-blocking, so this never waits
+		const int32 ReadSize = Parser.GetRecommendedReadSize();
+		int32 BytesRead = 0;
+		if (!Connection.Socket->Recv(Parser.GetWriteBuffer(ReadSize), ReadSize, BytesRead))
+		{
+			bOutConnectionLost = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK;
+			return EMCPHttpParseResult::NeedMoreData;
+		}
+		if (BytesRead <= 0)
+		{
+			// The peer closed the connection
+			bOutConnectionLost = true;
+			return EMCPHttpParseResult::NeedMoreData;
+		}
+		Parser.CommitWrite(BytesRead);
+	}
+}
+
+/**
+ * A batch whose game-thread entries may still be running, shared with their continuations.
+ * Entries are prepared before any call is queued, since their params point into the request
+ * body, which the batch may outlive.
+ */
+struct FMCPJsonRpcServer::FJsonRpcBatch
+{
+	TArray<FPreparedRequest> Requests;
+
+	/** Each entry's response is written once, by whichever thread produced it */
+	TArray<TSharedPtr<FJsonObject>> Responses;
+
+	/** Streamers of streamed entries, called on the worker that writes the batch's response */
+	TArray<FMCPResultStreamer> Streamers;
+
+	/** Entries that are executed but not answered (JSON-RPC 2.0 section 6) */
+	TArray<bool> Notifications;
+
+	/** Calls queued for the game-thread entries, so those still outstanding can be cancelled */
+	TArray<TMCPGameThreadCall<TSharedPtr<FJsonObject>>::FStateRef> Calls;
+
+	/** Longest timeout among the game-thread entries */
+	double TimeoutSeconds = 0.0;
+
+	/** Entries still waiting for the game thread, plus one for the worker's own entries; the last to finish fulfils the promise */
+	FThreadSafeCounter Remaining;
+	TPromise<void> DonePromise;
+	TFuture<void> Done;
+
+	void Finish()
+	{
+		if (Remaining.Decrement() == 0)
+		{
+			DonePromise.SetValue();
+		}
+	}
+
+	/** Resolve every outstanding call unset; their continuations answer them with a timeout error */
+	void Cancel() const
+	{
+		for (const TMCPGameThreadCall<TSharedPtr<FJsonObject>>::FStateRef& Call : Calls)
+		{
+			Call->Cancel();
+		}
+	}
+};
+
+bool FMCPJsonRpcServer::ProcessHttpRequest(FMCPConnection* Connection, const FMCPHttpRequest& Request, bool bKeepAlive, FMCPHttpResponse& OutResponse)
+{
+	// Check if it's a POST request
+	if (Request.Method != TEXT("POST"))
+	{
+		// Return a simple OK response for GET requests
+		OutResponse.SetBody("{\"status\":\"MCP JSON-RPC Server\",\"version\":\"1.0\"}");
+		CreateHttpResponse(OutResponse, bKeepAlive, Request);
+		return true;
+	}
+
+	if (Request.Body.Num() == 0)
+	{
+		OutResponse.SetBody("{\"error\":\"No JSON content found\"}");
+		CreateHttpResponse(OutResponse, bKeepAlive, Request);
+		return true;
+	}
+
+	// Read the request straight from the UTF-8 body held by the parser; params stay unparsed until
+	// the method is known
+	FMCPJsonRpcEnvelope JsonRequest;
+	TArray<FMCPJsonRpcEnvelope> Batch;
+	const EMCPJsonRpcBody BodyKind = ReadJsonRpcBody(Request.Body, JsonRequest, Batch);
+	if (BodyKind == EMCPJsonRpcBody::Malformed || BodyKind == EMCPJsonRpcBody::Other)
+	{
+		OutResponse.SetBody("{\"error\":\"Invalid JSON\"}");
+		CreateHttpResponse(OutResponse, bKeepAlive, Request);
+		return true;
+	}
+
+	// A JSON array is a JSON-RPC batch; answer all of its entries in one response
+	if (BodyKind == EMCPJsonRpcBody::Batch)
+	{
+		if (Batch.Num() == 0 || Batch.Num() > MaxBatchEntries)
+		{
+			const FString Message = Batch.Num() == 0
+				? FString(TEXT("Invalid Request - empty batch"))
+				: FString::Printf(TEXT("Invalid Request - batch exceeds %d entries"), MaxBatchEntries);
+			WriteJsonBody(OutResponse, *CreateErrorResponse(-32600, Message));
+			CreateHttpResponse(OutResponse, bKeepAlive, Request);
+			return true;
+		}
+
+		const TSharedRef<FJsonRpcBatch, ESPMode::ThreadSafe> Started = StartJsonRpcBatch(Batch);
+		TFunction<int32(TArray<uint8>&)> WriteResponses = [this, Started](TArray<uint8>& Out)
+		{
+			return WriteJsonRpcBatch(*Started, Out);
+		};
+		if (Started->Done.IsReady())
+		{
+			WriteBatchResponse(OutResponse, WriteResponses, bKeepAlive, Request);
+			return true;
+		}
+
+		// Like a single request, a batch still waiting for the game thread does not hold its worker;
+		// the connection is dispatched again once every entry has a response
+		DeferredRequests.Increment();
+		Connection->bAwaitingGameThread = true;
+		Connection->PendingBatch = MoveTemp(WriteResponses);
+		Started->Done.Then([this, Connection](TFuture<void>)
+		{
+			DispatchConnection(Connection);
+		});
+		return false;
+	}
+
+	// Over-limit requests are refused before any handler runs
+	if (TSharedPtr<FJsonObject> RateLimitError = CheckRateLimit(JsonRequest))
+	{
+		WriteJsonBody(OutResponse, *RateLimitError);
+		CreateHttpResponse(OutResponse, bKeepAlive, Request);
+		return true;
+	}
+
+	// Process JSON-RPC request. A handler that needs the game thread runs without this worker
+	// waiting for it; the connection is picked up again when the call completes.
+	FPreparedRequest Prepared;
+	PrepareJsonRpcRequest(JsonRequest, Prepared);
+	if (Prepared.RequiresGameThread())
+	{
+		DeferToGameThread(Connection, MoveTemp(Prepared));
+		return false;
+	}
+
+	// Stream handlers queue their own game-thread work; a result still waiting for it is answered
+	// the same way, without this worker
+	FMCPResultStreamer Streamer;
+	TSharedPtr<FJsonObject> JsonResponse;
+	if (Prepared.IsStreamed())
+	{
+		TFuture<FMCPResultStreamer> PendingStreamer = Prepared.Stream();
+		if (!PendingStreamer.IsReady())
+		{
+			DeferStreamedResult(Connection, MoveTemp(PendingStreamer), MoveTemp(Prepared.Id));
+			return false;
+		}
+		Streamer = PendingStreamer.Get();
+		if (!Streamer)
+		{
+			JsonResponse = CreateResultResponse(nullptr, Prepared.Id);
+		}
+	}
+	else
+	{
+		JsonResponse = RunPreparedRequest(Prepared, Streamer);
+	}
+
+	// Streamed results are written element by element instead of being built as one JSON tree
+	if (Streamer)
+	{
+		TSharedPtr<FJsonValue> Id = JsonRequest.Id;
+
+		// HTTP/1.0 has no chunked encoding, so those clients get the same bytes in one buffered body
+		if (Request.Version == TEXT("HTTP/1.0"))
+		{
+			FMCPJsonWriter Writer(OutResponse.Body);
+			WriteStreamedJsonRpcResponse(Writer, Streamer, Id);
+			OutResponse.BytesCopied += OutResponse.Body.Num();
+		}
+		else
+		{
+			OutResponse.BodyStreamer = [this, Streamer = MoveTemp(Streamer), Id](FArchive& Archive)
+			{
+				FMCPJsonWriter Writer(Archive);
+				WriteStreamedJsonRpcResponse(Writer, Streamer, Id);
+				Writer.Close();
+			};
+		}
+		CreateHttpResponse(OutResponse, bKeepAlive, Request);
+		return true;
+	}
+
+	WriteJsonBody(OutResponse, *JsonResponse);
+	CreateHttpResponse(OutResponse, bKeepAlive, Request);
+	return true;
+}
+
+void FMCPJsonRpcServer::DeferToGameThread(FMCPConnection* Connection, FPreparedRequest&& Prepared)
+{
+	DeferredRequests.Increment();
+	Connection->bAwaitingGameThread = true;
+
+	const double TimeoutSeconds = GetGameThreadTimeout(*Prepared.Descriptor);
+	QueueOnGameThread<TSharedPtr<FJsonObject>>(MoveTemp(Prepared.Invoke), TimeoutSeconds).Then(
+		[this, Connection, Id = MoveTemp(Prepared.Id)](TFuture<TOptional<TSharedPtr<FJsonObject>>> Future)
+		{
+			const TOptional<TSharedPtr<FJsonObject>>& Result = Future.Get();
+			Connection->PendingResponse = CreateResultResponse(Result.IsSet() ? Result.GetValue() : nullptr, Id);
+			DispatchConnection(Connection);
+		});
+}
+
+void FMCPJsonRpcServer::DeferStreamedResult(FMCPConnection* Connection, TFuture<FMCPResultStreamer>&& PendingStreamer, TSharedPtr<FJsonValue> Id)
+{
+	DeferredRequests.Increment();
+	Connection->bAwaitingGameThread = true;
+
+	// The handler's game-thread calls carry their own deadlines, so the future resolves either way.
+	// Only the streamer is stored here; it writes the response on the worker that picks the
+	// connection up again, not on the game thread.
+	PendingStreamer.Then([this, Connection, Id = MoveTemp(Id)](TFuture<FMCPResultStreamer> Future)
+	{
+		const FMCPResultStreamer& Streamer = Future.Get();
+		if (Streamer)
+		{
+			Connection->PendingStream = [this, Streamer, Id](FMCPJsonWriter& Writer)
+			{
+				WriteStreamedJsonRpcResponse(Writer, Streamer, Id);
+			};
+		}
+		else
+		{
+			Connection->PendingResponse = CreateResultResponse(nullptr, Id);
+		}
+		DispatchConnection(Connection);
+	});
+}
+
+void FMCPJsonRpcServer::WriteJsonBody(FMCPHttpResponse& Response, const FJsonObject& Object)
+{
+	// Serialize the response straight into the UTF-8 body buffer
+	const int32 OldBodyMax = Response.Body.Max();
+	SerializeJsonUtf8(Object, Response.Body);
+	Response.BytesCopied += Response.Body.Num();
+	Response.Allocations += (Response.Body.Max() != OldBodyMax) ? 1 : 0;
+}
+
+void FMCPJsonRpcServer::SerializeJsonUtf8(const FJsonObject& Object, TArray<uint8>& Out)
+{
+	FMCPJsonWriter Writer(Out);
+	Writer.WriteValue(Object);
+	ResponseJsonValues.Add(Writer.GetJsonValuesWritten());
+}
+
+TSharedRef<FMCPJsonRpcServer::FJsonRpcBatch, ESPMode::ThreadSafe> FMCPJsonRpcServer::StartJsonRpcBatch(const TArray<FMCPJsonRpcEnvelope>& Entries)
+{
+	BatchRequests.Increment();
+	BatchEntries.Add(Entries.Num());
+
+	TSharedRef<FJsonRpcBatch, ESPMode::ThreadSafe> Batch = MakeShared<FJsonRpcBatch, ESPMode::ThreadSafe>();
+	Batch->Done = Batch->DonePromise.GetFuture();
+	Batch->Requests.SetNum(Entries.Num());
+	Batch->Responses.SetNum(Entries.Num());
+	Batch->Streamers.SetNum(Entries.Num());
+	Batch->Notifications.SetNum(Entries.Num());
+
+	TArray<int32> WorkerEntries;
+	TArray<int32> GameThreadEntries;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FMCPJsonRpcEnvelope& Entry = Entries[Index];
+		Batch->Notifications[Index] = Entry.IsNotification();
+		if (!Entry.bIsObject)
+		{
+			Batch->Responses[Index] = CreateErrorResponse(-32600, TEXT("Invalid Request"));
+			continue;
+		}
+
+		if (TSharedPtr<FJsonObject> RateLimitError = CheckRateLimit(Entry))
+		{
+			Batch->Responses[Index] = RateLimitError;
+			continue;
+		}
+
+		PrepareJsonRpcRequest(Entry, Batch->Requests[Index]);
+		(Batch->Requests[Index].RequiresGameThread() ? GameThreadEntries : WorkerEntries).Add(Index);
+	}
+
+	// Entries that need the editor go through the game-thread queue in request order, one call
+	// each, so a large batch is spread over frames within the budget instead of stalling one. Each
+	// call keeps its method's own timeout, watched from the reactor as for a single request.
+	Batch->Remaining.Set(GameThreadEntries.Num() + 1);
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index : GameThreadEntries)
+	{
+		FPreparedRequest& Prepared = Batch->Requests[Index];
+		const double TimeoutSeconds = GetGameThreadTimeout(*Prepared.Descriptor);
+		Batch->TimeoutSeconds = FMath::Max(Batch->TimeoutSeconds, TimeoutSeconds);
+
+		TMCPGameThreadCall<TSharedPtr<FJsonObject>> Call = CallOnGameThread<TSharedPtr<FJsonObject>>(MoveTemp(Prepared.Invoke), TimeoutSeconds);
+		Batch->Calls.Add(Call.State);
+		Reactor.AddTimer(Now + TimeoutSeconds, [State = Call.State]()
+		{
+			State->Cancel();
+		});
+
+		Call.Future.Then([this, Batch, Index](TFuture<TOptional<TSharedPtr<FJsonObject>>> Future)
+		{
+			const TOptional<TSharedPtr<FJsonObject>> Result = Future.Get();
+			if (!Result.IsSet())
+			{
+				GameThreadTimeouts.Increment();
+				LogMessage(TEXT("Game Thread batch execution timed out"));
+			}
+			Batch->Responses[Index] = CreateResultResponse(Result.IsSet() ? Result.GetValue() : nullptr, Batch->Requests[Index].Id);
+			Batch->Finish();
+		});
+	}
+
+	// Meanwhile, entries that do not touch the editor run one after another on this worker, so a
+	// batch never takes more threads than its connection was admitted with. Stream handlers may
+	// leave game-thread work queued; their entries count as outstanding until the streamer arrives.
+	for (int32 Index : WorkerEntries)
+	{
+		FPreparedRequest& Prepared = Batch->Requests[Index];
+		if (!Prepared.IsStreamed())
+		{
+			FMCPResultStreamer Unused;
+			Batch->Responses[Index] = RunPreparedRequest(Prepared, Unused);
+			continue;
+		}
+
+		Batch->TimeoutSeconds = FMath::Max(Batch->TimeoutSeconds, GetGameThreadTimeout(*Prepared.Descriptor));
+		Batch->Remaining.Increment();
+		Prepared.Stream().Then([this, Batch, Index](TFuture<FMCPResultStreamer> Future)
+		{
+			Batch->Streamers[Index] = Future.Get();
+			if (!Batch->Streamers[Index])
+			{
+				Batch->Responses[Index] = CreateResultResponse(nullptr, Batch->Requests[Index].Id);
+			}
+			Batch->Finish();
+		});
+	}
+	Batch->Finish();
+	return Batch;
+}
+
+int32 FMCPJsonRpcServer::WriteJsonRpcBatch(const FJsonRpcBatch& Batch, TArray<uint8>& Out)
+{
+	FMCPJsonWriter Writer(Out);
+	int64 StreamedJsonValues = 0;
+	int32 ResponseCount = 0;
+	for (int32 Index = 0; Index < Batch.Responses.Num(); ++Index)
+	{
+		if (Batch.Notifications[Index])
+		{
+			continue;
+		}
+		if (ResponseCount++ == 0)
+		{
+			Writer.WriteArrayStart();
+		}
+
+		const FMCPResultStreamer& Streamer = Batch.Streamers[Index];
+		if (Streamer)
+		{
+			// Counted by WriteStreamedJsonRpcResponse() itself
+			const int64 JsonValuesBefore = Writer.GetJsonValuesWritten();
+			WriteStreamedJsonRpcResponse(Writer, Streamer, Batch.Requests[Index].Id);
+			StreamedJsonValues += Writer.GetJsonValuesWritten() - JsonValuesBefore;
+			continue;
+		}
+		Writer.WriteValue(*Batch.Responses[Index]);
+	}
+	if (ResponseCount > 0)
+	{
+		Writer.WriteArrayEnd();
+	}
+	ResponseJsonValues.Add(Writer.GetJsonValuesWritten() - StreamedJsonValues);
+	return ResponseCount;
+}
+
+int32 FMCPJsonRpcServer::ProcessJsonRpcBatch(const TArray<FMCPJsonRpcEnvelope>& Entries, TArray<uint8>& Out)
+{
+	const TSharedRef<FJsonRpcBatch, ESPMode::ThreadSafe> Batch = StartJsonRpcBatch(Entries);
+
+	// The reactor cancels each call once its own timeout has passed, so the batch is normally done
+	// by then; this only gives up first when the server is forced to close
+	if (!WaitForGameThread(Batch->Done, Batch->TimeoutSeconds))
+	{
+		Batch->Cancel();
+
+		// A continuation that won the race against the cancel may still be storing its response
+		Batch->Done.Wait();
+	}
+	return WriteJsonRpcBatch(*Batch, Out);
+}
+
+void FMCPJsonRpcServer::WriteBatchResponse(FMCPHttpResponse& Response, TFunctionRef<int32(TArray<uint8>&)> WriteResponses, bool bKeepAlive, const FMCPHttpRequest& Request)
+{
+	const int32 OldBodyMax = Response.Body.Max();
+	const int32 ResponseCount = WriteResponses(Response.Body);
+
+	// A batch made only of notifications gets no response body at all
+	if (ResponseCount == 0)
+	{
+		CreateHttpResponse(Response, bKeepAlive, Request, 204);
+		return;
+	}
+
+	Response.BytesCopied += Response.Body.Num();
+	Response.Allocations += (Response.Body.Max() != OldBodyMax) ? 1 : 0;
+	CreateHttpResponse(Response, bKeepAlive, Request);
+}
+
+template<typename TParams>
+FMCPMethodDescriptor FMCPJsonRpcServer::MakeTypedMethod(const TCHAR* Name, TSharedPtr<FJsonObject> (FMCPJsonRpcServer::*Func)(const TParams&), EMCPMethodThreading Threading, EMCPMethodAccess Access, const TCHAR* Description)
+{
+	return FMCPMethodDescriptor::MakeTyped<TParams>(Name, [this, Func](const TParams& Params) { return (this->*Func)(Params); }, Threading, Access, Description);
+}
+
+template<typename TParams>
+FMCPMethodDescriptor FMCPJsonRpcServer::MakeTypedStreamMethod(const TCHAR* Name, TFuture<FMCPResultStreamer> (FMCPJsonRpcServer::*Func)(const TParams&), EMCPMethodThreading Threading, EMCPMethodAccess Access, const TCHAR* Description)
+{
+	return FMCPMethodDescriptor::MakeTypedStream<TParams>(Name, [this, Func](const TParams& Params) { return (this->*Func)(Params); }, Threading, Access, Description);
+}
+
+void FMCPJsonRpcServer::RegisterBuiltinMethods()
+{
+	typedef TSharedPtr<FJsonObject> (FMCPJsonRpcServer::*FHandlerFunc)(TSharedPtr<FJsonObject>);
+	auto Make = [this](const TCHAR* Name, FHandlerFunc Func, EMCPMethodThreading Threading, EMCPMethodAccess Access, const TCHAR* Description)
+	{
+		return FMCPMethodDescriptor(Name, [this, Func](TSharedPtr<FJsonObject> Params) { return (this->*Func)(Params); }, Threading, Access, Description);
+	};
+
+	const EMCPMethodThreading AnyThread = EMCPMethodThreading::AnyThread;
+	const EMCPMethodThreading GameThread = EMCPMethodThreading::GameThread;
+	const EMCPMethodAccess Read = EMCPMethodAccess::Read;
+	const EMCPMethodAccess Write = EMCPMethodAccess::Write;
+
+	// Creating assets and compiling Blueprints can take far longer than a lookup
+	auto WithTimeout = [](FMCPMethodDescriptor Descriptor, double TimeoutSeconds)
+	{
+		Descriptor.TimeoutSeconds = TimeoutSeconds;
+		return Descriptor;
+	};
+
+	FMCPMethodDescriptor ApplySettingsMethod = Make(TEXT("diagnostics.apply_settings"), &FMCPJsonRpcServer::HandleDiagnosticsApplySettings, GameThread, Write, TEXT("Apply transient server settings overrides"));
+	ApplySettingsMethod.bDiagnostic = true;
+
+	FMCPMethodDescriptor SyntheticAssets = MakeTypedStreamMethod(TEXT("diagnostics.synthetic_assets"), &FMCPJsonRpcServer::StreamDiagnosticsSyntheticAssets, AnyThread, Read, TEXT("Stream a resources.list-shaped result of synthetic assets"));
+	SyntheticAssets.bDiagnostic = true;
+
+	FMCPMethodDescriptor GameThreadWork = MakeTypedMethod(TEXT("diagnostics.game_thread_work"), &FMCPJsonRpcServer::HandleDiagnosticsGameThreadWork, GameThread, Read, TEXT("Busy the game thread for a given time, like an editor operation would"));
+	GameThreadWork.bDiagnostic = true;
+
+	// Cached results: a listing depends on its folder, an asset on its package, and the prompts on nothing
+	FMCPMethodDescriptor ResourcesList = MakeTypedStreamMethod(TEXT("resources.list"), &FMCPJsonRpcServer::StreamResourcesList, AnyThread, Read, TEXT("List assets under a content path"));
+	ResourcesList.CacheDependency = [](const void* Params)
+	{
+		FString SearchPath;
+		return NormalizeContentPath(static_cast<const FMCPResourcesListParams*>(Params)->Path, SearchPath) ? FName(*SearchPath) : NAME_None;
+	};
+
+	// Each operation is charged as the edit it stands for, so batching does not get around the
+	// mutation limit. Only the operations array is counted; the params are decoded later.
+	FMCPMethodDescriptor ToolsBatch = WithTimeout(MakeTypedMethod(TEXT("tools.batch"), &FMCPJsonRpcServer::HandleToolsBatch, GameThread, Write, TEXT("Apply tools.* edits as one undoable transaction, refreshing each Blueprint once")), EditorWriteTimeoutSeconds);
+	ToolsBatch.RateCost = [](FUtf8StringView Params) -> int32
+	{
+		static const char OperationsKey[] = "operations";
+		FMCPJsonReader Reader(Params);
+		FUtf8StringView Key;
+		if (Params.IsEmpty() || !Reader.BeginObject())
+		{
+			return 1;
+		}
+		while (Reader.NextMember(Key))
+		{
+			if (Key.Len() != UE_ARRAY_COUNT(OperationsKey) - 1 || FMemory::Memcmp(Key.GetData(), OperationsKey, Key.Len()) != 0 || Reader.Peek() != EMCPJsonToken::Array)
+			{
+				Reader.SkipValue();
+				continue;
+			}
+			int32 Operations = 0;
+			Reader.BeginArray();
+			while (Reader.NextElement() && Reader.SkipValue())
+			{
+				++Operations;
+			}
+			return FMath::Max(Operations, 1);
+		}
+		return 1;
+	};
+
+	// Looked up on the worker too. Loading a Blueprint is queued for the game thread by
+	// StreamResourcesGet, and the request is parked until it is done, as for GameThread methods.
+	FMCPMethodDescriptor ResourcesGet = MakeTypedStreamMethod(TEXT("resources.get"), &FMCPJsonRpcServer::StreamResourcesGet, AnyThread, Read, TEXT("Get details of one asset"));
+	ResourcesGet.CacheDependency = [](const void* Params)
+	{
+		return FName(*FSoftObjectPath(static_cast<const FMCPResourcesGetParams*>(Params)->AssetPath).GetLongPackageName());
+	};
+
+	FMCPMethodDescriptor PromptsList = Make(TEXT("prompts.list"), &FMCPJsonRpcServer::HandlePromptsList, AnyThread, Read, TEXT("List the built-in prompts"));
+	PromptsList.CacheDependency = [](const void*) { return FName(); };
+
+	FMCPMethodDescriptor PromptsGet = MakeTypedMethod(TEXT("prompts.get"), &FMCPJsonRpcServer::HandlePromptsGet, AnyThread, Read, TEXT("Get one prompt with its arguments filled in"));
+	PromptsGet.CacheDependency = [](const void*) { return FName(); };
+
+	const FMCPMethodDescriptor Methods[] = {
+		Make(TEXT("ping"), &FMCPJsonRpcServer::HandlePing, AnyThread, Read, TEXT("Check that the server is up")),
+		Make(TEXT("getBlueprints"), &FMCPJsonRpcServer::HandleGetBlueprints, AnyThread, Read, TEXT("List Blueprint assets")),
+		Make(TEXT("getActors"), &FMCPJsonRpcServer::HandleGetActors, AnyThread, Read, TEXT("List actors in the editor world")),
+		ResourcesList,
+		ResourcesGet,
+		WithTimeout(MakeTypedMethod(TEXT("resources.create"), &FMCPJsonRpcServer::HandleResourcesCreate, GameThread, Write, TEXT("Create a new asset")), EditorWriteTimeoutSeconds),
+		WithTimeout(MakeTypedMethod(TEXT("tools.create_blueprint"), &FMCPJsonRpcServer::HandleToolsCreateBlueprint, GameThread, Write, TEXT("Create a Blueprint class")), EditorWriteTimeoutSeconds),
+		WithTimeout(MakeTypedMethod(TEXT("tools.add_variable"), &FMCPJsonRpcServer::HandleToolsAddVariable, GameThread, Write, TEXT("Add a member variable to a Blueprint")), EditorWriteTimeoutSeconds),
+		WithTimeout(MakeTypedMethod(TEXT("tools.add_function"), &FMCPJsonRpcServer::HandleToolsAddFunction, GameThread, Write, TEXT("Add a function graph to a Blueprint")), EditorWriteTimeoutSeconds),
+		WithTimeout(MakeTypedMethod(TEXT("tools.edit_graph"), &FMCPJsonRpcServer::HandleToolsEditGraph, GameThread, Write, TEXT("Add nodes to a Blueprint graph")), EditorWriteTimeoutSeconds),
+		ToolsBatch,
+		PromptsList,
+		PromptsGet,
+		Make(TEXT("server.stats"), &FMCPJsonRpcServer::HandleServerStats, AnyThread, Read, TEXT("Server counters")),
+		Make(TEXT("server.methods"), &FMCPJsonRpcServer::HandleServerMethods, AnyThread, Read, TEXT("List the methods this server serves")),
+		ApplySettingsMethod,
+		SyntheticAssets,
+		GameThreadWork
+	};
+
+	FMCPMethodRegistry& Registry = FMCPMethodRegistry::Get();
+	for (const FMCPMethodDescriptor& Method : Methods)
+	{
+		Registry.RegisterMethod(Method, this);
+	}
+}
+
+FMCPMethodRegistry::FDescriptorPtr FMCPJsonRpcServer::FindMethod(const FString& Method) const
+{
+	FMCPMethodRegistry::FDescriptorPtr Descriptor = FMCPMethodRegistry::Get().FindMethod(Method);
+	if (Descriptor.IsValid() && Descriptor->bDiagnostic && !GetConfig()->bEnableDiagnostics)
+	{
+		return nullptr;
+	}
+	return Descriptor;
+}
+
+EMCPJsonRpcBody FMCPJsonRpcServer::ReadJsonRpcBody(TArrayView<const uint8> Body, FMCPJsonRpcEnvelope& OutRequest, TArray<FMCPJsonRpcEnvelope>& OutBatch)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	FString ParseError;
+	const EMCPJsonRpcBody BodyKind = FMCPJsonRpcEnvelope::ReadBody(
+		FUtf8StringView((const UTF8CHAR*)Body.GetData(), Body.Num()), OutRequest, OutBatch, ParseError);
+	RequestParseCycles.Add(FPlatformTime::Cycles64() - StartCycles);
+	RequestsParsed.Increment();
+	RequestBytesParsed.Add(Body.Num());
+
+	// Ids are the only values the envelope builds
+	int64 JsonValues = OutRequest.Id.IsValid() ? 1 : 0;
+	for (const FMCPJsonRpcEnvelope& Entry : OutBatch)
+	{
+		JsonValues += Entry.Id.IsValid() ? 1 : 0;
+	}
+	RequestJsonValues.Add(JsonValues);
+
+	if (BodyKind == EMCPJsonRpcBody::Malformed)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("MCP Server: Malformed request body: %s"), *ParseError);
+	}
+	return BodyKind;
+}
+
+namespace MCPJsonRpcServer
+{
+	static int64 CountJsonValues(const FJsonObject& Object);
+
+	static int64 CountJsonValues(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return 0;
+		}
+		int64 Count = 1;
+		if (Value->Type == EJson::Object && Value->AsObject().IsValid())
+		{
+			Count += CountJsonValues(*Value->AsObject());
+		}
+		else if (Value->Type == EJson::Array)
+		{
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				Count += CountJsonValues(Element);
+			}
+		}
+		return Count;
+	}
+
+	static int64 CountJsonValues(const FJsonObject& Object)
+	{
+		int64 Count = 0;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Member : Object.Values)
+		{
+			Count += CountJsonValues(Member.Value);
+		}
+		return Count;
+	}
+
+	/** Percentiles of Histogram, and its non-empty buckets as [upper bound in ms, samples] pairs */
+	static TSharedPtr<FJsonObject> HistogramToJson(const FMCPLatencyHistogramSnapshot& Histogram)
+	{
+		TSharedPtr<FJsonObject> Json = MakeShareable(new FJsonObject);
+		Json->SetNumberField(TEXT("count"), Histogram.Count);
+		Json->SetNumberField(TEXT("mean"), Histogram.GetMeanMs());
+		Json->SetNumberField(TEXT("p50"), Histogram.GetPercentileMs(0.50));
+		Json->SetNumberField(TEXT("p90"), Histogram.GetPercentileMs(0.90));
+		Json->SetNumberField(TEXT("p99"), Histogram.GetPercentileMs(0.99));
+		Json->SetNumberField(TEXT("max"), Histogram.MaxMs);
+
+		TArray<TSharedPtr<FJsonValue>> Buckets;
+		for (int32 Index = 0; Index < Histogram.Buckets.Num(); ++Index)
+		{
+			if (Histogram.Buckets[Index] > 0)
+			{
+				TArray<TSharedPtr<FJsonValue>> Bucket;
+				Bucket.Add(MakeShareable(new FJsonValueNumber(FMCPLatencyHistogramSnapshot::GetBucketUpperMs(Index))));
+				Bucket.Add(MakeShareable(new FJsonValueNumber((double)Histogram.Buckets[Index])));
+				Buckets.Add(MakeShareable(new FJsonValueArray(Bucket)));
+			}
+		}
+		Json->SetArrayField(TEXT("buckets"), Buckets);
+		return Json;
+	}
+
+	/** Result of a tools.* method whose Blueprint does not load */
+	static TSharedPtr<FJsonObject> BlueprintNotFound(const FString& BlueprintPath)
+	{
+		TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
+		return Result;
+	}
+
+	/** Decode the params of one tools.batch operation as the method it names would on its own */
+	template<typename TParams>
+	static bool DecodeOperationParams(const FMCPToolOperationParams& Operation, TParams& Out, FString& OutError)
+	{
+		const FTCHARToUTF8 Params(*Operation.Params, Operation.Params.Len());
+		return FMCPParamsBinding::Decode(FUtf8StringView((const UTF8CHAR*)Params.Get(), Params.Length()), Out, OutError);
+	}
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::ReadParamsObject(FUtf8StringView Params)
+{
+	if (Params.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	TSharedPtr<FJsonObject> Object;
+	TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(Params);
+	FJsonSerializer::Deserialize(Reader, Object);
+	RequestParseCycles.Add(FPlatformTime::Cycles64() - StartCycles);
+	RequestJsonValues.Add(Object.IsValid() ? 1 + MCPJsonRpcServer::CountJsonValues(*Object) : 0);
+	return Object;
+}
+
+void FMCPJsonRpcServer::PrepareJsonRpcRequest(const FMCPJsonRpcEnvelope& Request, FPreparedRequest& Out)
+{
+	Out.Id = Request.Id;
+
+	if (!Request.bIsObject)
+	{
+		Out.ErrorResponse = CreateErrorResponse(-32600, TEXT("Invalid Request"));
+		return;
+	}
+
+	// Check JSON-RPC version
+	if (!Request.bVersion2)
+	{
+		Out.ErrorResponse = CreateErrorResponse(-32600, TEXT("Invalid Request - jsonrpc field must be '2.0'"), Request.Id);
+		return;
+	}
+
+	// Get method name
+	if (!Request.bHasMethod)
+	{
+		Out.ErrorResponse = CreateErrorResponse(-32600, TEXT("Invalid Request - missing method"), Request.Id);
+		return;
+	}
+
+	FMCPMethodRegistry::FDescriptorPtr Descriptor = FindMethod(Request.Method);
+	if (!Descriptor.IsValid())
+	{
+		Out.ErrorResponse = CreateErrorResponse(-32601, TEXT("Method not found"), Request.Id);
+		return;
+	}
+
+	// Params are named, never positional
+	if (!Request.Params.IsEmpty() && Request.Params[0] != '{')
+	{
+		Out.ErrorResponse = CreateErrorResponse(-32602, TEXT("Invalid params - params must be an object"), Request.Id);
+		return;
+	}
+
+	// Params are decoded only now that the method is known, and only into the form its handler
+	// takes: typed handlers get their struct filled straight from the request text
+	TSharedPtr<FStructOnScope> TypedParams;
+	if (Descriptor->ParamsStruct)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		TypedParams = MakeShared<FStructOnScope>(Descriptor->ParamsStruct);
+		FString ParamsError;
+		const bool bDecoded = FMCPParamsBinding::Decode(Descriptor->ParamsStruct, TypedParams->GetStructMemory(), Request.Params, ParamsError);
+		RequestParseCycles.Add(FPlatformTime::Cycles64() - StartCycles);
+		if (!bDecoded)
+		{
+			Out.ErrorResponse = CreateErrorResponse(-32602, ParamsError, Request.Id);
+			return;
+		}
+		if (Descriptor->TypedStreamHandler)
+		{
+			Out.Stream = [Descriptor, TypedParams]() { return Descriptor->TypedStreamHandler(TypedParams->GetStructMemory()); };
+		}
+		else
+		{
+			Out.Invoke = [Descriptor, TypedParams]() { return Descriptor->TypedHandler(TypedParams->GetStructMemory()); };
+		}
+	}
+	else
+	{
+		TSharedPtr<FJsonObject> Params = ReadParamsObject(Request.Params);
+		if (Descriptor->StreamHandler)
+		{
+			Out.Stream = [Descriptor, Params]() { return Descriptor->StreamHandler(Params); };
+		}
+		else
+		{
+			Out.Invoke = [Descriptor, Params]() { return Descriptor->Handler(Params); };
+		}
+	}
+	Out.Descriptor = Descriptor;
+
+	if (Descriptor->CacheDependency && ResultCache.IsEnabled())
+	{
+		PrepareCachedRequest(Request, TypedParams.IsValid() ? TypedParams->GetStructMemory() : nullptr, Out);
+	}
+}
+
+void FMCPJsonRpcServer::PrepareCachedRequest(const FMCPJsonRpcEnvelope& Request, const void* TypedParams, FPreparedRequest& Out)
+{
+	const FMCPMethodDescriptor& Descriptor = *Out.Descriptor;
+
+	// Decoded params export with defaults filled in and members in declaration order, so requests
+	// that spell the same params differently share an entry
+	FString Key = Descriptor.Name.ToString();
+	Key.AppendChar(TEXT('|'));
+	if (TypedParams)
+	{
+		Descriptor.ParamsStruct->ExportText(Key, TypedParams, nullptr, nullptr, PPF_None, nullptr);
+	}
+	else
+	{
+		const FUTF8ToTCHAR Params((const ANSICHAR*)Request.Params.GetData(), Request.Params.Len());
+		Key.Append(Params.Get(), Params.Length());
+	}
+	const FName Dependency = Descriptor.CacheDependency(TypedParams);
+
+	const double TimeoutSeconds = GetGameThreadTimeout(Descriptor);
+	const bool bGameThread = Descriptor.Threading == EMCPMethodThreading::GameThread;
+	TFunction<TFuture<FMCPResultStreamer>()> Stream = MoveTemp(Out.Stream);
+	TFunction<TSharedPtr<FJsonObject>()> Invoke = MoveTemp(Out.Invoke);
+	Out.Stream = [this, Key = MoveTemp(Key), Dependency, Stream = MoveTemp(Stream), Invoke = MoveTemp(Invoke), bGameThread, TimeoutSeconds]() -> TFuture<FMCPResultStreamer>
+	{
+		const FMCPResultCache::FResultPtr Cached = ResultCache.Find(Key);
+		if (Cached.IsValid())
+		{
+			return MakeFulfilledPromise<FMCPResultStreamer>([Cached](FMCPJsonWriter& ResponseWriter)
+			{
+				ResponseWriter.WriteRawValue(FUtf8StringView((const UTF8CHAR*)Cached->GetData(), Cached->Num()));
+			}).GetFuture();
+		}
+
+		// Taken before the handler reads anything, so a change while it runs keeps the result out of the cache
+		const uint64 FillGeneration = ResultCache.GetGeneration();
+
+		// The result is rendered and kept as the response is written, so that happens on a worker
+		// even when the handler finished on the game thread
+		auto Fill = [this, Key, Dependency, FillGeneration](const FMCPResultStreamer& Streamer) -> FMCPResultStreamer
+		{
+			if (!Streamer)
+			{
+				return FMCPResultStreamer();
+			}
+			return [this, Key, Dependency, FillGeneration, Streamer](FMCPJsonWriter& ResponseWriter)
+			{
+				TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Rendered = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+				FMCPJsonWriter Writer(*Rendered);
+				Streamer(Writer);
+				ResponseJsonValues.Add(Writer.GetJsonValuesWritten());
+				ResultCache.Store(Key, Dependency, Rendered, FillGeneration);
+				ResponseWriter.WriteRawValue(FUtf8StringView((const UTF8CHAR*)Rendered->GetData(), Rendered->Num()));
+			};
+		};
+		auto FromObject = [](TSharedPtr<FJsonObject> Object) -> FMCPResultStreamer
+		{
+			if (!Object.IsValid())
+			{
+				return FMCPResultStreamer();
+			}
+			return [Object](FMCPJsonWriter& Writer)
+			{
+				Writer.WriteValue(*Object);
+			};
+		};
+
+		if (Stream)
+		{
+			return Stream().Then([Fill](TFuture<FMCPResultStreamer> Future)
+			{
+				return Fill(Future.Get());
+			});
+		}
+		if (!bGameThread)
+		{
+			return MakeFulfilledPromise<FMCPResultStreamer>(Fill(FromObject(Invoke()))).GetFuture();
+		}
+
+		// Game-thread methods are queued without this worker waiting, like an uncached request
+		return QueueOnGameThread<TSharedPtr<FJsonObject>>(TUniqueFunction<TSharedPtr<FJsonObject>()>(Invoke), TimeoutSeconds).Then(
+			[Fill, FromObject](TFuture<TOptional<TSharedPtr<FJsonObject>>> Future)
+			{
+				const TOptional<TSharedPtr<FJsonObject>>& Object = Future.Get();
+				return Fill(FromObject(Object.IsSet() ? Object.GetValue() : nullptr));
+			});
+	};
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::RunPreparedRequest(const FPreparedRequest& Prepared, FMCPResultStreamer& OutStreamer)
+{
+	if (Prepared.ErrorResponse.IsValid())
+	{
+		return Prepared.ErrorResponse;
+	}
+
+	// Stream handlers queue their own game-thread work, with their own deadlines; the caller writes the result
+	if (Prepared.Stream)
+	{
+		const TFuture<FMCPResultStreamer> PendingStreamer = Prepared.Stream();
+		if (PendingStreamer.IsReady() || WaitForGameThread(PendingStreamer, GetGameThreadTimeout(*Prepared.Descriptor)))
+		{
+			OutStreamer = PendingStreamer.Get();
+		}
+		return OutStreamer ? nullptr : CreateResultResponse(nullptr, Prepared.Id);
+	}
+
+	const TSharedPtr<FJsonObject> Result = Prepared.RequiresGameThread()
+		? ExecuteOnGameThread<TSharedPtr<FJsonObject>>(Prepared.Invoke, GetGameThreadTimeout(*Prepared.Descriptor))
+		: Prepared.Invoke();
+	return CreateResultResponse(Result, Prepared.Id);
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::CreateResultResponse(TSharedPtr<FJsonObject> Result, TSharedPtr<FJsonValue> Id)
+{
+	if (!Result.IsValid())
+	{
+		return CreateErrorResponse(-32603, TEXT("Internal error - game thread execution timed out or failed"), Id);
+	}
+
+	// Create success response
+	TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject);
+	Response->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+	Response->SetObjectField(TEXT("result"), Result);
+	if (Id.IsValid())
+	{
+		Response->SetField(TEXT("id"), Id);
+	}
+
+	return Response;
+}
+
+double FMCPJsonRpcServer::GetGameThreadTimeout(const FMCPMethodDescriptor& Descriptor)
+{
+	return Descriptor.TimeoutSeconds > 0.0 ? Descriptor.TimeoutSeconds : DefaultGameThreadTimeoutSeconds;
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::ProcessJsonRpcRequest(const FMCPJsonRpcEnvelope& Request, FMCPResultStreamer& OutStreamer)
+{
+	FPreparedRequest Prepared;
+	PrepareJsonRpcRequest(Request, Prepared);
+	return RunPreparedRequest(Prepared, OutStreamer);
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandlePing(TSharedPtr<FJsonObject> Params)
+{
 	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
 	Result->SetStringField(TEXT("status"), TEXT("pong"));
 	Result->SetStringField(TEXT("server"), TEXT("UnrealBlueprintMCP"));
@@ -455,6 +2112,161 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandlePing(TSharedPtr<FJsonObject> Pa
 	return Result;
 }
 
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleServerStats(TSharedPtr<FJsonObject> Params)
+{
+	const FMCPServerStats Stats = GetServerStats();
+
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+	Result->SetNumberField(TEXT("active_connections"), Stats.ActiveConnections);
+	Result->SetNumberField(TEXT("connections_accepted"), Stats.ConnectionsAccepted);
+	Result->SetNumberField(TEXT("local_connections_accepted"), Stats.LocalConnectionsAccepted);
+	Result->SetStringField(TEXT("local_socket_path"), GetLocalSocketPath());
+	Result->SetNumberField(TEXT("requests_served"), Stats.RequestsServed);
+	Result->SetNumberField(TEXT("reused_connection_requests"), Stats.ReusedConnectionRequests);
+	Result->SetNumberField(TEXT("connection_reuse_ratio"), Stats.GetConnectionReuseRatio());
+	Result->SetNumberField(TEXT("rejected_connections"), Stats.RejectedConnections);
+	Result->SetNumberField(TEXT("responses_sent"), Stats.ResponsesSent);
+	Result->SetNumberField(TEXT("response_bytes_sent"), Stats.ResponseBytesSent);
+	Result->SetNumberField(TEXT("bytes_copied_per_response"), Stats.GetBytesCopiedPerResponse());
+	Result->SetNumberField(TEXT("allocations_per_response"), Stats.GetAllocationsPerResponse());
+	Result->SetNumberField(TEXT("streamed_responses"), Stats.StreamedResponses);
+	Result->SetNumberField(TEXT("streamed_body_bytes"), Stats.StreamedBodyBytes);
+	Result->SetNumberField(TEXT("compressed_responses"), Stats.CompressedResponses);
+	Result->SetNumberField(TEXT("compression_input_bytes"), Stats.CompressionInputBytes);
+	Result->SetNumberField(TEXT("compression_output_bytes"), Stats.CompressionOutputBytes);
+	Result->SetNumberField(TEXT("compression_ratio"), Stats.GetCompressionRatio());
+	Result->SetNumberField(TEXT("compression_ms_per_response"), Stats.GetCompressionMsPerResponse());
+	Result->SetNumberField(TEXT("batch_requests"), Stats.BatchRequests);
+	Result->SetNumberField(TEXT("batch_entries"), Stats.BatchEntries);
+	Result->SetNumberField(TEXT("tool_batch_operations"), Stats.ToolBatchOperations);
+	Result->SetNumberField(TEXT("tool_batch_rollbacks"), Stats.ToolBatchRollbacks);
+	Result->SetNumberField(TEXT("registry_worker_reads"), Stats.RegistryWorkerReads);
+	Result->SetNumberField(TEXT("registry_game_thread_reads"), Stats.RegistryGameThreadReads);
+	Result->SetNumberField(TEXT("requests_parsed"), Stats.RequestsParsed);
+	Result->SetNumberField(TEXT("request_bytes_parsed"), Stats.RequestBytesParsed);
+	Result->SetNumberField(TEXT("request_parse_ms_per_request"), Stats.GetParseMsPerRequest());
+	Result->SetNumberField(TEXT("request_json_values_per_request"), Stats.GetJsonValuesPerRequest());
+	Result->SetNumberField(TEXT("response_json_values_per_request"), Stats.GetResponseJsonValuesPerRequest());
+	Result->SetNumberField(TEXT("rate_limit"), GetConfig()->RequestRateLimit);
+	Result->SetNumberField(TEXT("rate_limit_hits"), Stats.RateLimitHits);
+	Result->SetNumberField(TEXT("rate_limit_rejects"), Stats.RateLimitRejects);
+	Result->SetNumberField(TEXT("last_drain_ms"), Stats.LastDrainSeconds * 1000.0);
+	Result->SetNumberField(TEXT("drain_timeouts"), Stats.DrainTimeouts);
+	Result->SetNumberField(TEXT("websocket_sessions"), Stats.ActiveWebSocketSessions);
+	Result->SetNumberField(TEXT("websocket_sessions_opened"), Stats.WebSocketSessionsOpened);
+	Result->SetNumberField(TEXT("websocket_messages_received"), Stats.WebSocketMessagesReceived);
+	Result->SetNumberField(TEXT("notifications_sent"), Stats.NotificationsSent);
+
+	// Process memory, so clients can observe peak usage across large responses
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Result->SetNumberField(TEXT("process_used_physical_bytes"), (double)MemoryStats.UsedPhysical);
+	Result->SetNumberField(TEXT("process_peak_used_physical_bytes"), (double)MemoryStats.PeakUsedPhysical);
+
+	TSharedPtr<FJsonObject> PoolJson = MakeShareable(new FJsonObject);
+	PoolJson->SetNumberField(TEXT("workers"), Stats.WorkerPool.NumWorkers);
+	PoolJson->SetNumberField(TEXT("queue_capacity"), Stats.WorkerPool.QueueCapacity);
+	PoolJson->SetNumberField(TEXT("active_workers"), Stats.WorkerPool.ActiveWorkers);
+	PoolJson->SetNumberField(TEXT("queue_depth"), Stats.WorkerPool.QueueDepth);
+	PoolJson->SetNumberField(TEXT("peak_queue_depth"), Stats.WorkerPool.PeakQueueDepth);
+	PoolJson->SetNumberField(TEXT("completed"), Stats.WorkerPool.CompletedItems);
+	PoolJson->SetNumberField(TEXT("rejected"), Stats.WorkerPool.RejectedItems);
+	PoolJson->SetNumberField(TEXT("utilization"), Stats.WorkerPool.Utilization);
+	Result->SetObjectField(TEXT("worker_pool"), PoolJson);
+
+	TSharedPtr<FJsonObject> ReactorJson = MakeShareable(new FJsonObject);
+	ReactorJson->SetNumberField(TEXT("parked_connections"), Stats.Reactor.ParkedConnections);
+	ReactorJson->SetNumberField(TEXT("idle_timeouts"), Stats.Reactor.IdleTimeouts);
+	ReactorJson->SetNumberField(TEXT("read_timeouts"), Stats.Reactor.ReadTimeouts);
+	ReactorJson->SetNumberField(TEXT("write_timeouts"), Stats.Reactor.WriteTimeouts);
+	Result->SetObjectField(TEXT("reactor"), ReactorJson);
+
+	TSharedPtr<FJsonObject> CacheJson = MakeShareable(new FJsonObject);
+	CacheJson->SetNumberField(TEXT("budget_bytes"), Stats.ResultCache.BudgetBytes);
+	CacheJson->SetNumberField(TEXT("bytes_held"), Stats.ResultCache.BytesHeld);
+	CacheJson->SetNumberField(TEXT("entries"), Stats.ResultCache.Entries);
+	CacheJson->SetNumberField(TEXT("hits"), Stats.ResultCache.Hits);
+	CacheJson->SetNumberField(TEXT("misses"), Stats.ResultCache.Misses);
+	CacheJson->SetNumberField(TEXT("hit_rate"), Stats.ResultCache.GetHitRate());
+	CacheJson->SetNumberField(TEXT("evictions"), Stats.ResultCache.Evictions);
+	CacheJson->SetNumberField(TEXT("invalidations"), Stats.ResultCache.Invalidations);
+	Result->SetObjectField(TEXT("result_cache"), CacheJson);
+
+	TSharedPtr<FJsonObject> GameThreadJson = MakeShareable(new FJsonObject);
+	GameThreadJson->SetNumberField(TEXT("budget_ms"), Stats.GameThread.BudgetMs);
+	GameThreadJson->SetNumberField(TEXT("queue_depth"), Stats.GameThread.QueueDepth);
+	GameThreadJson->SetNumberField(TEXT("peak_queue_depth"), Stats.GameThread.PeakQueueDepth);
+	GameThreadJson->SetNumberField(TEXT("tasks_executed"), Stats.GameThread.TasksExecuted);
+	GameThreadJson->SetNumberField(TEXT("drains"), Stats.GameThread.Drains);
+	GameThreadJson->SetNumberField(TEXT("max_tasks_per_drain"), Stats.GameThread.MaxTasksPerDrain);
+	GameThreadJson->SetNumberField(TEXT("over_budget_drains"), Stats.GameThread.OverBudgetDrains);
+	GameThreadJson->SetNumberField(TEXT("skipped_calls"), Stats.GameThread.SkippedCalls);
+	GameThreadJson->SetNumberField(TEXT("deferred_requests"), Stats.DeferredRequests);
+	GameThreadJson->SetNumberField(TEXT("timeouts"), Stats.GameThreadTimeouts);
+	GameThreadJson->SetObjectField(TEXT("queue_wait_ms"), MCPJsonRpcServer::HistogramToJson(Stats.GameThread.QueueWait));
+	GameThreadJson->SetObjectField(TEXT("execute_ms"), MCPJsonRpcServer::HistogramToJson(Stats.GameThread.Execute));
+	GameThreadJson->SetObjectField(TEXT("drain_ms"), MCPJsonRpcServer::HistogramToJson(Stats.GameThread.DrainTime));
+	GameThreadJson->SetObjectField(TEXT("frame_ms"), MCPJsonRpcServer::HistogramToJson(Stats.GameThread.FrameTime));
+	Result->SetObjectField(TEXT("game_thread"), GameThreadJson);
+
+	TSharedPtr<FJsonObject> RefreshJson = MakeShareable(new FJsonObject);
+	RefreshJson->SetNumberField(TEXT("delay_ms"), Stats.BlueprintRefresh.DelayMs);
+	RefreshJson->SetNumberField(TEXT("pending"), Stats.BlueprintRefresh.Pending);
+	RefreshJson->SetNumberField(TEXT("edits"), Stats.BlueprintRefresh.Edits);
+	RefreshJson->SetNumberField(TEXT("refreshes"), Stats.BlueprintRefresh.Refreshes);
+	RefreshJson->SetNumberField(TEXT("coalesced"), Stats.BlueprintRefresh.Coalesced);
+	RefreshJson->SetNumberField(TEXT("compiles"), Stats.BlueprintRefresh.Compiles);
+	RefreshJson->SetNumberField(TEXT("compile_passes"), Stats.BlueprintRefresh.CompilePasses);
+	RefreshJson->SetNumberField(TEXT("forced_flushes"), Stats.BlueprintRefresh.ForcedFlushes);
+	Result->SetObjectField(TEXT("blueprint_refresh"), RefreshJson);
+	return Result;
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleServerMethods(TSharedPtr<FJsonObject> Params)
+{
+	const bool bEnableDiagnostics = GetConfig()->bEnableDiagnostics;
+
+	TArray<TSharedPtr<FJsonValue>> Methods;
+	for (const FMCPMethodRegistry::FDescriptorRef& Descriptor : FMCPMethodRegistry::Get().GetMethods())
+	{
+		if (Descriptor->bDiagnostic && !bEnableDiagnostics)
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> MethodJson = MakeShareable(new FJsonObject);
+		MethodJson->SetStringField(TEXT("name"), Descriptor->Name.ToString());
+		MethodJson->SetStringField(TEXT("description"), Descriptor->Description);
+		MethodJson->SetStringField(TEXT("threading"), FMCPMethodRegistry::LexThreading(Descriptor->Threading));
+		MethodJson->SetStringField(TEXT("access"), FMCPMethodRegistry::LexAccess(Descriptor->Access));
+		if (Descriptor->Threading == EMCPMethodThreading::GameThread)
+		{
+			MethodJson->SetNumberField(TEXT("timeout_seconds"), GetGameThreadTimeout(*Descriptor));
+		}
+		MethodJson->SetBoolField(TEXT("streaming"), Descriptor->IsStreamed());
+		MethodJson->SetBoolField(TEXT("cached"), (bool)Descriptor->CacheDependency);
+		MethodJson->SetBoolField(TEXT("batchable"), Descriptor->HasHandler());
+		if (Descriptor->ParamsStruct)
+		{
+			TArray<TSharedPtr<FJsonValue>> Required;
+			TArray<TSharedPtr<FJsonValue>> Optional;
+			for (const FMCPParamsBinding::FFieldInfo& Field : FMCPParamsBinding::DescribeFields(Descriptor->ParamsStruct))
+			{
+				(Field.bRequired ? Required : Optional).Add(MakeShareable(new FJsonValueString(Field.JsonName)));
+			}
+			TSharedPtr<FJsonObject> ParamsJson = MakeShareable(new FJsonObject);
+			ParamsJson->SetArrayField(TEXT("required"), Required);
+			ParamsJson->SetArrayField(TEXT("optional"), Optional);
+			MethodJson->SetObjectField(TEXT("params"), ParamsJson);
+		}
+		Methods.Add(MakeShareable(new FJsonValueObject(MethodJson)));
+	}
+
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+	Result->SetArrayField(TEXT("methods"), Methods);
+	Result->SetNumberField(TEXT("count"), Methods.Num());
+	return Result;
+}
+
 TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleGetBlueprints(TSharedPtr<FJsonObject> Params)
 {
 	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
@@ -495,48 +2307,234 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleGetActors(TSharedPtr<FJsonObjec
 	return Result;
 }
 
-FString FMCPJsonRpcServer::CreateHttpResponse(const FString& Content, const FString& ContentType)
+void FMCPJsonRpcServer::CreateHttpResponse(FMCPHttpResponse& Response, bool bKeepAlive, const FMCPHttpRequest& Request, int32 StatusCode)
 {
-	FString Response = TEXT("HTTP/1.1 200 OK\r\n");
-	Response += FString::Printf(TEXT("Content-Type: %s\r\n"), *ContentType);
-	Response += FString::Printf(TEXT("Content-Length: %d\r\n"), Content.Len());
-	
-	// Apply CORS headers if enabled in settings
-	if (bAppliedEnableCORS)
+	// Everything except framing and the matched origin was formatted when settings were applied
+	const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> ResponseConfig = GetConfig();
+	const TSharedRef<const FMCPHttpHeaderBlock, ESPMode::ThreadSafe>& Block = ResponseConfig->HeaderBlock;
+	const FString* Origin = Request.FindHeader(TEXT("origin"));
+
+	CompressHttpResponse(Response, Request, *ResponseConfig);
+
+	Response.BeginHeaders(StatusCode);
+	if (StatusCode != 204)
 	{
-		const UMCPServerSettings* Settings = UMCPServerSettings::Get();
-		if (Settings && Settings->AllowedOrigins.Num() > 0)
+		Response.AddHeader("Content-Type", "application/json");
+		if (!Response.ContentEncoding.IsNone())
+		{
+			Response.AddHeader("Content-Encoding", FMCPHttpResponse::GetContentEncodingToken(Response.ContentEncoding));
+		}
+		if (Response.IsStreamed())
 		{
-			// Use specific allowed origins
-			FString AllowedOriginsHeader = FString::Join(Settings->AllowedOrigins, TEXT(", "));
-			Response += FString::Printf(TEXT("Access-Control-Allow-Origin: %s\r\n"), *AllowedOriginsHeader);
+			Response.AddHeader("Transfer-Encoding", "chunked");
 		}
 		else
 		{
-			// Allow all origins (less secure, but useful for development)
-			Response += TEXT("Access-Control-Allow-Origin: *\r\n");
+			Response.AddHeader("Content-Length", (int64)Response.Body.Num());
 		}
-		Response += TEXT("Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n");
-		Response += TEXT("Access-Control-Allow-Headers: Content-Type, Authorization\r\n");
-		Response += TEXT("Access-Control-Max-Age: 86400\r\n");
 	}
-	
-	// Apply custom headers from settings
-	for (const auto& Header : AppliedCustomHeaders)
+
+	const TArray<uint8>& ConnectionLines = bKeepAlive ? Block->KeepAliveLines : Block->CloseLines;
+	Response.AddRawHeaders(ConnectionLines.GetData(), ConnectionLines.Num());
+
+	// Echo a single allowed origin; the response differs per Origin, so caches must key on it
+	if (Block->bEnableCORS && !Block->bAllowAnyOrigin)
 	{
-		Response += FString::Printf(TEXT("%s: %s\r\n"), *Header.Key, *Header.Value);
+		if (Origin && Block->IsOriginAllowed(*Origin))
+		{
+			Response.AddHeader("Access-Control-Allow-Origin", *Origin);
+		}
+		Response.AddHeader("Vary", "Origin");
 	}
-	
-	// Security headers (always applied)
-	Response += TEXT("X-Content-Type-Options: nosniff\r\n"); // Security header to prevent MIME type sniffing
-	if (!bAppliedEnableCORS)
+
+	Response.AddRawHeaders(Block->StaticLines.GetData(), Block->StaticLines.Num());
+	Response.FinishHeaders();
+}
+
+void FMCPJsonRpcServer::CompressHttpResponse(FMCPHttpResponse& Response, const FMCPHttpRequest& Request, const FMCPServerConfig& ResponseConfig)
+{
+	// Streamed bodies stay identity-encoded: FCompression only works on whole buffers
+	if (!ResponseConfig.bCompression || Response.IsStreamed() || Response.Body.Num() < ResponseConfig.CompressionMinBytes)
 	{
-		Response += TEXT("X-Frame-Options: DENY\r\n"); // Prevent iframe embedding (unless CORS is enabled)
+		return;
 	}
-	
-	Response += TEXT("\r\n");
-	Response += Content;
-	return Response;
+
+	const FName Encoding = FMCPHttpResponse::NegotiateContentEncoding(Request.FindHeader(TEXT("accept-encoding")));
+	if (Encoding.IsNone())
+	{
+		return;
+	}
+
+	const int32 InputBytes = Response.Body.Num();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const bool bCompressed = Response.CompressBody(Encoding, ResponseConfig.CompressionFlags);
+	CompressionCycles.Add((int64)(FPlatformTime::Cycles64() - StartCycles));
+
+	if (bCompressed)
+	{
+		CompressedResponses.Increment();
+		CompressionInputBytes.Add(InputBytes);
+		CompressionOutputBytes.Add(Response.Body.Num());
+	}
+}
+
+void FMCPJsonRpcServer::CreateHttpErrorResponse(int32 StatusCode, const FString& ErrorMessage, FMCPHttpResponse& Response)
+{
+	Response.SetBody(FString::Printf(TEXT("{\"error\":\"%s\"}"), *ErrorMessage.ReplaceCharWithEscapedChar()));
+
+	// Error responses always close the connection because the request stream can no longer be trusted
+	Response.BeginHeaders(StatusCode);
+	Response.AddHeader("Content-Type", "application/json");
+	Response.AddHeader("Content-Length", (int64)Response.Body.Num());
+	Response.AddHeader("Connection", "close");
+	if (StatusCode == 503)
+	{
+		Response.AddHeader("Retry-After", (int64)RetryAfterSeconds);
+	}
+	else if (StatusCode == 426)
+	{
+		Response.AddHeader("Sec-WebSocket-Version", "13");
+	}
+	Response.AddHeader("X-Content-Type-Options", "nosniff");
+	Response.FinishHeaders();
+}
+
+bool FMCPJsonRpcServer::SendHttpResponse(FSocket* ClientSocket, const FMCPHttpResponse& Response)
+{
+	// Header block and body go out back to back without being joined into one buffer
+	if (!SendAll(ClientSocket, Response.Header.GetData(), Response.Header.Num()))
+	{
+		return false;
+	}
+
+	if (Response.IsStreamed())
+	{
+		// Memory stays at one chunk buffer however large the result is
+		FMCPChunkedArchive ChunkedArchive([this, ClientSocket](const uint8* Data, int32 Length)
+		{
+			return SendAll(ClientSocket, Data, Length);
+		}, StreamChunkBytes);
+
+		Response.BodyStreamer(ChunkedArchive);
+		if (!ChunkedArchive.Finish())
+		{
+			LogMessage(TEXT("Client went away during streamed response"));
+			return false;
+		}
+
+		StreamedResponses.Increment();
+		StreamedBodyBytes.Add(ChunkedArchive.GetBodyBytes());
+		ResponseBytesSent.Add(ChunkedArchive.GetBodyBytes());
+	}
+	else if (!SendAll(ClientSocket, Response.Body.GetData(), Response.Body.Num()))
+	{
+		return false;
+	}
+
+	CountSentResponse(Response);
+	return true;
+}
+
+bool FMCPJsonRpcServer::SendBufferedResponse(FMCPConnection* Connection)
+{
+	const FMCPHttpResponse& Response = Connection->Response;
+	const int64 HeaderBytes = Response.Header.Num();
+	const int64 TotalBytes = Response.GetTotalSize();
+	const int64 BytesSentBefore = Connection->BytesSent;
+
+	while (Connection->BytesSent < TotalBytes)
+	{
+		// Header block and body go out back to back without being joined into one buffer
+		const bool bInHeader = Connection->BytesSent < HeaderBytes;
+		const uint8* Data = bInHeader
+			? Response.Header.GetData() + Connection->BytesSent
+			: Response.Body.GetData() + (Connection->BytesSent - HeaderBytes);
+		const int32 Length = (int32)(bInHeader ? HeaderBytes - Connection->BytesSent : TotalBytes - Connection->BytesSent);
+
+		int32 BytesSent = 0;
+		if (Connection->Socket->Send(Data, Length, BytesSent) && BytesSent > 0)
+		{
+			Connection->BytesSent += BytesSent;
+			continue;
+		}
+
+		if (ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK)
+		{
+			CloseConnection(Connection);
+			return false;
+		}
+
+		// The send buffer is full; wait in the reactor until the client reads. The timeout bounds
+		// a stall, not the whole transfer, so a large response to a slow reader is not cut off.
+		if (Connection->Phase != EMCPConnectionPhase::Writing || Connection->BytesSent > BytesSentBefore)
+		{
+			Connection->Phase = EMCPConnectionPhase::Writing;
+			Connection->Deadline = FPlatformTime::Seconds() + GetConfig()->TimeoutSeconds;
+		}
+		Reactor.Park(Connection);
+		return false;
+	}
+
+	CountSentResponse(Response);
+	return true;
+}
+
+void FMCPJsonRpcServer::CountSentResponse(const FMCPHttpResponse& Response)
+{
+	ResponsesSent.Increment();
+	ResponseBytesSent.Add(Response.GetTotalSize());
+	ResponseBytesCopied.Add(Response.BytesCopied);
+	ResponseAllocations.Add(Response.Allocations);
+}
+
+bool FMCPJsonRpcServer::SendAll(FSocket* ClientSocket, const uint8* Data, int32 Length)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	const double TimeoutSeconds = (double)GetConfig()->TimeoutSeconds;
+	double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+
+	int32 Offset = 0;
+	while (Offset < Length)
+	{
+		int32 BytesSent = 0;
+		if (ClientSocket->Send(Data + Offset, Length - Offset, BytesSent) && BytesSent > 0)
+		{
+			// The timeout bounds a stall, not the whole transfer, so long streams are not cut off
+			Offset += BytesSent;
+			Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+			continue;
+		}
+
+		// The socket is non-blocking: a full send buffer is not an error, wait until it drains
+		if (SocketSubsystem->GetLastErrorCode() != SE_EWOULDBLOCK)
+		{
+			return false;
+		}
+
+		const double Remaining = Deadline - FPlatformTime::Seconds();
+		if (Remaining <= 0.0 || bForceClose)
+		{
+			LogMessage(TEXT("Timed out sending response to slow client"));
+			return false;
+		}
+		ClientSocket->Wait(ESocketWaitConditions::WaitForWrite, FTimespan::FromSeconds(FMath::Min(Remaining, StopPollIntervalSeconds)));
+	}
+	return true;
+}
+
+void FMCPJsonRpcServer::WriteStreamedJsonRpcResponse(FMCPJsonWriter& Writer, const FMCPResultStreamer& Streamer, TSharedPtr<FJsonValue> Id)
+{
+	const int64 JsonValuesBefore = Writer.GetJsonValuesWritten();
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("jsonrpc"), TEXT("2.0"));
+	Writer.WriteIdentifierPrefix(TEXT("result"));
+	Streamer(Writer);
+	if (Id.IsValid())
+	{
+		Writer.WriteValue(TEXT("id"), Id);
+	}
+	Writer.WriteObjectEnd();
+	ResponseJsonValues.Add(Writer.GetJsonValuesWritten() - JsonValuesBefore);
 }
 
 TSharedPtr<FJsonObject> FMCPJsonRpcServer::CreateErrorResponse(int32 ErrorCode, const FString& ErrorMessage, TSharedPtr<FJsonValue> Id)
@@ -565,242 +2563,436 @@ void FMCPJsonRpcServer::LogMessage(const FString& Message)
 	UE_LOG(LogTemp, Warning, TEXT("MCPJsonRpcServer: %s"), *Message);
 }
 
-template<typename ReturnType>
-ReturnType FMCPJsonRpcServer::ExecuteOnGameThread(TFunction<ReturnType()> Task)
+template<typename FutureType>
+bool FMCPJsonRpcServer::WaitForGameThread(const FutureType& Future, double TimeoutSeconds) const
 {
-	// THREAD SAFETY FIX: All Editor API calls must be executed on Game Thread
-	if (IsInGameThread())
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	while (!bForceClose)
 	{
-		// Already on Game Thread, execute directly with error handling
-		try
+		const double Remaining = Deadline - FPlatformTime::Seconds();
+		if (Remaining <= 0.0)
 		{
-			return Task();
+			return Future.IsReady();
 		}
-		catch (...)
+		if (Future.WaitFor(FTimespan::FromSeconds(FMath::Min(Remaining, StopPollIntervalSeconds))))
 		{
-			LogMessage(TEXT("Exception caught during Game Thread execution"));
-			return ReturnType{}; // Return default-constructed value
+			return true;
 		}
 	}
-	else
+	return Future.IsReady();
+}
+
+template<typename ReturnType>
+TMCPGameThreadCall<ReturnType> FMCPJsonRpcServer::CallOnGameThread(TUniqueFunction<ReturnType()>&& Task, double TimeoutSeconds)
+{
+	// A call only runs while someone is waiting for it, and waiters hold a connection, so StopServer()
+	// keeps whatever Task captures of `this` alive for it the same way; a call nobody waits for any
+	// more is skipped
+	return GameThreadQueue.Call<ReturnType>(MoveTemp(Task), TimeoutSeconds);
+}
+
+template<typename ReturnType>
+TFuture<TOptional<ReturnType>> FMCPJsonRpcServer::QueueOnGameThread(TUniqueFunction<ReturnType()>&& Task, double TimeoutSeconds)
+{
+	TMCPGameThreadCall<ReturnType> Call = CallOnGameThread<ReturnType>(MoveTemp(Task), TimeoutSeconds);
+
+	// The game thread may be stuck in something long, so the deadline is watched from the reactor.
+	// Cancelling a call that has already completed does nothing.
+	Reactor.AddTimer(FPlatformTime::Seconds() + TimeoutSeconds, [State = Call.State]()
 	{
-		// Marshal to Game Thread and wait for completion
-		ReturnType Result{};
-		bool bTaskCompleted = false;
-		FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
-		
-		AsyncTask(ENamedThreads::GameThread, [&Task, &Result, &bTaskCompleted, CompletionEvent, this]()
-		{
-			try
-			{
-				Result = Task();
-				bTaskCompleted = true;
-			}
-			catch (...)
-			{
-				LogMessage(TEXT("Exception caught during marshaled Game Thread execution"));
-				bTaskCompleted = false;
-			}
-			CompletionEvent->Trigger();
-		});
-		
-		// Wait for completion (with timeout to prevent deadlocks)
-		bool bTimedOut = !CompletionEvent->Wait(5000); // 5 second timeout
-		FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
-		
-		if (bTimedOut)
+		State->Cancel();
+	});
+
+	// Runs on whichever thread resolves the call: the game thread, the reactor, or the caller if it
+	// is already resolved
+	return Call.Future.Then([this](TFuture<TOptional<ReturnType>> Future)
+	{
+		TOptional<ReturnType> Result = Future.Get();
+		if (!Result.IsSet())
 		{
+			GameThreadTimeouts.Increment();
 			LogMessage(TEXT("Game Thread execution timed out"));
 		}
-		else if (!bTaskCompleted)
-		{
-			LogMessage(TEXT("Game Thread execution failed"));
-		}
-		
 		return Result;
+	});
+}
+
+template<typename ReturnType>
+ReturnType FMCPJsonRpcServer::ExecuteOnGameThread(TFunction<ReturnType()> Task, double TimeoutSeconds)
+{
+	// THREAD SAFETY FIX: All Editor API calls must be executed on Game Thread
+	if (IsInGameThread())
+	{
+		// Already on Game Thread, execute directly
+		return Task();
+	}
+
+	// The call owns the task and its result, so giving up on it leaves the game thread nothing on
+	// this stack to write into, and a call that has not started by then never runs
+	TMCPGameThreadCall<ReturnType> Call = CallOnGameThread<ReturnType>(MoveTemp(Task), TimeoutSeconds);
+	if (!WaitForGameThread(Call.Future, TimeoutSeconds))
+	{
+		Call.Cancel();
 	}
+
+	const TOptional<ReturnType> Result = Call.Future.Get();
+	if (!Result.IsSet())
+	{
+		GameThreadTimeouts.Increment();
+		LogMessage(TEXT("Game Thread execution timed out"));
+		return ReturnType{};
+	}
+	return Result.GetValue();
 }
 
 void FMCPJsonRpcServer::ExecuteOnGameThreadAsync(TFunction<void()> Task)
 {
-	// THREAD SAFETY FIX: Async execution on Game Thread with error handling
+	// THREAD SAFETY FIX: Async execution on Game Thread
 	if (IsInGameThread())
 	{
-		try
+		Task();
+	}
+	else
+	{
+		BeginWork();
+		GameThreadQueue.Enqueue([Task, this]()
 		{
 			Task();
-		}
-		catch (...)
+			EndWork();
+		});
+	}
+}
+
+TFuture<FMCPResultStreamer> FMCPJsonRpcServer::StreamResourcesList(const FMCPResourcesListParams& Params)
+{
+	// The registry is queried from this worker, so a listing does not wait for the next editor
+	// frame; only while the initial scan is running does it go through the Game Thread, and then
+	// without this worker waiting for it. FAssetData is compact next to its JSON form.
+	FString SearchPath;
+	if (!NormalizeContentPath(Params.Path, SearchPath))
+	{
+		return MakeFulfilledPromise<FMCPResultStreamer>([Path = Params.Path](FMCPJsonWriter& Writer)
 		{
-			LogMessage(TEXT("Exception caught during async Game Thread execution"));
-		}
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("error"), FString::Printf(TEXT("Invalid content path: %s"), *Path));
+			Writer.WriteObjectEnd();
+		}).GetFuture();
+	}
+
+	TSharedRef<TArray<FAssetData>, ESPMode::ThreadSafe> Assets = MakeShared<TArray<FAssetData>, ESPMode::ThreadSafe>();
+	TFuture<TOptional<bool>> Gathered;
+	if (CanReadAssetRegistry())
+	{
+		GatherResourcesList(SearchPath, *Assets);
+		RegistryWorkerReads.Increment();
+		Gathered = MakeFulfilledPromise<TOptional<bool>>(true).GetFuture();
 	}
 	else
 	{
-		AsyncTask(ENamedThreads::GameThread, [Task, this]()
+		Gathered = QueueOnGameThread<bool>([this, SearchPath, Assets]() -> bool
 		{
-			try
-			{
-				Task();
-			}
-			catch (...)
+			GatherResourcesList(SearchPath, *Assets);
+			RegistryGameThreadReads.Increment();
+			return true;
+		});
+	}
+
+	// Written one asset at a time, with no allocation per asset
+	return Gathered.Then([SearchPath, Assets](TFuture<TOptional<bool>> Future) -> FMCPResultStreamer
+	{
+		if (!Future.Get().IsSet())
+		{
+			return FMCPResultStreamer();
+		}
+		return [SearchPath, Assets](FMCPJsonWriter& Writer)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteArrayStart(TEXT("assets"));
+			for (const FAssetData& AssetData : *Assets)
 			{
-				LogMessage(TEXT("Exception caught during async marshaled Game Thread execution"));
+				Writer.WriteAsset(AssetData);
 			}
-		});
+			Writer.WriteArrayEnd();
+			Writer.WriteValue(TEXT("count"), Assets->Num());
+			Writer.WriteValue(TEXT("path"), SearchPath);
+			Writer.WriteObjectEnd();
+		};
+	});
+}
+
+bool FMCPJsonRpcServer::CanReadAssetRegistry()
+{
+	// The registry guards its own state, but answers may be incomplete until the scan has finished
+	if (IsInGameThread())
+	{
+		return true;
+	}
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	return AssetRegistry && !AssetRegistry->IsLoadingAssets();
+}
+
+void FMCPJsonRpcServer::GatherResourcesList(const FString& SearchPath, TArray<FAssetData>& OutAssets)
+{
+	// Loaded by the engine long before the server starts, so no module loading here
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Create filter for the search path
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(*SearchPath));
+	Filter.bRecursivePaths = false; // Only immediate children
+
+	// Loaded objects can only be searched on the Game Thread, so the registry's own entries are
+	// used on either thread and a listing does not depend on where it ran. They already cover new,
+	// unsaved assets, and the fields listed do not depend on tags that may be stale.
+	Filter.bIncludeOnlyOnDiskAssets = true;
+
+	// Get assets
+	AssetRegistry.GetAssets(Filter, OutAssets);
+}
+
+bool FMCPJsonRpcServer::NormalizeContentPath(const FString& Path, FString& OutPath)
+{
+	OutPath = Path;
+	while (OutPath.Len() > 1 && OutPath.EndsWith(TEXT("/")))
+	{
+		OutPath.LeftChopInline(1, EAllowShrinking::No);
+	}
+
+	// A mount point such as /Game is a folder, but too short to pass as a package name itself
+	const bool bMountPoint = !OutPath.IsEmpty() && !OutPath.RightChop(1).Contains(TEXT("/"));
+	return bMountPoint ? FPackageName::IsValidPath(OutPath + TEXT("/")) : FPackageName::IsValidLongPackageName(OutPath);
+}
+
+TFuture<FMCPResultStreamer> FMCPJsonRpcServer::StreamDiagnosticsSyntheticAssets(const FMCPSyntheticAssetsParams& Params)
+{
+	// Emits resources.list-shaped entries without touching the registry, to measure the response path alone
+	const int32 Count = FMath::Clamp(Params.Count, 0, MaxSyntheticAssets);
+
+	return MakeFulfilledPromise<FMCPResultStreamer>([Count](FMCPJsonWriter& Writer)
+	{
+		// One builder reused for every string, as WriteAsset() does, so the loop does not allocate
+		TStringBuilder<128> Text;
+		Writer.WriteObjectStart();
+		Writer.WriteArrayStart(TEXT("assets"));
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Writer.WriteObjectStart();
+			Text.Reset();
+			Text.Appendf(TEXT("BP_Synthetic_%d"), Index);
+			Writer.WriteValue(TEXT("name"), Text.ToView());
+			Text.Reset();
+			Text.Appendf(TEXT("/Game/Synthetic/BP_Synthetic_%d.BP_Synthetic_%d"), Index, Index);
+			Writer.WriteValue(TEXT("path"), Text.ToView());
+			Writer.WriteValue(TEXT("class"), TEXT("/Script/Engine.Blueprint"));
+			Text.Reset();
+			Text.Appendf(TEXT("/Game/Synthetic/BP_Synthetic_%d"), Index);
+			Writer.WriteValue(TEXT("package"), Text.ToView());
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteValue(TEXT("count"), Count);
+		Writer.WriteValue(TEXT("path"), TEXT("/Game/Synthetic"));
+		Writer.WriteObjectEnd();
+	}).GetFuture();
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleDiagnosticsGameThreadWork(const FMCPGameThreadWorkParams& Params)
+{
+	// Spin rather than sleep, so the time shows up as game-thread work the way an editor call would
+	const double WorkSeconds = FMath::Clamp(Params.WorkMs, 0.0, MaxGameThreadWorkMs) / 1000.0;
+	const double Start = FPlatformTime::Seconds();
+	double Elapsed = 0.0;
+	while (Elapsed < WorkSeconds)
+	{
+		FPlatformProcess::YieldCycles(1000);
+		Elapsed = FPlatformTime::Seconds() - Start;
 	}
+
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+	Result->SetNumberField(TEXT("work_ms"), Elapsed * 1000.0);
+	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleResourcesList(TSharedPtr<FJsonObject> Params)
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleDiagnosticsApplySettings(TSharedPtr<FJsonObject> Params)
 {
-	// THREAD SAFETY FIX: Execute AssetRegistry access on Game Thread
+	// Overrides go into a transient copy of the saved settings, so nothing is persisted and a call
+	// with no parameters restores the saved configuration
 	return ExecuteOnGameThread<TSharedPtr<FJsonObject>>([this, Params]() -> TSharedPtr<FJsonObject>
 	{
-		TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
-		TArray<TSharedPtr<FJsonValue>> Assets;
-
-		// Get path parameter (default to /Game if not provided)
-		FString SearchPath = TEXT("/Game");
-		if (Params.IsValid() && Params->HasField(TEXT("path")))
-		{
-			SearchPath = Params->GetStringField(TEXT("path"));
-		}
-
-		// Get Asset Registry - Safe to call from Game Thread
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-		IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-		// Create filter for the search path
-		FARFilter Filter;
-		Filter.PackagePaths.Add(FName(*SearchPath));
-		Filter.bRecursivePaths = false; // Only immediate children
-
-		// Get assets
-		TArray<FAssetData> AssetDataArray;
-		AssetRegistry.GetAssets(Filter, AssetDataArray);
+		UMCPServerSettings* Overrides = NewObject<UMCPServerSettings>(GetTransientPackage());
 
-		// Convert to JSON
-		for (const FAssetData& AssetData : AssetDataArray)
+		TArray<TSharedPtr<FJsonValue>> Applied;
+		TArray<TSharedPtr<FJsonValue>> Rejected;
+		if (Params.IsValid())
 		{
-			TSharedPtr<FJsonObject> AssetJson = MakeShareable(new FJsonObject);
-			AssetJson->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-			AssetJson->SetStringField(TEXT("path"), AssetData.GetObjectPathString());
-			AssetJson->SetStringField(TEXT("class"), AssetData.AssetClassPath.ToString());
-			AssetJson->SetStringField(TEXT("package"), AssetData.PackageName.ToString());
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Params->Values)
+			{
+				FString ValueText;
+				if (Field.Value.IsValid() && Field.Value->Type == EJson::Boolean)
+				{
+					ValueText = Field.Value->AsBool() ? TEXT("True") : TEXT("False");
+				}
+				else if (Field.Value.IsValid() && Field.Value->Type == EJson::Number)
+				{
+					// Integral values keep their exact digits; anything else, such as a float
+					// setting in seconds or milliseconds, must not lose its fraction
+					const double Number = Field.Value->AsNumber();
+					ValueText = FMath::RoundToDouble(Number) == Number
+						? FString::Printf(TEXT("%lld"), (int64)Number)
+						: FString::SanitizeFloat(Number);
+				}
+				else if (Field.Value.IsValid())
+				{
+					Field.Value->TryGetString(ValueText);
+				}
 
-			Assets.Add(MakeShareable(new FJsonValueObject(AssetJson)));
+				FProperty* Property = FindFProperty<FProperty>(UMCPServerSettings::StaticClass(), *Field.Key);
+				if (Property && Property->HasAnyPropertyFlags(CPF_Config) && Property->ImportText_InContainer(*ValueText, Overrides, Overrides, PPF_None))
+				{
+					Applied.Add(MakeShareable(new FJsonValueString(Field.Key)));
+				}
+				else
+				{
+					Rejected.Add(MakeShareable(new FJsonValueString(Field.Key)));
+				}
+			}
 		}
 
-		Result->SetArrayField(TEXT("assets"), Assets);
-		Result->SetNumberField(TEXT("count"), Assets.Num());
-		Result->SetStringField(TEXT("path"), SearchPath);
+		ApplySettings(Overrides);
 
+		TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+		Result->SetArrayField(TEXT("applied"), Applied);
+		Result->SetArrayField(TEXT("rejected"), Rejected);
+		Result->SetNumberField(TEXT("port"), ServerPort.load());
+		Result->SetStringField(TEXT("settings"), GetAppliedSettingsString());
 		return Result;
 	});
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleResourcesGet(TSharedPtr<FJsonObject> Params)
+TFuture<FMCPResultStreamer> FMCPJsonRpcServer::StreamResourcesGet(const FMCPResourcesGetParams& Params)
 {
-	// THREAD SAFETY FIX: Execute asset loading on Game Thread
-	return ExecuteOnGameThread<TSharedPtr<FJsonObject>>([this, Params]() -> TSharedPtr<FJsonObject>
-	{
-		TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+	const FSoftObjectPath ObjectPath(Params.AssetPath);
 
-		if (!Params.IsValid() || !Params->HasField(TEXT("asset_path")))
+	// Assets that are not Blueprints, and paths that name nothing, are answered from the registry
+	// on this worker
+	TOptional<FAssetData> Found;
+	if (CanReadAssetRegistry())
+	{
+		Found = IAssetRegistry::GetChecked().GetAssetByObjectPath(ObjectPath, /*bIncludeOnlyOnDiskAssets*/ true);
+		RegistryWorkerReads.Increment();
+		if (Found->AssetClassPath != UBlueprint::StaticClass()->GetClassPathName())
 		{
-			Result->SetStringField(TEXT("error"), TEXT("Missing asset_path parameter"));
-			return Result;
+			return MakeFulfilledPromise<FMCPResultStreamer>([AssetData = MoveTemp(*Found)](FMCPJsonWriter& Writer)
+			{
+				WriteResourceDetails(Writer, AssetData, nullptr);
+			}).GetFuture();
 		}
+	}
 
-		FString AssetPath = Params->GetStringField(TEXT("asset_path"));
-
-		// Get Asset Registry - Safe to call from Game Thread
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-		IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-		// Find asset
-		FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPath));
-		if (!AssetData.IsValid())
+	// A Blueprint can only be loaded and read on the Game Thread, so the result is written there,
+	// into a buffer the streamer copies into the response. The request waits for it without this
+	// worker.
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Result = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+	TFuture<TOptional<bool>> Written = QueueOnGameThread<bool>([this, ObjectPath, Found, Result]() -> bool
+	{
+		FAssetData AssetData;
+		if (Found.IsSet())
 		{
-			Result->SetStringField(TEXT("error"), TEXT("Asset not found"));
-			return Result;
+			AssetData = Found.GetValue();
+		}
+		else
+		{
+			// The same registry entries as the worker lookup, so the answer does not depend on the path taken
+			AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(ObjectPath, /*bIncludeOnlyOnDiskAssets*/ true);
+			RegistryGameThreadReads.Increment();
 		}
 
-		// Basic asset info
-		Result->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-		Result->SetStringField(TEXT("path"), AssetData.GetObjectPathString());
-		Result->SetStringField(TEXT("class"), AssetData.AssetClassPath.ToString());
-		Result->SetStringField(TEXT("package"), AssetData.PackageName.ToString());
-
-		// Add Blueprint-specific details if it's a Blueprint
+		UBlueprint* Blueprint = nullptr;
 		if (AssetData.AssetClassPath == UBlueprint::StaticClass()->GetClassPathName())
 		{
-			UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset()); // Asset loading must be on Game Thread
+			Blueprint = Cast<UBlueprint>(AssetData.GetAsset()); // Asset loading must be on Game Thread
 			if (Blueprint)
 			{
-				TSharedPtr<FJsonObject> BlueprintDetails = MakeShareable(new FJsonObject);
-				
-				// Parent class info
-				if (Blueprint->ParentClass)
-				{
-					BlueprintDetails->SetStringField(TEXT("parent_class"), Blueprint->ParentClass->GetName());
-				}
-
-				// Variables
-				TArray<TSharedPtr<FJsonValue>> Variables;
-				for (const FBPVariableDescription& Variable : Blueprint->NewVariables)
-				{
-					TSharedPtr<FJsonObject> VarJson = MakeShareable(new FJsonObject);
-					VarJson->SetStringField(TEXT("name"), Variable.VarName.ToString());
-				VarJson->SetStringField(TEXT("type"), Variable.VarType.PinCategory.ToString());
-				VarJson->SetBoolField(TEXT("is_public"), Variable.PropertyFlags & CPF_BlueprintVisible);
-				Variables.Add(MakeShareable(new FJsonValueObject(VarJson)));
+				// Edits waiting for their refresh are applied before anyone reads the Blueprint
+				RefreshScheduler.Flush(*Blueprint);
 			}
-			BlueprintDetails->SetArrayField(TEXT("variables"), Variables);
+		}
 
-			// Functions
-			TArray<TSharedPtr<FJsonValue>> Functions;
-			for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-			{
-				if (Graph)
-				{
-					TSharedPtr<FJsonObject> FuncJson = MakeShareable(new FJsonObject);
-					FuncJson->SetStringField(TEXT("name"), Graph->GetFName().ToString());
-					Functions.Add(MakeShareable(new FJsonValueObject(FuncJson)));
-				}
-			}
-			BlueprintDetails->SetArrayField(TEXT("functions"), Functions);
+		FMCPJsonWriter Writer(*Result);
+		WriteResourceDetails(Writer, AssetData, Blueprint);
+		return true;
+	});
 
-				Result->SetObjectField(TEXT("blueprint_details"), BlueprintDetails);
-			}
+	return Written.Then([Result](TFuture<TOptional<bool>> Future) -> FMCPResultStreamer
+	{
+		if (!Future.Get().IsSet())
+		{
+			return FMCPResultStreamer();
 		}
-
-		return Result;
+		return [Result](FMCPJsonWriter& Writer)
+		{
+			Writer.WriteRawValue(FUtf8StringView((const UTF8CHAR*)Result->GetData(), Result->Num()));
+		};
 	});
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleResourcesCreate(TSharedPtr<FJsonObject> Params)
+void FMCPJsonRpcServer::WriteResourceDetails(FMCPJsonWriter& Writer, const FAssetData& AssetData, const UBlueprint* Blueprint)
 {
-	// THREAD SAFETY FIX: Execute asset creation on Game Thread
-	return ExecuteOnGameThread<TSharedPtr<FJsonObject>>([this, Params]() -> TSharedPtr<FJsonObject>
+	Writer.WriteObjectStart();
+	if (!AssetData.IsValid())
 	{
-		TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+		Writer.WriteValue(TEXT("error"), TEXT("Asset not found"));
+		Writer.WriteObjectEnd();
+		return;
+	}
 
-		if (!Params.IsValid())
+	// Basic asset info
+	Writer.WriteAssetFields(AssetData);
+
+	// Add Blueprint-specific details if it's a Blueprint
+	if (Blueprint)
+	{
+		Writer.WriteObjectStart(TEXT("blueprint_details"));
+
+		// Parent class info
+		if (Blueprint->ParentClass)
+		{
+			Writer.WriteValue(TEXT("parent_class"), Blueprint->ParentClass->GetFName());
+		}
+
+		Writer.WriteArrayStart(TEXT("variables"));
+		for (const FBPVariableDescription& Variable : Blueprint->NewVariables)
 		{
-			Result->SetStringField(TEXT("error"), TEXT("Missing parameters"));
-			return Result;
+			Writer.WriteVariable(Variable);
 		}
+		Writer.WriteArrayEnd();
 
-		// Get required parameters
-		FString AssetType, AssetName, Path;
-		if (!Params->TryGetStringField(TEXT("asset_type"), AssetType) ||
-			!Params->TryGetStringField(TEXT("asset_name"), AssetName) ||
-			!Params->TryGetStringField(TEXT("path"), Path))
+		Writer.WriteArrayStart(TEXT("functions"));
+		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
 		{
-			Result->SetStringField(TEXT("error"), TEXT("Missing required parameters: asset_type, asset_name, path"));
-			return Result;
+			if (Graph)
+			{
+				Writer.WriteGraph(*Graph);
+			}
 		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteObjectEnd();
+	}
+
+	Writer.WriteObjectEnd();
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleResourcesCreate(const FMCPResourcesCreateParams& Params)
+{
+	// THREAD SAFETY FIX: Execute asset creation on Game Thread
+	return ExecuteOnGameThread<TSharedPtr<FJsonObject>>([this, Params]() -> TSharedPtr<FJsonObject>
+	{
+		TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+
+		const FString& AssetType = Params.AssetType;
+		const FString& AssetName = Params.AssetName;
+		const FString& Path = Params.Path;
 
 		// Handle Blueprint creation
 		if (AssetType == TEXT("Blueprint"))
@@ -814,10 +3006,9 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleResourcesCreate(TSharedPtr<FJso
 			Factory->ParentClass = AActor::StaticClass(); // Default to Actor
 
 			// Override parent class if specified
-			if (Params->HasField(TEXT("parent_class")))
+			if (!Params.ParentClass.IsEmpty())
 			{
-				FString ParentClassName = Params->GetStringField(TEXT("parent_class"));
-				UClass* ParentClass = FindObject<UClass>(nullptr, *ParentClassName);
+				UClass* ParentClass = FindObject<UClass>(nullptr, *Params.ParentClass);
 				if (ParentClass)
 				{
 					Factory->ParentClass = ParentClass;
@@ -848,25 +3039,13 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleResourcesCreate(TSharedPtr<FJso
 	});
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsCreateBlueprint(TSharedPtr<FJsonObject> Params)
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsCreateBlueprint(const FMCPCreateBlueprintParams& Params)
 {
 	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
 
-	if (!Params.IsValid())
-	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing parameters"));
-		return Result;
-	}
-
-	// Get required parameters
-	FString BlueprintName, Path, ParentClass;
-	if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName) ||
-		!Params->TryGetStringField(TEXT("path"), Path) ||
-		!Params->TryGetStringField(TEXT("parent_class"), ParentClass))
-	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing required parameters: blueprint_name, path, parent_class"));
-		return Result;
-	}
+	const FString& BlueprintName = Params.BlueprintName;
+	const FString& Path = Params.Path;
+	const FString& ParentClass = Params.ParentClass;
 
 	// Find parent class
 	UClass* ParentClassPtr = FindObject<UClass>(nullptr, *ParentClass);
@@ -891,9 +3070,7 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsCreateBlueprint(TSharedPtr
 		UBlueprint* Blueprint = Cast<UBlueprint>(NewAsset);
 		if (Blueprint)
 		{
-			// Mark Blueprint as modified and regenerate
-			FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-			FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
+			RefreshScheduler.MarkDirty(*Blueprint);
 
 			Result->SetStringField(TEXT("status"), TEXT("success"));
 			Result->SetStringField(TEXT("blueprint_path"), Blueprint->GetPathName());
@@ -913,84 +3090,80 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsCreateBlueprint(TSharedPtr
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsAddVariable(TSharedPtr<FJsonObject> Params)
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsAddVariable(const FMCPAddVariableParams& Params)
 {
-	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
-
-	if (!Params.IsValid())
+	// Load the Blueprint
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *Params.BlueprintPath);
+	if (!Blueprint)
 	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing parameters"));
-		return Result;
+		return MCPJsonRpcServer::BlueprintNotFound(Params.BlueprintPath);
 	}
 
-	// Get required parameters
-	FString BlueprintPath, VariableName, VariableType;
-	bool bIsPublic = false;
-	
-	if (!Params->TryGetStringField(TEXT("blueprint_path"), BlueprintPath) ||
-		!Params->TryGetStringField(TEXT("variable_name"), VariableName) ||
-		!Params->TryGetStringField(TEXT("variable_type"), VariableType))
+	TSharedPtr<FJsonObject> Result = AddVariable(*Blueprint, Params);
+	if (!Result->HasField(TEXT("error")))
 	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing required parameters: blueprint_path, variable_name, variable_type"));
-		return Result;
+		RefreshScheduler.MarkDirty(*Blueprint);
 	}
+	return Result;
+}
 
-	Params->TryGetBoolField(TEXT("is_public"), bIsPublic);
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::AddVariable(UBlueprint& Blueprint, const FMCPAddVariableParams& Params)
+{
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
 
-	// Load the Blueprint
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-	if (!Blueprint)
-	{
-		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
-		return Result;
-	}
+	const FString& VariableName = Params.VariableName;
+	const FString& VariableType = Params.VariableType;
+	const bool bIsPublic = Params.bIsPublic;
+
+	const FName VariableFName(*VariableName);
 
-	// Create variable description
-	FBPVariableDescription NewVariable;
-	NewVariable.VarName = FName(*VariableName);
-	
 	// Set variable type based on string
+	FEdGraphPinType PinType;
 	if (VariableType == TEXT("bool") || VariableType == TEXT("boolean"))
 	{
-		NewVariable.VarType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
 	}
 	else if (VariableType == TEXT("int") || VariableType == TEXT("integer"))
 	{
-		NewVariable.VarType.PinCategory = UEdGraphSchema_K2::PC_Int;
+		PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
 	}
 	else if (VariableType == TEXT("float") || VariableType == TEXT("double"))
 	{
-		NewVariable.VarType.PinCategory = UEdGraphSchema_K2::PC_Real;
-		NewVariable.VarType.PinSubCategory = UEdGraphSchema_K2::PC_Float;
+		PinType.PinCategory = UEdGraphSchema_K2::PC_Real;
+		PinType.PinSubCategory = UEdGraphSchema_K2::PC_Float;
 	}
 	else if (VariableType == TEXT("string"))
 	{
-		NewVariable.VarType.PinCategory = UEdGraphSchema_K2::PC_String;
+		PinType.PinCategory = UEdGraphSchema_K2::PC_String;
 	}
 	else if (VariableType == TEXT("vector"))
 	{
-		NewVariable.VarType.PinCategory = UEdGraphSchema_K2::PC_Struct;
-		NewVariable.VarType.PinSubCategoryObject = TBaseStructure<FVector>::Get();
+		PinType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+		PinType.PinSubCategoryObject = TBaseStructure<FVector>::Get();
 	}
 	else
 	{
 		// Default to string if unknown type
-		NewVariable.VarType.PinCategory = UEdGraphSchema_K2::PC_String;
+		PinType.PinCategory = UEdGraphSchema_K2::PC_String;
+	}
+
+	// Add variable to Blueprint; this refuses a name already used by the Blueprint or its parents
+	if (!FBlueprintEditorUtils::AddMemberVariable(&Blueprint, VariableFName, PinType))
+	{
+		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to add variable '%s'; the name is empty or already in use"), *VariableName));
+		return Result;
 	}
 
 	// Set visibility
 	if (bIsPublic)
 	{
-		NewVariable.PropertyFlags |= CPF_BlueprintVisible | CPF_BlueprintReadOnly;
+		const int32 VariableIndex = FBlueprintEditorUtils::FindNewVariableIndex(&Blueprint, VariableFName);
+		if (VariableIndex != INDEX_NONE)
+		{
+			Blueprint.NewVariables[VariableIndex].PropertyFlags |= CPF_BlueprintVisible | CPF_BlueprintReadOnly;
+		}
 	}
 
-	// Add variable to Blueprint
-	Blueprint->NewVariables.Add(NewVariable);
-	
-	// Mark Blueprint as modified and regenerate
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-	FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
-
 	Result->SetStringField(TEXT("status"), TEXT("success"));
 	Result->SetStringField(TEXT("variable_name"), VariableName);
 	Result->SetStringField(TEXT("variable_type"), VariableType);
@@ -999,38 +3172,47 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsAddVariable(TSharedPtr<FJs
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsAddFunction(TSharedPtr<FJsonObject> Params)
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsAddFunction(const FMCPAddFunctionParams& Params)
 {
-	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
-
-	if (!Params.IsValid())
+	// Load the Blueprint
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *Params.BlueprintPath);
+	if (!Blueprint)
 	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing parameters"));
-		return Result;
+		return MCPJsonRpcServer::BlueprintNotFound(Params.BlueprintPath);
 	}
 
-	// Get required parameters
-	FString BlueprintPath, FunctionName;
-	
-	if (!Params->TryGetStringField(TEXT("blueprint_path"), BlueprintPath) ||
-		!Params->TryGetStringField(TEXT("function_name"), FunctionName))
+	TSharedPtr<FJsonObject> Result = AddFunction(*Blueprint, Params);
+	if (!Result->HasField(TEXT("error")))
 	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing required parameters: blueprint_path, function_name"));
-		return Result;
+		RefreshScheduler.MarkDirty(*Blueprint);
 	}
+	return Result;
+}
 
-	// Load the Blueprint
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-	if (!Blueprint)
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::AddFunction(UBlueprint& Blueprint, const FMCPAddFunctionParams& Params)
+{
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+
+	const FString& FunctionName = Params.FunctionName;
+
+	// A graph is a subobject of the Blueprint named after the function, so a name that is taken
+	// would collide with it; refusing it also fails a tools.batch, which then rolls back
+	const FName FunctionFName(*FunctionName);
+	const bool bNameInUse = Blueprint.FunctionGraphs.ContainsByPredicate([FunctionFName](const UEdGraph* Graph)
 	{
-		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
+		return Graph && Graph->GetFName() == FunctionFName;
+	}) || FindObject<UObject>(&Blueprint, *FunctionName) != nullptr;
+	if (FunctionName.IsEmpty() || bNameInUse)
+	{
+		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to add function '%s'; the name is empty or already in use"), *FunctionName));
 		return Result;
 	}
 
 	// Create new function graph
+	Blueprint.Modify();
 	UEdGraph* NewGraph = FBlueprintEditorUtils::CreateNewGraph(
-		Blueprint, 
-		FName(*FunctionName), 
+		&Blueprint, 
+		FunctionFName, 
 		UEdGraph::StaticClass(), 
 		UEdGraphSchema_K2::StaticClass()
 	);
@@ -1038,18 +3220,14 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsAddFunction(TSharedPtr<FJs
 	if (NewGraph)
 	{
 		// Add to function graphs
-		Blueprint->FunctionGraphs.Add(NewGraph);
+		Blueprint.FunctionGraphs.Add(NewGraph);
 		
 		// Create function entry node
 		FGraphNodeCreator<UK2Node_FunctionEntry> EntryNodeCreator(*NewGraph);
 		UK2Node_FunctionEntry* EntryNode = EntryNodeCreator.CreateNode();
-		EntryNode->CustomGeneratedFunctionName = FName(*FunctionName);
+		EntryNode->CustomGeneratedFunctionName = FunctionFName;
 		EntryNodeCreator.Finalize();
 
-		// Mark Blueprint as modified and regenerate
-		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-		FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
-
 		Result->SetStringField(TEXT("status"), TEXT("success"));
 		Result->SetStringField(TEXT("function_name"), FunctionName);
 		Result->SetStringField(TEXT("graph_name"), NewGraph->GetFName().ToString());
@@ -1062,44 +3240,39 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsAddFunction(TSharedPtr<FJs
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsEditGraph(TSharedPtr<FJsonObject> Params)
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsEditGraph(const FMCPEditGraphParams& Params)
 {
-	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
-
-	if (!Params.IsValid())
+	// Load the Blueprint
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *Params.BlueprintPath);
+	if (!Blueprint)
 	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing parameters"));
-		return Result;
+		return MCPJsonRpcServer::BlueprintNotFound(Params.BlueprintPath);
 	}
 
-	// Get required parameters
-	FString BlueprintPath, GraphName;
-	
-	if (!Params->TryGetStringField(TEXT("blueprint_path"), BlueprintPath) ||
-		!Params->TryGetStringField(TEXT("graph_name"), GraphName))
+	TSharedPtr<FJsonObject> Result = AddGraphNodes(*Blueprint, Params);
+	if (!Result->HasField(TEXT("error")))
 	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing required parameters: blueprint_path, graph_name"));
-		return Result;
+		RefreshScheduler.MarkDirty(*Blueprint);
 	}
+	return Result;
+}
 
-	// Load the Blueprint
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-	if (!Blueprint)
-	{
-		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
-		return Result;
-	}
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::AddGraphNodes(UBlueprint& Blueprint, const FMCPEditGraphParams& Params)
+{
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+
+	const FString& GraphName = Params.GraphName;
 
 	// Find the graph
 	UEdGraph* Graph = nullptr;
 	if (GraphName == TEXT("EventGraph") || GraphName.IsEmpty())
 	{
-		Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+		Graph = FBlueprintEditorUtils::FindEventGraph(&Blueprint);
 	}
 	else
 	{
 		// Look for function graph
-		for (UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
+		for (UEdGraph* FunctionGraph : Blueprint.FunctionGraphs)
 		{
 			if (FunctionGraph && FunctionGraph->GetFName().ToString() == GraphName)
 			{
@@ -1116,75 +3289,191 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsEditGraph(TSharedPtr<FJson
 	}
 
 	int32 NodesAdded = 0;
+	Graph->Modify();
 	
 	// Handle nodes to add
-	const TArray<TSharedPtr<FJsonValue>>* NodesToAdd;
-	if (Params->TryGetArrayField(TEXT("nodes_to_add"), NodesToAdd))
+	for (const FMCPGraphNodeParams& Node : Params.NodesToAdd)
+	{
+		if (Node.Type == TEXT("PrintString"))
+		{
+			// Create Print String node
+			FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*Graph);
+			UK2Node_CallFunction* NewNode = NodeCreator.CreateNode();
+			NewNode->FunctionReference.SetExternalMember(
+				GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString),
+				UKismetSystemLibrary::StaticClass()
+			);
+			NewNode->NodePosX = Node.X;
+			NewNode->NodePosY = Node.Y;
+
+			NodeCreator.Finalize();
+			NodesAdded++;
+		}
+		else if (Node.Type == TEXT("BeginPlay"))
+		{
+			// Create Begin Play event
+			FGraphNodeCreator<UK2Node_Event> NodeCreator(*Graph);
+			UK2Node_Event* NewNode = NodeCreator.CreateNode();
+			// Use the actual function name for BeginPlay event in UE 5.6
+			NewNode->EventReference.SetExternalMember(
+				FName("ReceiveBeginPlay"),
+				AActor::StaticClass()
+			);
+			NewNode->bOverrideFunction = true;
+			NewNode->NodePosX = Node.X;
+			NewNode->NodePosY = Node.Y;
+
+			NodeCreator.Finalize();
+			NodesAdded++;
+		}
+		// Add more node types as needed
+	}
+
+	Result->SetStringField(TEXT("status"), TEXT("success"));
+	Result->SetStringField(TEXT("graph_name"), GraphName);
+	Result->SetNumberField(TEXT("nodes_added"), NodesAdded);
+
+	return Result;
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandleToolsBatch(const FMCPToolsBatchParams& Params)
+{
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+
+	if (Params.Operations.Num() > MaxToolOperations)
+	{
+		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("A batch may hold at most %d operations"), MaxToolOperations));
+		return Result;
+	}
+
+	// Every operation is decoded and its Blueprint loaded before anything changes, so a malformed
+	// entry fails the batch without an edit to undo
+	struct FOperation
+	{
+		UBlueprint* Blueprint = nullptr;
+		TFunction<TSharedPtr<FJsonObject>(UBlueprint&)> Apply;
+	};
+	TArray<FOperation> Operations;
+	Operations.Reserve(Params.Operations.Num());
+	TMap<FString, UBlueprint*> BlueprintsByPath;
+
+	auto Fail = [&Result](int32 Index, const FMCPToolOperationParams& Operation, const FString& Error)
+	{
+		Result->SetStringField(TEXT("error"), FString::Printf(TEXT("Operation %d (%s): %s"), Index, *Operation.Method, *Error));
+		Result->SetNumberField(TEXT("failed_operation"), Index);
+		return Result;
+	};
+
+	for (int32 Index = 0; Index < Params.Operations.Num(); ++Index)
+	{
+		const FMCPToolOperationParams& Operation = Params.Operations[Index];
+		FOperation& Decoded = Operations.AddDefaulted_GetRef();
+		FString BlueprintPath;
+		FString Error;
+		bool bDecoded = false;
+		if (Operation.Method == TEXT("tools.add_variable"))
+		{
+			FMCPAddVariableParams OperationParams;
+			bDecoded = MCPJsonRpcServer::DecodeOperationParams(Operation, OperationParams, Error);
+			BlueprintPath = OperationParams.BlueprintPath;
+			Decoded.Apply = [OperationParams = MoveTemp(OperationParams)](UBlueprint& Blueprint) { return AddVariable(Blueprint, OperationParams); };
+		}
+		else if (Operation.Method == TEXT("tools.add_function"))
+		{
+			FMCPAddFunctionParams OperationParams;
+			bDecoded = MCPJsonRpcServer::DecodeOperationParams(Operation, OperationParams, Error);
+			BlueprintPath = OperationParams.BlueprintPath;
+			Decoded.Apply = [OperationParams = MoveTemp(OperationParams)](UBlueprint& Blueprint) { return AddFunction(Blueprint, OperationParams); };
+		}
+		else if (Operation.Method == TEXT("tools.edit_graph"))
+		{
+			FMCPEditGraphParams OperationParams;
+			bDecoded = MCPJsonRpcServer::DecodeOperationParams(Operation, OperationParams, Error);
+			BlueprintPath = OperationParams.BlueprintPath;
+			Decoded.Apply = [OperationParams = MoveTemp(OperationParams)](UBlueprint& Blueprint) { return AddGraphNodes(Blueprint, OperationParams); };
+		}
+		else
+		{
+			Error = TEXT("not a method tools.batch can apply");
+		}
+		if (!bDecoded)
+		{
+			return Fail(Index, Operation, Error);
+		}
+
+		UBlueprint** Loaded = BlueprintsByPath.Find(BlueprintPath);
+		if (!Loaded)
+		{
+			Loaded = &BlueprintsByPath.Add(BlueprintPath, LoadObject<UBlueprint>(nullptr, *BlueprintPath));
+		}
+		if (!*Loaded)
+		{
+			return Fail(Index, Operation, FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
+		}
+		Decoded.Blueprint = *Loaded;
+	}
+
+	// Undoing our own transaction afterwards must not take someone else's edits with it
+	if (!GEditor || GEditor->IsTransactionActive())
 	{
-		for (const TSharedPtr<FJsonValue>& NodeValue : *NodesToAdd)
+		Result->SetStringField(TEXT("error"), TEXT("The editor is in the middle of another transaction; retry shortly"));
+		return Result;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	TArray<UBlueprint*, TInlineAllocator<4>> Touched;
+	int32 FailedIndex = INDEX_NONE;
+	{
+		FScopedTransaction Transaction(FText::Format(NSLOCTEXT("MCPJsonRpcServer", "ToolsBatch", "MCP: {0} Blueprint operations"), Params.Operations.Num()));
+
+		// Recorded once per Blueprint before any operation can fail, so the transaction always has
+		// something to undo
+		for (const TPair<FString, UBlueprint*>& Loaded : BlueprintsByPath)
+		{
+			Loaded.Value->Modify();
+		}
+
+		for (int32 Index = 0; Index < Operations.Num(); ++Index)
 		{
-			if (TSharedPtr<FJsonObject> NodeObject = NodeValue->AsObject())
+			TSharedPtr<FJsonObject> OperationResult = Operations[Index].Apply(*Operations[Index].Blueprint);
+			if (OperationResult->HasField(TEXT("error")))
 			{
-				FString NodeType;
-				if (NodeObject->TryGetStringField(TEXT("type"), NodeType))
-				{
-					if (NodeType == TEXT("PrintString"))
-					{
-						// Create Print String node
-						FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*Graph);
-						UK2Node_CallFunction* NewNode = NodeCreator.CreateNode();
-						NewNode->FunctionReference.SetExternalMember(
-							GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString),
-							UKismetSystemLibrary::StaticClass()
-						);
-						
-						// Set position if provided
-						double X = 0, Y = 0;
-						if (NodeObject->TryGetNumberField(TEXT("x"), X) && NodeObject->TryGetNumberField(TEXT("y"), Y))
-						{
-							NewNode->NodePosX = X;
-							NewNode->NodePosY = Y;
-						}
-						
-						NodeCreator.Finalize();
-						NodesAdded++;
-					}
-					else if (NodeType == TEXT("BeginPlay"))
-					{
-						// Create Begin Play event
-						FGraphNodeCreator<UK2Node_Event> NodeCreator(*Graph);
-						UK2Node_Event* NewNode = NodeCreator.CreateNode();
-						// Use the actual function name for BeginPlay event in UE 5.6
-						NewNode->EventReference.SetExternalMember(
-							FName("ReceiveBeginPlay"),
-							AActor::StaticClass()
-						);
-						NewNode->bOverrideFunction = true;
-						
-						// Set position if provided
-						double X = 0, Y = 0;
-						if (NodeObject->TryGetNumberField(TEXT("x"), X) && NodeObject->TryGetNumberField(TEXT("y"), Y))
-						{
-							NewNode->NodePosX = X;
-							NewNode->NodePosY = Y;
-						}
-						
-						NodeCreator.Finalize();
-						NodesAdded++;
-					}
-					// Add more node types as needed
-				}
+				Fail(Index, Params.Operations[Index], OperationResult->GetStringField(TEXT("error")));
+				FailedIndex = Index;
+				break;
 			}
+			Touched.AddUnique(Operations[Index].Blueprint);
+			Results.Add(MakeShareable(new FJsonValueObject(OperationResult)));
 		}
 	}
 
-	// Mark Blueprint as modified and regenerate
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-	FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
+	if (FailedIndex != INDEX_NONE)
+	{
+		// The transaction is closed and on top of the undo stack; undo it without leaving a redo
+		GEditor->UndoTransaction(false);
+		ToolBatchRollbacks.Increment();
+		Result->SetBoolField(TEXT("rolled_back"), true);
+		return Result;
+	}
+
+	// One refresh per Blueprint instead of one per operation. A compile is done before answering,
+	// so the client can rely on it, and covers every Blueprint of the batch in one pass.
+	TArray<TSharedPtr<FJsonValue>> BlueprintPaths;
+	for (UBlueprint* Blueprint : Touched)
+	{
+		RefreshScheduler.MarkDirty(*Blueprint, Params.bCompile);
+		BlueprintPaths.Add(MakeShareable(new FJsonValueString(Blueprint->GetPathName())));
+	}
+	if (Params.bCompile)
+	{
+		RefreshScheduler.Flush(Touched);
+	}
+	ToolBatchOperations.Add(Operations.Num());
 
 	Result->SetStringField(TEXT("status"), TEXT("success"));
-	Result->SetStringField(TEXT("graph_name"), GraphName);
-	Result->SetNumberField(TEXT("nodes_added"), NodesAdded);
+	Result->SetArrayField(TEXT("results"), Results);
+	Result->SetArrayField(TEXT("blueprints"), BlueprintPaths);
+	Result->SetBoolField(TEXT("compiled"), Params.bCompile);
 
 	return Result;
 }
@@ -1257,17 +3546,11 @@ TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandlePromptsList(TSharedPtr<FJsonObj
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandlePromptsGet(TSharedPtr<FJsonObject> Params)
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::HandlePromptsGet(const FMCPPromptsGetParams& Params)
 {
 	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
 
-	if (!Params.IsValid() || !Params->HasField(TEXT("prompt_name")))
-	{
-		Result->SetStringField(TEXT("error"), TEXT("Missing prompt_name parameter"));
-		return Result;
-	}
-
-	FString PromptName = Params->GetStringField(TEXT("prompt_name"));
+	const FString& PromptName = Params.PromptName;
 
 	// Define prompt contents
 	TMap<FString, TPair<FString, FString>> PromptDatabase;
@@ -1704,13 +3987,13 @@ bool FMCPJsonRpcServer::IsPortAvailable(int32 Port)
 
 bool FMCPJsonRpcServer::RestartServer()
 {
-	int32 CurrentPort = ServerPort;
+	int32 CurrentPort = ServerPort.load();
 	
+	// StopServer() returns once in-flight requests have drained and the listeners are closed,
+	// and the listen socket uses SO_REUSEADDR, so the port can be rebound straight away
 	if (IsRunning())
 	{
 		StopServer();
-		// Wait a moment for cleanup
-		FPlatformProcess::Sleep(0.5f);
 	}
 	
 	return StartServer(CurrentPort);
@@ -1723,31 +4006,154 @@ void FMCPJsonRpcServer::ApplySettings(const UMCPServerSettings* Settings)
 		return;
 	}
 
-	// Cache applied settings
-	AppliedMaxConnections = Settings->MaxClientConnections;
-	AppliedTimeoutSeconds = Settings->ServerTimeoutSeconds;
-	bAppliedEnableCORS = Settings->bEnableCORS;
-	bAppliedEnableAuth = Settings->bEnableAuthentication;
-	AppliedAPIKey = Settings->APIKey;
-	AppliedCustomHeaders = Settings->CustomHeaders;
+	// Build the snapshot off the hot path and publish it in one swap; requests already running keep theirs
+	const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> OldConfig = GetConfig();
+	const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> NewConfig = FMCPServerConfig::Build(*Settings, &OldConfig.Get());
+	{
+		FWriteScopeLock WriteLock(ConfigLock);
+		Config = NewConfig;
+	}
+	ResultCache.SetBudget(NewConfig->ResultCacheBytes);
+	GameThreadQueue.SetBudget(NewConfig->GameThreadBudgetSeconds);
+	RefreshScheduler.SetDelay(NewConfig->BlueprintRefreshDelaySeconds);
+
+	if (IsRunning())
+	{
+		// The remaining settings own threads or sockets, so they are changed in place
+		if (NewConfig->MaxConnections != OldConfig->MaxConnections || NewConfig->ConnectionQueueSize != OldConfig->ConnectionQueueSize)
+		{
+			if (!WorkerPool.Resize(NewConfig->MaxConnections, NewConfig->ConnectionQueueSize))
+			{
+				LogMessage(TEXT("Failed to resize connection worker pool; keeping the current workers"));
+			}
+		}
+
+		if (NewConfig->bEnableLocalSocket != OldConfig->bEnableLocalSocket || NewConfig->LocalSocketPath != OldConfig->LocalSocketPath)
+		{
+			StopLocalListener();
+			StartLocalListener();
+		}
 
-	// Apply port if server is not running
-	if (!IsRunning())
+		// Only follow an actual change of the setting; a server on a fallback port stays there otherwise
+		if (NewConfig->ServerPort != OldConfig->ServerPort && NewConfig->ServerPort != ServerPort.load())
+		{
+			RebindPort(NewConfig->ServerPort);
+		}
+	}
+	else
 	{
-		ServerPort = Settings->ServerPort;
+		ServerPort.store(Settings->ServerPort);
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("MCP Server: Applied settings - Port: %d, MaxConnections: %d, Timeout: %ds, CORS: %s, Auth: %s"),
-		Settings->ServerPort, AppliedMaxConnections, AppliedTimeoutSeconds,
-		bAppliedEnableCORS ? TEXT("Enabled") : TEXT("Disabled"),
-		bAppliedEnableAuth ? TEXT("Enabled") : TEXT("Disabled"));
+		ServerPort.load(), NewConfig->MaxConnections, NewConfig->TimeoutSeconds,
+		NewConfig->bEnableCORS ? TEXT("Enabled") : TEXT("Disabled"),
+		NewConfig->bEnableAuth ? TEXT("Enabled") : TEXT("Disabled"));
+}
+
+FMCPServerStats FMCPJsonRpcServer::GetServerStats() const
+{
+	FMCPServerStats Stats;
+	Stats.ActiveConnections = ConnectedClientCount.GetValue();
+	Stats.ConnectionsAccepted = TotalConnectionsAccepted.GetValue();
+	Stats.LocalConnectionsAccepted = LocalConnectionsAccepted.GetValue();
+	Stats.RequestsServed = TotalRequestsServed.GetValue();
+	Stats.ReusedConnectionRequests = ReusedConnectionRequests.GetValue();
+	Stats.RejectedConnections = RejectedConnections.GetValue();
+	Stats.ResponsesSent = ResponsesSent.GetValue();
+	Stats.ResponseBytesSent = ResponseBytesSent.GetValue();
+	Stats.ResponseBytesCopied = ResponseBytesCopied.GetValue();
+	Stats.ResponseAllocations = ResponseAllocations.GetValue();
+	Stats.StreamedResponses = StreamedResponses.GetValue();
+	Stats.StreamedBodyBytes = StreamedBodyBytes.GetValue();
+	Stats.CompressedResponses = CompressedResponses.GetValue();
+	Stats.CompressionInputBytes = CompressionInputBytes.GetValue();
+	Stats.CompressionOutputBytes = CompressionOutputBytes.GetValue();
+	Stats.CompressionSeconds = FPlatformTime::ToSeconds64(CompressionCycles.GetValue());
+	Stats.BatchRequests = BatchRequests.GetValue();
+	Stats.BatchEntries = BatchEntries.GetValue();
+	Stats.DeferredRequests = DeferredRequests.GetValue();
+	Stats.ToolBatchOperations = ToolBatchOperations.GetValue();
+	Stats.ToolBatchRollbacks = ToolBatchRollbacks.GetValue();
+	Stats.RegistryWorkerReads = RegistryWorkerReads.GetValue();
+	Stats.RegistryGameThreadReads = RegistryGameThreadReads.GetValue();
+	Stats.GameThreadTimeouts = GameThreadTimeouts.GetValue();
+	Stats.RequestsParsed = RequestsParsed.GetValue();
+	Stats.RequestBytesParsed = RequestBytesParsed.GetValue();
+	Stats.RequestParseSeconds = FPlatformTime::ToSeconds64(RequestParseCycles.GetValue());
+	Stats.RequestJsonValues = RequestJsonValues.GetValue();
+	Stats.ResponseJsonValues = ResponseJsonValues.GetValue();
+	Stats.RateLimitHits = RateLimitHits.GetValue();
+	Stats.RateLimitRejects = RateLimitRejects.GetValue();
+	Stats.LastDrainSeconds = FPlatformTime::ToSeconds64(LastDrainCycles.GetValue());
+	Stats.DrainTimeouts = DrainTimeouts.GetValue();
+	Stats.ActiveWebSocketSessions = ActiveWebSocketSessions.GetValue();
+	Stats.WebSocketSessionsOpened = WebSocketSessionsOpened.GetValue();
+	Stats.WebSocketMessagesReceived = WebSocketMessagesReceived.GetValue();
+	Stats.NotificationsSent = NotificationsSent.GetValue();
+	Stats.WorkerPool = WorkerPool.GetStats();
+	Stats.Reactor = Reactor.GetStats();
+	Stats.ResultCache = ResultCache.GetStats();
+	Stats.GameThread = GameThreadQueue.GetStats();
+	Stats.BlueprintRefresh = RefreshScheduler.GetStats();
+	return Stats;
+}
+
+TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> FMCPJsonRpcServer::GetConfig() const
+{
+	FReadScopeLock ReadLock(ConfigLock);
+	return Config;
+}
+
+TSharedPtr<FJsonObject> FMCPJsonRpcServer::CheckRateLimit(const FMCPJsonRpcEnvelope& Request)
+{
+	const TSharedRef<FMCPRateLimiter, ESPMode::ThreadSafe> Limiter = GetConfig()->RateLimiter;
+	if (!Limiter->IsEnabled())
+	{
+		return nullptr;
+	}
+
+	// Charged by what the method is registered as, so write methods outside tools.* (and those
+	// other modules register) share the mutation bucket. Unknown methods fail cheaply as reads.
+	const FMCPMethodRegistry::FDescriptorPtr Descriptor = FindMethod(Request.Method);
+	const EMCPRateClass RateClass = Descriptor.IsValid() && Descriptor->Access == EMCPMethodAccess::Write
+		? EMCPRateClass::Mutation
+		: EMCPRateClass::Read;
+
+	const int32 Cost = Descriptor.IsValid() && Descriptor->RateCost ? FMath::Max(Descriptor->RateCost(Request.Params), 1) : 1;
+	const int32 Capacity = Limiter->GetCapacity(RateClass);
+
+	RateLimitHits.Increment();
+	double RetryAfterSeconds = 0.0;
+	if (Cost <= Capacity && Limiter->TryAcquire(RateClass, Cost, RetryAfterSeconds))
+	{
+		return nullptr;
+	}
+	RateLimitRejects.Increment();
+
+	// -32029 is in the implementation-defined server error range; 29 echoes HTTP 429. A request
+	// costing more than the bucket holds gets no retry hint, since waiting would not help.
+	TSharedPtr<FJsonObject> Response = Cost > Capacity
+		? CreateErrorResponse(-32029, FString::Printf(TEXT("Rate limit exceeded - request costs %d tokens, the limit allows at most %d at once"), Cost, Capacity), Request.Id)
+		: CreateErrorResponse(-32029, TEXT("Rate limit exceeded"), Request.Id);
+	TSharedPtr<FJsonObject> Data = MakeShareable(new FJsonObject);
+	if (Cost <= Capacity)
+	{
+		Data->SetNumberField(TEXT("retry_after_ms"), FMath::CeilToInt(RetryAfterSeconds * 1000.0));
+	}
+	Data->SetNumberField(TEXT("cost"), Cost);
+	Data->SetNumberField(TEXT("capacity"), Capacity);
+	Data->SetStringField(TEXT("limit"), RateClass == EMCPRateClass::Mutation ? TEXT("mutation") : TEXT("read"));
+	Response->GetObjectField(TEXT("error"))->SetObjectField(TEXT("data"), Data);
+	return Response;
 }
 
 FString FMCPJsonRpcServer::GetAppliedSettingsString() const
 {
-	return FString::Printf(TEXT("Applied Settings - Port: %d, Max Connections: %d, Timeout: %ds, CORS: %s, Auth: %s, Custom Headers: %d"),
-		ServerPort, AppliedMaxConnections, AppliedTimeoutSeconds,
-		bAppliedEnableCORS ? TEXT("Enabled") : TEXT("Disabled"),
-		bAppliedEnableAuth ? TEXT("Enabled") : TEXT("Disabled"),
-		AppliedCustomHeaders.Num());
+	const TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> AppliedConfig = GetConfig();
+	return FString::Printf(TEXT("Applied Settings - Port: %d, Max Connections: %d, Timeout: %ds, Max Requests/Connection: %d, CORS: %s, Auth: %s, Custom Headers: %d"),
+		ServerPort.load(), AppliedConfig->MaxConnections, AppliedConfig->TimeoutSeconds, AppliedConfig->MaxRequestsPerConnection,
+		AppliedConfig->bEnableCORS ? TEXT("Enabled") : TEXT("Disabled"),
+		AppliedConfig->bEnableAuth ? TEXT("Enabled") : TEXT("Disabled"),
+		AppliedConfig->CustomHeaders.Num());
 }
\ No newline at end of file
@@ -0,0 +1,365 @@
+#include "MCPJsonWriter.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+
+namespace MCPJsonWriter
+{
+	static void AppendUtf8(TArray<uint8>& Out, uint32 CodePoint)
+	{
+		if (CodePoint < 0x800)
+		{
+			Out.Add((uint8)(0xC0 | (CodePoint >> 6)));
+			Out.Add((uint8)(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add((uint8)(0xE0 | (CodePoint >> 12)));
+			Out.Add((uint8)(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add((uint8)(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add((uint8)(0xF0 | (CodePoint >> 18)));
+			Out.Add((uint8)(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add((uint8)(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add((uint8)(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	static bool IsPlainAscii(TCHAR Char)
+	{
+		return Char >= 0x20 && Char < 0x80 && Char != TEXT('"') && Char != TEXT('\\');
+	}
+}
+
+FMCPJsonWriter::FMCPJsonWriter(TArray<uint8>& InOut)
+	: Out(&InOut)
+{
+}
+
+FMCPJsonWriter::FMCPJsonWriter(FArchive& InArchive)
+	: Out(&Buffer)
+	, Archive(&InArchive)
+{
+	Buffer.Reserve(FlushBytes * 2);
+}
+
+FMCPJsonWriter::~FMCPJsonWriter()
+{
+	Close();
+}
+
+void FMCPJsonWriter::Close()
+{
+	if (Archive && Buffer.Num() > 0)
+	{
+		Archive->Serialize(Buffer.GetData(), Buffer.Num());
+		Buffer.Reset();
+	}
+}
+
+void FMCPJsonWriter::FlushIfFull()
+{
+	if (Archive && Buffer.Num() >= FlushBytes)
+	{
+		Archive->Serialize(Buffer.GetData(), Buffer.Num());
+		Buffer.Reset();
+	}
+}
+
+void FMCPJsonWriter::BeginValue()
+{
+	FlushIfFull();
+	if (bNeedsComma)
+	{
+		Out->Add(',');
+	}
+	bNeedsComma = true;
+}
+
+void FMCPJsonWriter::WriteObjectStart()
+{
+	BeginValue();
+	Out->Add('{');
+	bNeedsComma = false;
+}
+
+void FMCPJsonWriter::WriteObjectStart(FStringView Key)
+{
+	WriteIdentifierPrefix(Key);
+	WriteObjectStart();
+}
+
+void FMCPJsonWriter::WriteObjectEnd()
+{
+	Out->Add('}');
+	bNeedsComma = true;
+}
+
+void FMCPJsonWriter::WriteArrayStart()
+{
+	BeginValue();
+	Out->Add('[');
+	bNeedsComma = false;
+}
+
+void FMCPJsonWriter::WriteArrayStart(FStringView Key)
+{
+	WriteIdentifierPrefix(Key);
+	WriteArrayStart();
+}
+
+void FMCPJsonWriter::WriteArrayEnd()
+{
+	Out->Add(']');
+	bNeedsComma = true;
+}
+
+void FMCPJsonWriter::WriteIdentifierPrefix(FStringView Key)
+{
+	BeginValue();
+	WriteString(Key);
+	Out->Add(':');
+	bNeedsComma = false;
+}
+
+void FMCPJsonWriter::WriteValue(FStringView Value)
+{
+	BeginValue();
+	WriteString(Value);
+}
+
+void FMCPJsonWriter::WriteValue(FName Value)
+{
+	Value.AppendString(Scratch);
+	WriteScratch();
+}
+
+void FMCPJsonWriter::WriteValue(bool bValue)
+{
+	BeginValue();
+	if (bValue)
+	{
+		WriteAscii("true", 4);
+	}
+	else
+	{
+		WriteAscii("false", 5);
+	}
+}
+
+void FMCPJsonWriter::WriteValue(int64 Value)
+{
+	BeginValue();
+	ANSICHAR Digits[32];
+	WriteAscii(Digits, FCStringAnsi::Snprintf(Digits, UE_ARRAY_COUNT(Digits), "%lld", (long long)Value));
+}
+
+void FMCPJsonWriter::WriteValue(double Value)
+{
+	// JSON has no representation for infinities or NaN
+	if (!FMath::IsFinite(Value))
+	{
+		WriteNull();
+		return;
+	}
+
+	// Whole numbers, which most counters are, print as integers; anything else gets the shortest
+	// of 15 or 17 significant digits that reads back exactly
+	if (FMath::Abs(Value) < 9007199254740992.0 && FMath::Frac(Value) == 0.0)
+	{
+		WriteValue((int64)Value);
+		return;
+	}
+
+	BeginValue();
+	ANSICHAR Digits[32];
+	int32 Length = FCStringAnsi::Snprintf(Digits, UE_ARRAY_COUNT(Digits), "%.15g", Value);
+	if (FCStringAnsi::Atod(Digits) != Value)
+	{
+		Length = FCStringAnsi::Snprintf(Digits, UE_ARRAY_COUNT(Digits), "%.17g", Value);
+	}
+	WriteAscii(Digits, Length);
+}
+
+void FMCPJsonWriter::WriteNull()
+{
+	BeginValue();
+	WriteAscii("null", 4);
+}
+
+void FMCPJsonWriter::WriteValue(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	++JsonValuesWritten;
+	switch (Value->Type)
+	{
+	case EJson::String:
+		WriteValue(FStringView(Value->AsString()));
+		break;
+	case EJson::Number:
+		WriteValue(Value->AsNumber());
+		break;
+	case EJson::Boolean:
+		WriteValue(Value->AsBool());
+		break;
+	case EJson::Array:
+		WriteArrayStart();
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			WriteValue(Element);
+		}
+		WriteArrayEnd();
+		break;
+	case EJson::Object:
+		if (const TSharedPtr<FJsonObject>& Object = Value->AsObject())
+		{
+			WriteValue(*Object);
+		}
+		else
+		{
+			WriteNull();
+		}
+		break;
+	default:
+		WriteNull();
+		break;
+	}
+}
+
+void FMCPJsonWriter::WriteValue(const FJsonObject& Object)
+{
+	WriteObjectStart();
+	WriteObjectMembers(Object);
+	WriteObjectEnd();
+}
+
+void FMCPJsonWriter::WriteObjectMembers(const FJsonObject& Object)
+{
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Member : Object.Values)
+	{
+		WriteIdentifierPrefix(Member.Key);
+		WriteValue(Member.Value);
+	}
+}
+
+void FMCPJsonWriter::WriteRawValue(FUtf8StringView Json)
+{
+	BeginValue();
+	Out->Append((const uint8*)Json.GetData(), Json.Len());
+}
+
+void FMCPJsonWriter::WriteAsset(const FAssetData& AssetData)
+{
+	WriteObjectStart();
+	WriteAssetFields(AssetData);
+	WriteObjectEnd();
+}
+
+void FMCPJsonWriter::WriteAssetFields(const FAssetData& AssetData)
+{
+	WriteValue(TEXT("name"), AssetData.AssetName);
+
+	WriteIdentifierPrefix(TEXT("path"));
+	AssetData.AppendObjectPath(Scratch);
+	WriteScratch();
+
+	WriteIdentifierPrefix(TEXT("class"));
+	AssetData.AssetClassPath.AppendString(Scratch);
+	WriteScratch();
+
+	WriteValue(TEXT("package"), AssetData.PackageName);
+}
+
+void FMCPJsonWriter::WriteVariable(const FBPVariableDescription& Variable)
+{
+	WriteObjectStart();
+	WriteValue(TEXT("name"), Variable.VarName);
+	WriteValue(TEXT("type"), Variable.VarType.PinCategory);
+	WriteValue(TEXT("is_public"), (Variable.PropertyFlags & CPF_BlueprintVisible) != 0);
+	WriteObjectEnd();
+}
+
+void FMCPJsonWriter::WriteGraph(const UEdGraph& Graph)
+{
+	WriteObjectStart();
+	WriteValue(TEXT("name"), Graph.GetFName());
+	WriteObjectEnd();
+}
+
+void FMCPJsonWriter::WriteScratch()
+{
+	BeginValue();
+	WriteString(Scratch.ToView());
+	Scratch.Reset();
+}
+
+void FMCPJsonWriter::WriteAscii(const ANSICHAR* Text, int32 Length)
+{
+	Out->Append((const uint8*)Text, Length);
+}
+
+void FMCPJsonWriter::WriteString(FStringView Text)
+{
+	Out->Add('"');
+	const TCHAR* Char = Text.GetData();
+	const TCHAR* TextEnd = Char + Text.Len();
+	while (Char < TextEnd)
+	{
+		// Plain ASCII, nearly all of what the server writes, is copied a run at a time
+		const TCHAR* RunStart = Char;
+		while (Char < TextEnd && MCPJsonWriter::IsPlainAscii(*Char))
+		{
+			++Char;
+		}
+		if (Char > RunStart)
+		{
+			const int32 RunLength = (int32)(Char - RunStart);
+			uint8* Dest = Out->GetData() + Out->AddUninitialized(RunLength);
+			for (int32 Index = 0; Index < RunLength; ++Index)
+			{
+				Dest[Index] = (uint8)RunStart[Index];
+			}
+		}
+		if (Char == TextEnd)
+		{
+			break;
+		}
+
+		uint32 CodePoint = (uint32)*Char++;
+		switch (CodePoint)
+		{
+		case '"': WriteAscii("\\\"", 2); continue;
+		case '\\': WriteAscii("\\\\", 2); continue;
+		case '\b': WriteAscii("\\b", 2); continue;
+		case '\f': WriteAscii("\\f", 2); continue;
+		case '\n': WriteAscii("\\n", 2); continue;
+		case '\r': WriteAscii("\\r", 2); continue;
+		case '\t': WriteAscii("\\t", 2); continue;
+		default: break;
+		}
+
+		if (CodePoint < 0x20)
+		{
+			ANSICHAR Escape[8];
+			WriteAscii(Escape, FCStringAnsi::Snprintf(Escape, UE_ARRAY_COUNT(Escape), "\\u%04x", CodePoint));
+			continue;
+		}
+
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Char < TextEnd && (uint32)*Char >= 0xDC00 && (uint32)*Char <= 0xDFFF)
+		{
+			CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + ((uint32)*Char++ - 0xDC00);
+		}
+		// Unpaired surrogates cannot be encoded as UTF-8
+		MCPJsonWriter::AppendUtf8(*Out, (CodePoint >= 0xD800 && CodePoint <= 0xDFFF) ? 0xFFFD : CodePoint);
+	}
+	Out->Add('"');
+}
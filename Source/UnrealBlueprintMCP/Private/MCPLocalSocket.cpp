@@ -0,0 +1,712 @@
+#include "MCPLocalSocket.h"
+#include "HAL/FileManager.h"
+
+#define MCP_HAS_LOCAL_SOCKETS (PLATFORM_WINDOWS || PLATFORM_UNIX || PLATFORM_MAC)
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif MCP_HAS_LOCAL_SOCKETS
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const FName FMCPLocalSocket::ProtocolName(TEXT("MCPLocal"));
+const FName FMCPLocalSocket::LoopbackProtocolName(TEXT("MCPLoopback"));
+
+#if MCP_HAS_LOCAL_SOCKETS
+namespace MCPLocalSocket
+{
+#if PLATFORM_WINDOWS
+	typedef SOCKET FNativeSocket;
+	typedef int FSockLen;
+	static const UPTRINT InvalidHandle = (UPTRINT)INVALID_SOCKET;
+
+	static int CloseNative(FNativeSocket Socket) { return closesocket(Socket); }
+	static int PollNative(pollfd* Fds, int Count, int TimeoutMs) { return WSAPoll(Fds, Count, TimeoutMs); }
+	static constexpr int SendFlags = 0;
+#else
+	typedef int FNativeSocket;
+	typedef socklen_t FSockLen;
+	static const UPTRINT InvalidHandle = (UPTRINT)-1;
+
+	static int CloseNative(FNativeSocket Socket) { return close(Socket); }
+	static int PollNative(pollfd* Fds, int Count, int TimeoutMs) { return poll(Fds, Count, TimeoutMs); }
+#if defined(MSG_NOSIGNAL)
+	// A peer that hung up must surface as a send error, not SIGPIPE
+	static constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+	static constexpr int SendFlags = 0;
+#endif
+#endif
+
+	static FNativeSocket ToNative(UPTRINT Handle)
+	{
+		return (FNativeSocket)Handle;
+	}
+
+	static bool MakeAddress(const FString& Path, sockaddr_un& OutAddress)
+	{
+		FMemory::Memzero(OutAddress);
+		OutAddress.sun_family = AF_UNIX;
+
+		FTCHARToUTF8 Utf8Path(*Path, Path.Len());
+		if (Utf8Path.Length() == 0 || Utf8Path.Length() >= (int32)sizeof(OutAddress.sun_path))
+		{
+			return false;
+		}
+		FMemory::Memcpy(OutAddress.sun_path, Utf8Path.Get(), Utf8Path.Length());
+		return true;
+	}
+
+	static void DisableSigPipe(FNativeSocket Socket)
+	{
+#if PLATFORM_MAC
+		const int NoSigPipe = 1;
+		setsockopt(Socket, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+	}
+
+	static UPTRINT CreateStreamSocket(int Family = AF_UNIX)
+	{
+		const FNativeSocket Socket = socket(Family, SOCK_STREAM, 0);
+		if ((UPTRINT)Socket != InvalidHandle)
+		{
+			DisableSigPipe(Socket);
+		}
+		return (UPTRINT)Socket;
+	}
+
+	static sockaddr_in MakeLoopbackAddress(int32 Port)
+	{
+		sockaddr_in Address;
+		FMemory::Memzero(Address);
+		Address.sin_family = AF_INET;
+		Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		Address.sin_port = htons((uint16)Port);
+		return Address;
+	}
+
+	/** Local or peer address of a TCP socket; false for Unix domain sockets */
+	static bool GetInetAddress(FNativeSocket Socket, bool bPeer, sockaddr_in& OutAddress)
+	{
+		FSockLen Length = sizeof(OutAddress);
+		const int Result = bPeer
+			? getpeername(Socket, (sockaddr*)&OutAddress, &Length)
+			: getsockname(Socket, (sockaddr*)&OutAddress, &Length);
+		return Result == 0 && OutAddress.sin_family == AF_INET;
+	}
+
+	static short ToPollEvents(ESocketWaitConditions::Type Condition)
+	{
+		switch (Condition)
+		{
+		case ESocketWaitConditions::WaitForRead:
+			return POLLIN;
+		case ESocketWaitConditions::WaitForWrite:
+			return POLLOUT;
+		default:
+			return POLLIN | POLLOUT;
+		}
+	}
+}
+#endif
+
+FMCPLocalSocket::FMCPLocalSocket(UPTRINT InHandle, const FString& InSocketDescription, const FName& InProtocol)
+	: FSocket(SOCKTYPE_Streaming, InSocketDescription, InProtocol)
+	, Handle(InHandle)
+{
+}
+
+FMCPLocalSocket::~FMCPLocalSocket()
+{
+	Close();
+}
+
+bool FMCPLocalSocket::IsLocalSocket(const FSocket* Socket)
+{
+	return Socket && (Socket->GetProtocol() == ProtocolName || Socket->GetProtocol() == LoopbackProtocolName);
+}
+
+bool FMCPLocalSocket::IsSupported()
+{
+	return MCP_HAS_LOCAL_SOCKETS != 0;
+}
+
+int32 FMCPLocalSocket::GetMaxPathLength()
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	return (int32)sizeof(sockaddr_un::sun_path) - 1;
+#else
+	return 0;
+#endif
+}
+
+FMCPLocalSocket* FMCPLocalSocket::CreateListener(const FString& Path, int32 MaxBacklog, FString& OutError)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	sockaddr_un Address;
+	if (!MCPLocalSocket::MakeAddress(Path, Address))
+	{
+		OutError = FString::Printf(TEXT("Socket path must be 1-%d bytes: %s"), GetMaxPathLength(), *Path);
+		return nullptr;
+	}
+
+	// A leftover socket file makes bind() fail; only remove it if nobody answers on it
+	if (IFileManager::Get().GetStatData(*Path).bIsValid)
+	{
+		if (FMCPLocalSocket* Existing = ConnectTo(Path))
+		{
+			delete Existing;
+			OutError = FString::Printf(TEXT("Another server is already listening on %s"), *Path);
+			return nullptr;
+		}
+		DeleteSocketFile(Path);
+	}
+
+	const UPTRINT Handle = MCPLocalSocket::CreateStreamSocket();
+	if (Handle == MCPLocalSocket::InvalidHandle)
+	{
+		OutError = TEXT("Failed to create Unix domain socket");
+		return nullptr;
+	}
+
+	FMCPLocalSocket* Listener = new FMCPLocalSocket(Handle, TEXT("MCPJsonRpcLocalServer"), ProtocolName);
+	if (bind(MCPLocalSocket::ToNative(Handle), (const sockaddr*)&Address, sizeof(Address)) != 0)
+	{
+		OutError = FString::Printf(TEXT("Failed to bind Unix domain socket %s"), *Path);
+		delete Listener;
+		return nullptr;
+	}
+
+#if !PLATFORM_WINDOWS
+	// Same trust boundary as the TCP listener's 127.0.0.1 bind: only this user may connect
+	chmod(Address.sun_path, S_IRUSR | S_IWUSR);
+#endif
+
+	if (!Listener->Listen(MaxBacklog))
+	{
+		OutError = FString::Printf(TEXT("Failed to listen on Unix domain socket %s"), *Path);
+		delete Listener;
+		DeleteSocketFile(Path);
+		return nullptr;
+	}
+	return Listener;
+#else
+	OutError = TEXT("Unix domain sockets are not supported on this platform");
+	return nullptr;
+#endif
+}
+
+FMCPLocalSocket* FMCPLocalSocket::CreateTcpListener(int32 Port, int32 MaxBacklog, FString& OutError)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	const UPTRINT Handle = MCPLocalSocket::CreateStreamSocket(AF_INET);
+	if (Handle == MCPLocalSocket::InvalidHandle)
+	{
+		OutError = TEXT("Failed to create server socket");
+		return nullptr;
+	}
+
+	FMCPLocalSocket* Listener = new FMCPLocalSocket(Handle, TEXT("MCPJsonRpcServer"), LoopbackProtocolName);
+	Listener->SetReuseAddr(true);
+
+	// Only bind to localhost: no external network access
+	const sockaddr_in Address = MCPLocalSocket::MakeLoopbackAddress(Port);
+	if (bind(MCPLocalSocket::ToNative(Handle), (const sockaddr*)&Address, sizeof(Address)) != 0)
+	{
+		OutError = FString::Printf(TEXT("Failed to bind to port %d"), Port);
+		delete Listener;
+		return nullptr;
+	}
+
+	if (!Listener->Listen(MaxBacklog))
+	{
+		OutError = TEXT("Failed to listen on socket");
+		delete Listener;
+		return nullptr;
+	}
+	return Listener;
+#else
+	OutError = TEXT("Native sockets are not supported on this platform");
+	return nullptr;
+#endif
+}
+
+bool FMCPLocalSocket::CreatePair(FMCPLocalSocket*& OutFirst, FMCPLocalSocket*& OutSecond)
+{
+	OutFirst = nullptr;
+	OutSecond = nullptr;
+#if PLATFORM_WINDOWS
+	// No socketpair() on Windows; connect through a throwaway loopback listener instead
+	FString Error;
+	FMCPLocalSocket* Listener = CreateTcpListener(0, 1, Error);
+	if (!Listener)
+	{
+		return false;
+	}
+
+	sockaddr_in Address;
+	const UPTRINT Handle = MCPLocalSocket::CreateStreamSocket(AF_INET);
+	if (Handle != MCPLocalSocket::InvalidHandle && MCPLocalSocket::GetInetAddress(MCPLocalSocket::ToNative(Listener->Handle), false, Address))
+	{
+		OutFirst = new FMCPLocalSocket(Handle, TEXT("MCPJsonRpcPair"), LoopbackProtocolName);
+		if (connect(MCPLocalSocket::ToNative(Handle), (const sockaddr*)&Address, sizeof(Address)) == 0)
+		{
+			OutSecond = static_cast<FMCPLocalSocket*>(Listener->Accept(TEXT("MCPJsonRpcPair")));
+		}
+	}
+	else if (Handle != MCPLocalSocket::InvalidHandle)
+	{
+		MCPLocalSocket::CloseNative(MCPLocalSocket::ToNative(Handle));
+	}
+	delete Listener;
+#elif MCP_HAS_LOCAL_SOCKETS
+	int Handles[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, Handles) == 0)
+	{
+		MCPLocalSocket::DisableSigPipe(Handles[0]);
+		MCPLocalSocket::DisableSigPipe(Handles[1]);
+		OutFirst = new FMCPLocalSocket((UPTRINT)Handles[0], TEXT("MCPJsonRpcPair"), ProtocolName);
+		OutSecond = new FMCPLocalSocket((UPTRINT)Handles[1], TEXT("MCPJsonRpcPair"), ProtocolName);
+	}
+#endif
+
+	if (!OutFirst || !OutSecond)
+	{
+		delete OutFirst;
+		delete OutSecond;
+		OutFirst = nullptr;
+		OutSecond = nullptr;
+		return false;
+	}
+	return true;
+}
+
+int32 FMCPLocalSocket::Poll(TArrayView<FMCPPollEntry> Entries, FTimespan WaitTime)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	TArray<pollfd, TInlineAllocator<64>> PollFds;
+	PollFds.SetNumUninitialized(Entries.Num());
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		PollFds[Index].fd = MCPLocalSocket::ToNative(Entries[Index].Socket->Handle);
+		PollFds[Index].events = MCPLocalSocket::ToPollEvents(Entries[Index].Condition);
+		PollFds[Index].revents = 0;
+	}
+
+	const int TimeoutMs = WaitTime < FTimespan::Zero()
+		? -1
+		: (int)FMath::Clamp<int64>((int64)WaitTime.GetTotalMilliseconds(), 0, MAX_int32);
+	const int Result = MCPLocalSocket::PollNative(PollFds.GetData(), PollFds.Num(), TimeoutMs);
+	if (Result < 0)
+	{
+		return -1;
+	}
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		Entries[Index].bReady = PollFds[Index].revents != 0;
+	}
+	return Result;
+#else
+	return -1;
+#endif
+}
+
+FMCPLocalSocket* FMCPLocalSocket::ConnectTo(const FString& Path)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	sockaddr_un Address;
+	if (!MCPLocalSocket::MakeAddress(Path, Address))
+	{
+		return nullptr;
+	}
+
+	const UPTRINT Handle = MCPLocalSocket::CreateStreamSocket();
+	if (Handle == MCPLocalSocket::InvalidHandle)
+	{
+		return nullptr;
+	}
+
+	FMCPLocalSocket* Socket = new FMCPLocalSocket(Handle, TEXT("MCPJsonRpcLocalClient"), ProtocolName);
+	if (connect(MCPLocalSocket::ToNative(Handle), (const sockaddr*)&Address, sizeof(Address)) != 0)
+	{
+		delete Socket;
+		return nullptr;
+	}
+	return Socket;
+#else
+	return nullptr;
+#endif
+}
+
+void FMCPLocalSocket::DeleteSocketFile(const FString& Path)
+{
+#if PLATFORM_WINDOWS
+	IFileManager::Get().Delete(*Path, false, true, true);
+#elif MCP_HAS_LOCAL_SOCKETS
+	// IFileManager only deletes regular files
+	FTCHARToUTF8 Utf8Path(*Path);
+	unlink(Utf8Path.Get());
+#endif
+}
+
+bool FMCPLocalSocket::Shutdown(ESocketShutdownMode Mode)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+#if PLATFORM_WINDOWS
+	const int How = Mode == ESocketShutdownMode::Read ? SD_RECEIVE : Mode == ESocketShutdownMode::Write ? SD_SEND : SD_BOTH;
+#else
+	const int How = Mode == ESocketShutdownMode::Read ? SHUT_RD : Mode == ESocketShutdownMode::Write ? SHUT_WR : SHUT_RDWR;
+#endif
+	return shutdown(MCPLocalSocket::ToNative(Handle), How) == 0;
+#else
+	return false;
+#endif
+}
+
+bool FMCPLocalSocket::Close()
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	if (Handle != MCPLocalSocket::InvalidHandle)
+	{
+		const bool bClosed = MCPLocalSocket::CloseNative(MCPLocalSocket::ToNative(Handle)) == 0;
+		Handle = MCPLocalSocket::InvalidHandle;
+		return bClosed;
+	}
+#endif
+	return false;
+}
+
+bool FMCPLocalSocket::Bind(const FInternetAddr& Addr)
+{
+	// Listeners are bound in CreateListener() and CreateTcpListener()
+	return false;
+}
+
+bool FMCPLocalSocket::Connect(const FInternetAddr& Addr)
+{
+	// Local sockets connect by path in ConnectTo()
+	return false;
+}
+
+bool FMCPLocalSocket::Listen(int32 MaxBacklog)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	return listen(MCPLocalSocket::ToNative(Handle), MaxBacklog) == 0;
+#else
+	return false;
+#endif
+}
+
+bool FMCPLocalSocket::WaitForPendingConnection(bool& bHasPendingConnection, const FTimespan& WaitTime)
+{
+	bHasPendingConnection = Wait(ESocketWaitConditions::WaitForRead, WaitTime);
+	return true;
+}
+
+bool FMCPLocalSocket::HasPendingConnection(bool& bHasPendingConnection)
+{
+	bHasPendingConnection = Wait(ESocketWaitConditions::WaitForRead, FTimespan::Zero());
+	return true;
+}
+
+bool FMCPLocalSocket::HasPendingData(uint32& PendingDataSize)
+{
+	PendingDataSize = 0;
+#if PLATFORM_WINDOWS
+	u_long Available = 0;
+	if (ioctlsocket(MCPLocalSocket::ToNative(Handle), FIONREAD, &Available) == 0)
+	{
+		PendingDataSize = (uint32)Available;
+	}
+#elif MCP_HAS_LOCAL_SOCKETS
+	int Available = 0;
+	if (ioctl(MCPLocalSocket::ToNative(Handle), FIONREAD, &Available) == 0)
+	{
+		PendingDataSize = (uint32)FMath::Max(Available, 0);
+	}
+#endif
+	return PendingDataSize > 0;
+}
+
+FSocket* FMCPLocalSocket::Accept(const FString& InSocketDescription)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	const MCPLocalSocket::FNativeSocket Client = accept(MCPLocalSocket::ToNative(Handle), nullptr, nullptr);
+	if ((UPTRINT)Client != MCPLocalSocket::InvalidHandle)
+	{
+		MCPLocalSocket::DisableSigPipe(Client);
+		return new FMCPLocalSocket((UPTRINT)Client, InSocketDescription, GetProtocol());
+	}
+#endif
+	return nullptr;
+}
+
+FSocket* FMCPLocalSocket::Accept(FInternetAddr& OutAddr, const FString& InSocketDescription)
+{
+	// Unix domain peers have no IP address; OutAddr is left untouched for them
+	FSocket* Client = Accept(InSocketDescription);
+	if (Client)
+	{
+		Client->GetPeerAddress(OutAddr);
+	}
+	return Client;
+}
+
+bool FMCPLocalSocket::SendTo(const uint8* Data, int32 Count, int32& BytesSent, const FInternetAddr& Destination)
+{
+	return Send(Data, Count, BytesSent);
+}
+
+bool FMCPLocalSocket::Send(const uint8* Data, int32 Count, int32& BytesSent)
+{
+	BytesSent = 0;
+#if MCP_HAS_LOCAL_SOCKETS
+	const int Result = (int)send(MCPLocalSocket::ToNative(Handle), (const char*)Data, Count, MCPLocalSocket::SendFlags);
+	if (Result >= 0)
+	{
+		BytesSent = Result;
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool FMCPLocalSocket::RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInternetAddr& Source, ESocketReceiveFlags::Type Flags)
+{
+	return Recv(Data, BufferSize, BytesRead, Flags);
+}
+
+bool FMCPLocalSocket::Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketReceiveFlags::Type Flags)
+{
+	BytesRead = 0;
+#if MCP_HAS_LOCAL_SOCKETS
+	int NativeFlags = 0;
+	NativeFlags |= (Flags & ESocketReceiveFlags::Peek) ? MSG_PEEK : 0;
+	NativeFlags |= (Flags & ESocketReceiveFlags::WaitAll) ? MSG_WAITALL : 0;
+
+	// Like the BSD sockets: false on error (including would-block), true with 0 bytes when the peer closed
+	const int Result = (int)recv(MCPLocalSocket::ToNative(Handle), (char*)Data, BufferSize, NativeFlags);
+	if (Result >= 0)
+	{
+		BytesRead = Result;
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool FMCPLocalSocket::Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	pollfd PollFd;
+	PollFd.fd = MCPLocalSocket::ToNative(Handle);
+	PollFd.events = MCPLocalSocket::ToPollEvents(Condition);
+	PollFd.revents = 0;
+
+	const int TimeoutMs = (int)FMath::Clamp<int64>((int64)WaitTime.GetTotalMilliseconds(), 0, MAX_int32);
+	// Hang-up and errors count as ready so the caller's Recv/Send observes them
+	return MCPLocalSocket::PollNative(&PollFd, 1, TimeoutMs) > 0 && PollFd.revents != 0;
+#else
+	return false;
+#endif
+}
+
+ESocketConnectionState FMCPLocalSocket::GetConnectionState()
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	if (Handle == MCPLocalSocket::InvalidHandle)
+	{
+		return SCS_NotConnected;
+	}
+
+	pollfd PollFd;
+	PollFd.fd = MCPLocalSocket::ToNative(Handle);
+	PollFd.events = POLLOUT;
+	PollFd.revents = 0;
+	if (MCPLocalSocket::PollNative(&PollFd, 1, 0) < 0 || (PollFd.revents & (POLLERR | POLLHUP)) != 0)
+	{
+		return SCS_ConnectionError;
+	}
+	return SCS_Connected;
+#else
+	return SCS_NotConnected;
+#endif
+}
+
+void FMCPLocalSocket::GetAddress(FInternetAddr& OutAddr)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	sockaddr_in Address;
+	if (MCPLocalSocket::GetInetAddress(MCPLocalSocket::ToNative(Handle), false, Address))
+	{
+		OutAddr.SetIp(ntohl(Address.sin_addr.s_addr));
+		OutAddr.SetPort(ntohs(Address.sin_port));
+	}
+#endif
+}
+
+bool FMCPLocalSocket::GetPeerAddress(FInternetAddr& OutAddr)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	sockaddr_in Address;
+	if (MCPLocalSocket::GetInetAddress(MCPLocalSocket::ToNative(Handle), true, Address))
+	{
+		OutAddr.SetIp(ntohl(Address.sin_addr.s_addr));
+		OutAddr.SetPort(ntohs(Address.sin_port));
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool FMCPLocalSocket::SetNonBlocking(bool bIsNonBlocking)
+{
+#if PLATFORM_WINDOWS
+	u_long Value = bIsNonBlocking ? 1 : 0;
+	return ioctlsocket(MCPLocalSocket::ToNative(Handle), FIONBIO, &Value) == 0;
+#elif MCP_HAS_LOCAL_SOCKETS
+	const int Flags = fcntl(MCPLocalSocket::ToNative(Handle), F_GETFL, 0);
+	if (Flags == -1)
+	{
+		return false;
+	}
+	const int NewFlags = bIsNonBlocking ? (Flags | O_NONBLOCK) : (Flags & ~O_NONBLOCK);
+	return fcntl(MCPLocalSocket::ToNative(Handle), F_SETFL, NewFlags) != -1;
+#else
+	return false;
+#endif
+}
+
+bool FMCPLocalSocket::SetBroadcast(bool bAllowBroadcast)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::SetNoDelay(bool bIsNoDelay)
+{
+	// There is no Nagle delay on a Unix domain socket
+	if (GetProtocol() != LoopbackProtocolName)
+	{
+		return true;
+	}
+#if MCP_HAS_LOCAL_SOCKETS
+	const int Value = bIsNoDelay ? 1 : 0;
+	return setsockopt(MCPLocalSocket::ToNative(Handle), IPPROTO_TCP, TCP_NODELAY, (const char*)&Value, sizeof(Value)) == 0;
+#else
+	return false;
+#endif
+}
+
+bool FMCPLocalSocket::JoinMulticastGroup(const FInternetAddr& GroupAddress)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::JoinMulticastGroup(const FInternetAddr& GroupAddress, const FInternetAddr& InterfaceAddress)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::LeaveMulticastGroup(const FInternetAddr& GroupAddress)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::LeaveMulticastGroup(const FInternetAddr& GroupAddress, const FInternetAddr& InterfaceAddress)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::SetMulticastLoopback(bool bLoopback)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::SetMulticastTtl(uint8 TimeToLive)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::SetMulticastInterface(const FInternetAddr& InterfaceAddress)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::SetReuseAddr(bool bAllowReuse)
+{
+	// Stale socket files are handled by CreateListener(). On Windows SO_REUSEADDR would let another
+	// process bind the same port, and a closed listener's port is free again without it anyway.
+#if MCP_HAS_LOCAL_SOCKETS && !PLATFORM_WINDOWS
+	if (GetProtocol() == LoopbackProtocolName)
+	{
+		const int Value = bAllowReuse ? 1 : 0;
+		return setsockopt(MCPLocalSocket::ToNative(Handle), SOL_SOCKET, SO_REUSEADDR, &Value, sizeof(Value)) == 0;
+	}
+#endif
+	return true;
+}
+
+bool FMCPLocalSocket::SetLinger(bool bShouldLinger, int32 Timeout)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::SetRecvErr(bool bUseErrorQueue)
+{
+	return false;
+}
+
+bool FMCPLocalSocket::SetSendBufferSize(int32 Size, int32& NewSize)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	const MCPLocalSocket::FNativeSocket Native = MCPLocalSocket::ToNative(Handle);
+	int Value = Size;
+	MCPLocalSocket::FSockLen ValueSize = sizeof(Value);
+	const bool bSet = setsockopt(Native, SOL_SOCKET, SO_SNDBUF, (const char*)&Value, sizeof(Value)) == 0;
+	getsockopt(Native, SOL_SOCKET, SO_SNDBUF, (char*)&Value, &ValueSize);
+	NewSize = Value;
+	return bSet;
+#else
+	return false;
+#endif
+}
+
+bool FMCPLocalSocket::SetReceiveBufferSize(int32 Size, int32& NewSize)
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	const MCPLocalSocket::FNativeSocket Native = MCPLocalSocket::ToNative(Handle);
+	int Value = Size;
+	MCPLocalSocket::FSockLen ValueSize = sizeof(Value);
+	const bool bSet = setsockopt(Native, SOL_SOCKET, SO_RCVBUF, (const char*)&Value, sizeof(Value)) == 0;
+	getsockopt(Native, SOL_SOCKET, SO_RCVBUF, (char*)&Value, &ValueSize);
+	NewSize = Value;
+	return bSet;
+#else
+	return false;
+#endif
+}
+
+int32 FMCPLocalSocket::GetPortNo()
+{
+#if MCP_HAS_LOCAL_SOCKETS
+	sockaddr_in Address;
+	if (MCPLocalSocket::GetInetAddress(MCPLocalSocket::ToNative(Handle), false, Address))
+	{
+		return ntohs(Address.sin_port);
+	}
+#endif
+	return 0;
+}
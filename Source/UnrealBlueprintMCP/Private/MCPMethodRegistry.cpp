@@ -0,0 +1,97 @@
+#include "MCPMethodRegistry.h"
+#include "Misc/ScopeRWLock.h"
+
+FMCPMethodDescriptor::FMCPMethodDescriptor(FName InName, FMCPMethodHandler InHandler, EMCPMethodThreading InThreading, EMCPMethodAccess InAccess, const FString& InDescription)
+	: Name(InName)
+	, Handler(MoveTemp(InHandler))
+	, Threading(InThreading)
+	, Access(InAccess)
+	, Description(InDescription)
+{
+}
+
+FMCPMethodRegistry& FMCPMethodRegistry::Get()
+{
+	static FMCPMethodRegistry Registry;
+	return Registry;
+}
+
+bool FMCPMethodRegistry::RegisterMethod(const FMCPMethodDescriptor& Descriptor, const void* Owner)
+{
+	if (Descriptor.Name.IsNone() || !Descriptor.HasHandler() || ((Descriptor.TypedHandler || Descriptor.TypedStreamHandler) != (Descriptor.ParamsStruct != nullptr)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MCP Server: Ignoring method registration without a name or handler"));
+		return false;
+	}
+	if (Descriptor.CacheDependency && Descriptor.Access != EMCPMethodAccess::Read)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MCP Server: Ignoring registration of %s; only read methods can be cached"), *Descriptor.Name.ToString());
+		return false;
+	}
+
+	FDescriptorRef Shared = MakeShared<FMCPMethodDescriptor, ESPMode::ThreadSafe>(Descriptor);
+
+	FWriteScopeLock Lock(MethodsLock);
+	Methods.Add(Descriptor.Name, FEntry{ MoveTemp(Shared), Owner });
+	return true;
+}
+
+bool FMCPMethodRegistry::UnregisterMethod(FName Name)
+{
+	FWriteScopeLock Lock(MethodsLock);
+	return Methods.Remove(Name) > 0;
+}
+
+void FMCPMethodRegistry::UnregisterAll(const void* Owner)
+{
+	FWriteScopeLock Lock(MethodsLock);
+	for (auto It = Methods.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Owner == Owner)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FMCPMethodRegistry::FDescriptorPtr FMCPMethodRegistry::FindMethod(FName Name) const
+{
+	FReadScopeLock Lock(MethodsLock);
+	const FEntry* Entry = Methods.Find(Name);
+	return Entry ? FDescriptorPtr(Entry->Descriptor) : FDescriptorPtr();
+}
+
+FMCPMethodRegistry::FDescriptorPtr FMCPMethodRegistry::FindMethod(const FString& Name) const
+{
+	// Client input must not grow the name table; a name that was never created cannot be registered
+	const FName Found(*Name, FNAME_Find);
+	return Found.IsNone() ? FDescriptorPtr() : FindMethod(Found);
+}
+
+TArray<FMCPMethodRegistry::FDescriptorRef> FMCPMethodRegistry::GetMethods() const
+{
+	TArray<FDescriptorRef> Result;
+	{
+		FReadScopeLock Lock(MethodsLock);
+		Result.Reserve(Methods.Num());
+		for (const TPair<FName, FEntry>& Pair : Methods)
+		{
+			Result.Add(Pair.Value.Descriptor);
+		}
+	}
+	Result.Sort([](const FDescriptorRef& A, const FDescriptorRef& B)
+	{
+		return A->Name.LexicalLess(B->Name);
+	});
+	return Result;
+}
+
+const TCHAR* FMCPMethodRegistry::LexThreading(EMCPMethodThreading Threading)
+{
+	return Threading == EMCPMethodThreading::GameThread ? TEXT("game_thread") : TEXT("any_thread");
+}
+
+const TCHAR* FMCPMethodRegistry::LexAccess(EMCPMethodAccess Access)
+{
+	return Access == EMCPMethodAccess::Write ? TEXT("write") : TEXT("read");
+}
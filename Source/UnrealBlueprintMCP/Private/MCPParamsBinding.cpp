@@ -0,0 +1,313 @@
+#include "MCPParamsBinding.h"
+#include "MCPJsonReader.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace MCPParamsBinding
+{
+	/** Field names are ASCII, so a byte-wise compare against the UTF-8 key is exact */
+	static bool MatchesKey(const FString& JsonName, FUtf8StringView Key)
+	{
+		if (JsonName.Len() != Key.Len())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Key.Len(); ++Index)
+		{
+			if (JsonName[Index] != (TCHAR)(uint8)Key[Index])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Malformed JSON inside params; the server checks syntax before decoding, so this is rare */
+	static bool ReaderFailed(const FMCPJsonReader& Reader, FString& OutError)
+	{
+		OutError = FString::Printf(TEXT("Invalid params - %s"), *Reader.GetError());
+		return false;
+	}
+}
+
+bool FMCPParamsBinding::Decode(const UScriptStruct* Struct, void* Out, FUtf8StringView Params, FString& OutError)
+{
+	static const UTF8CHAR EmptyObject[] = { '{', '}' };
+	FMCPJsonReader Reader(Params.IsEmpty() ? FUtf8StringView(EmptyObject, 2) : Params);
+	if (Reader.Peek() != EMCPJsonToken::Object)
+	{
+		OutError = TEXT("Invalid params - params must be an object");
+		return false;
+	}
+
+	FString Path;
+	if (!DecodeObject(Struct, Out, Reader, Path, OutError))
+	{
+		return false;
+	}
+	return Reader.AtEnd() || MCPParamsBinding::ReaderFailed(Reader, OutError);
+}
+
+FString FMCPParamsBinding::GetJsonName(const FProperty* Property)
+{
+	FString Name = Property->GetName();
+	if (CastField<FBoolProperty>(Property) && Name.Len() > 1 && Name[0] == TEXT('b') && FChar::IsUpper(Name[1]))
+	{
+		Name.RightChopInline(1);
+	}
+
+	FString JsonName;
+	JsonName.Reserve(Name.Len() + 4);
+	for (int32 Index = 0; Index < Name.Len(); ++Index)
+	{
+		const TCHAR Char = Name[Index];
+		if (FChar::IsUpper(Char))
+		{
+			// A new word starts at an upper-case letter that follows a lower-case one or starts a
+			// capitalised word after an acronym ("HTTPPort" -> "http_port")
+			const bool bAfterLower = Index > 0 && !FChar::IsUpper(Name[Index - 1]);
+			const bool bEndsAcronym = Index > 0 && FChar::IsUpper(Name[Index - 1]) && Index + 1 < Name.Len() && FChar::IsLower(Name[Index + 1]);
+			if (bAfterLower || bEndsAcronym)
+			{
+				JsonName.AppendChar(TEXT('_'));
+			}
+			JsonName.AppendChar(FChar::ToLower(Char));
+		}
+		else
+		{
+			JsonName.AppendChar(Char);
+		}
+	}
+	return JsonName;
+}
+
+const TArray<FMCPParamsBinding::FFieldInfo>& FMCPParamsBinding::DescribeFields(const UScriptStruct* Struct)
+{
+	// Native structs live as long as the process, so their tables never need evicting
+	static TMap<const UScriptStruct*, TUniquePtr<TArray<FFieldInfo>>> Schemas;
+	static FRWLock SchemasLock;
+
+	{
+		FReadScopeLock Lock(SchemasLock);
+		if (const TUniquePtr<TArray<FFieldInfo>>* Found = Schemas.Find(Struct))
+		{
+			return **Found;
+		}
+	}
+
+	TUniquePtr<TArray<FFieldInfo>> Schema = MakeUnique<TArray<FFieldInfo>>();
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		FFieldInfo& Field = Schema->AddDefaulted_GetRef();
+		Field.JsonName = GetJsonName(*It);
+		Field.Property = *It;
+		Field.bRequired = It->HasMetaData(TEXT("Required"));
+		Field.bRawJson = It->HasMetaData(TEXT("RawJson")) && CastField<FStrProperty>(*It) != nullptr;
+	}
+
+	FWriteScopeLock Lock(SchemasLock);
+	TUniquePtr<TArray<FFieldInfo>>& Slot = Schemas.FindOrAdd(Struct);
+	if (!Slot)
+	{
+		Slot = MoveTemp(Schema);
+	}
+	return *Slot;
+}
+
+bool FMCPParamsBinding::DecodeObject(const UScriptStruct* Struct, void* Out, FMCPJsonReader& Reader, FString& Path, FString& OutError)
+{
+	const TArray<FFieldInfo>& Fields = DescribeFields(Struct);
+	TBitArray<> Seen(false, Fields.Num());
+
+	// One pass over the members as they are read; params structs are small, so matching by a scan
+	// of the table is cheaper than hashing each name. Path grows and shrinks in place as we descend.
+	const int32 PathLen = Path.Len();
+	FUtf8StringView Key;
+	Reader.BeginObject();
+	while (Reader.NextMember(Key))
+	{
+		int32 FieldIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < Fields.Num(); ++Index)
+		{
+			if (MCPParamsBinding::MatchesKey(Fields[Index].JsonName, Key))
+			{
+				FieldIndex = Index;
+				break;
+			}
+		}
+
+		// Unknown members are ignored and null counts as absent
+		if (FieldIndex == INDEX_NONE || Reader.Peek() == EMCPJsonToken::Null)
+		{
+			if (!Reader.SkipValue())
+			{
+				break;
+			}
+			continue;
+		}
+
+		const FFieldInfo& Field = Fields[FieldIndex];
+		if (PathLen > 0)
+		{
+			Path.AppendChar(TEXT('.'));
+		}
+		Path += Field.JsonName;
+		if (Field.bRawJson)
+		{
+			FUtf8StringView Raw;
+			if (!Reader.SkipValue(&Raw))
+			{
+				return MCPParamsBinding::ReaderFailed(Reader, OutError);
+			}
+			const FUTF8ToTCHAR Text((const ANSICHAR*)Raw.GetData(), Raw.Len());
+			CastFieldChecked<FStrProperty>(Field.Property)->SetPropertyValue_InContainer(Out, FString(Text.Length(), Text.Get()));
+		}
+		else if (!DecodeValue(Field.Property, Field.Property->ContainerPtrToValuePtr<void>(Out), Reader, Path, OutError))
+		{
+			return false;
+		}
+		Path.LeftInline(PathLen, EAllowShrinking::No);
+		Seen[FieldIndex] = true;
+	}
+
+	if (Reader.HasError())
+	{
+		return MCPParamsBinding::ReaderFailed(Reader, OutError);
+	}
+
+	for (int32 Index = 0; Index < Fields.Num(); ++Index)
+	{
+		if (Fields[Index].bRequired && !Seen[Index])
+		{
+			const FString& JsonName = Fields[Index].JsonName;
+			OutError = FString::Printf(TEXT("Invalid params - missing required field '%s%s%s'"), *Path, PathLen > 0 ? TEXT(".") : TEXT(""), *JsonName);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FMCPParamsBinding::DecodeValue(const FProperty* Property, void* ValuePtr, FMCPJsonReader& Reader, FString& Path, FString& OutError)
+{
+	auto Mismatch = [&OutError, &Path](const TCHAR* Expected)
+	{
+		OutError = FString::Printf(TEXT("Invalid params - '%s' must be %s"), *Path, Expected);
+		return false;
+	};
+
+	const EMCPJsonToken Token = Reader.Peek();
+	if (Token == EMCPJsonToken::Error)
+	{
+		Reader.SkipValue();
+		return MCPParamsBinding::ReaderFailed(Reader, OutError);
+	}
+
+	if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+	{
+		if (Token != EMCPJsonToken::String)
+		{
+			return Mismatch(TEXT("a string"));
+		}
+		// Read straight into the property, reusing whatever it has allocated
+		return Reader.ReadString(*StrProperty->GetPropertyValuePtr(ValuePtr)) || MCPParamsBinding::ReaderFailed(Reader, OutError);
+	}
+
+	if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+	{
+		FString Name;
+		if (Token != EMCPJsonToken::String)
+		{
+			return Mismatch(TEXT("a string"));
+		}
+		if (!Reader.ReadString(Name))
+		{
+			return MCPParamsBinding::ReaderFailed(Reader, OutError);
+		}
+		NameProperty->SetPropertyValue(ValuePtr, FName(*Name));
+		return true;
+	}
+
+	if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+	{
+		bool bValue = false;
+		if (Token != EMCPJsonToken::Boolean)
+		{
+			return Mismatch(TEXT("true or false"));
+		}
+		if (!Reader.ReadBool(bValue))
+		{
+			return MCPParamsBinding::ReaderFailed(Reader, OutError);
+		}
+		BoolProperty->SetPropertyValue(ValuePtr, bValue);
+		return true;
+	}
+
+	if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		double Number = 0.0;
+		if (Token != EMCPJsonToken::Number || NumericProperty->IsEnum())
+		{
+			return Mismatch(TEXT("a number"));
+		}
+		if (!Reader.ReadNumber(Number))
+		{
+			return MCPParamsBinding::ReaderFailed(Reader, OutError);
+		}
+		if (NumericProperty->IsInteger())
+		{
+			if (FMath::Frac(Number) != 0.0)
+			{
+				return Mismatch(TEXT("an integer"));
+			}
+			NumericProperty->SetIntPropertyValue(ValuePtr, (int64)Number);
+		}
+		else
+		{
+			NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Number);
+		}
+		return true;
+	}
+
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		if (Token != EMCPJsonToken::Object)
+		{
+			return Mismatch(TEXT("an object"));
+		}
+		return DecodeObject(StructProperty->Struct, ValuePtr, Reader, Path, OutError);
+	}
+
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		if (Token != EMCPJsonToken::Array)
+		{
+			return Mismatch(TEXT("an array"));
+		}
+
+		// Elements are decoded in place as they are read; the array grows as a TArray would
+		FScriptArrayHelper Array(ArrayProperty, ValuePtr);
+		Array.EmptyValues();
+		const int32 PathLen = Path.Len();
+		Reader.BeginArray();
+		while (Reader.NextElement())
+		{
+			const int32 Index = Array.AddValue();
+			Path.Appendf(TEXT("[%d]"), Index);
+			if (Reader.Peek() == EMCPJsonToken::Null)
+			{
+				OutError = FString::Printf(TEXT("Invalid params - '%s' must not be null"), *Path);
+				return false;
+			}
+			if (!DecodeValue(ArrayProperty->Inner, Array.GetRawPtr(Index), Reader, Path, OutError))
+			{
+				return false;
+			}
+			Path.LeftInline(PathLen, EAllowShrinking::No);
+		}
+		return !Reader.HasError() || MCPParamsBinding::ReaderFailed(Reader, OutError);
+	}
+
+	OutError = FString::Printf(TEXT("Invalid params - '%s' has a type the server cannot decode"), *Path);
+	return false;
+}
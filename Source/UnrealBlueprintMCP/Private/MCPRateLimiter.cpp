@@ -0,0 +1,77 @@
+#include "MCPRateLimiter.h"
+
+FMCPTokenBucket::FMCPTokenBucket(double TokensPerSecond, double Burst)
+	: IntervalMicroseconds(TokensPerSecond > 0.0 ? FMath::Max<int64>(1, (int64)(1000000.0 / TokensPerSecond)) : 0)
+	, CapacityMicroseconds((int64)(FMath::Max(1.0, Burst) * IntervalMicroseconds))
+	, TheoreticalArrivalMicroseconds(0)
+{
+}
+
+bool FMCPTokenBucket::TryConsume(int64 NowMicroseconds, int32 Tokens, int64& OutRetryAfterMicroseconds)
+{
+	const int64 CostMicroseconds = IntervalMicroseconds * FMath::Max(Tokens, 1);
+	int64 Arrival = TheoreticalArrivalMicroseconds.load(std::memory_order_relaxed);
+	while (true)
+	{
+		// An idle bucket refills up to capacity, never beyond
+		const int64 NewArrival = FMath::Max(Arrival, NowMicroseconds) + CostMicroseconds;
+		const int64 AllowedAt = NewArrival - CapacityMicroseconds;
+		if (AllowedAt > NowMicroseconds)
+		{
+			OutRetryAfterMicroseconds = AllowedAt - NowMicroseconds;
+			return false;
+		}
+
+		if (TheoreticalArrivalMicroseconds.compare_exchange_weak(Arrival, NewArrival, std::memory_order_relaxed))
+		{
+			OutRetryAfterMicroseconds = 0;
+			return true;
+		}
+	}
+}
+
+int32 FMCPTokenBucket::GetCapacity() const
+{
+	return IntervalMicroseconds > 0 ? (int32)(CapacityMicroseconds / IntervalMicroseconds) : MAX_int32;
+}
+
+FMCPRateLimiter::FMCPRateLimiter(int32 InRequestsPerSecond)
+	: RequestsPerSecond(InRequestsPerSecond)
+	, ReadRate(FMath::Max(InRequestsPerSecond, 0))
+	, MutationRate(FMath::Max(1.0, (double)InRequestsPerSecond / MutationRateDivisor))
+	, Read(ReadRate, ReadRate)
+	, Mutation(MutationRate, MutationRate)
+{
+}
+
+bool FMCPRateLimiter::TryAcquire(EMCPRateClass RateClass, int32 Cost, double& OutRetryAfterSeconds)
+{
+	OutRetryAfterSeconds = 0.0;
+	if (!IsEnabled())
+	{
+		return true;
+	}
+
+	const int64 Now = (int64)(FPlatformTime::Seconds() * 1000000.0);
+	int64 RetryAfter = 0;
+	FMCPTokenBucket& Bucket = RateClass == EMCPRateClass::Mutation ? Mutation : Read;
+	if (Cost > Bucket.GetCapacity())
+	{
+		return false;
+	}
+	if (!Bucket.TryConsume(Now, Cost, RetryAfter))
+	{
+		OutRetryAfterSeconds = RetryAfter / 1000000.0;
+		return false;
+	}
+	return true;
+}
+
+int32 FMCPRateLimiter::GetCapacity(EMCPRateClass RateClass) const
+{
+	if (!IsEnabled())
+	{
+		return MAX_int32;
+	}
+	return (RateClass == EMCPRateClass::Mutation ? Mutation : Read).GetCapacity();
+}
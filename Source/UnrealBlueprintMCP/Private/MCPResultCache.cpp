@@ -0,0 +1,180 @@
+#include "MCPResultCache.h"
+#include "Misc/ScopeLock.h"
+
+FMCPResultCache::FMCPResultCache()
+	: BudgetBytes(0)
+	, Generation(0)
+{
+}
+
+void FMCPResultCache::SetBudget(int64 InBudgetBytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	const int64 Budget = FMath::Max<int64>(0, InBudgetBytes);
+	BudgetBytes.store(Budget, std::memory_order_relaxed);
+	EvictToFit(0, Budget);
+}
+
+FMCPResultCache::FResultPtr FMCPResultCache::Find(const FString& Key)
+{
+	FScopeLock ScopeLock(&Lock);
+	const int32* Index = EntriesByKey.Find(Key);
+	if (!Index)
+	{
+		++Misses;
+		return nullptr;
+	}
+
+	++Hits;
+	Unlink(*Index);
+	Link(*Index);
+	return Entries[*Index].Result;
+}
+
+bool FMCPResultCache::Store(const FString& Key, FName Dependency, FResultPtr Result, uint64 FillGeneration)
+{
+	const int64 Budget = BudgetBytes.load(std::memory_order_relaxed);
+	if (!Result.IsValid() || Budget <= 0)
+	{
+		return false;
+	}
+
+	// One large listing should not flush everything else
+	const int64 Bytes = Result->Num() + Key.GetAllocatedSize() + EntryOverheadBytes;
+	if (Bytes > Budget / 4)
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (Generation.load(std::memory_order_acquire) != FillGeneration)
+	{
+		return false;
+	}
+
+	// Two connections can miss on the same key at once; the later result replaces the earlier
+	if (const int32* Existing = EntriesByKey.Find(Key))
+	{
+		Remove(*Existing);
+	}
+	EvictToFit(Bytes, Budget);
+
+	FEntry Entry;
+	Entry.Key = Key;
+	Entry.Dependency = Dependency;
+	Entry.Result = MoveTemp(Result);
+	Entry.Bytes = Bytes;
+	const int32 Index = Entries.Add(MoveTemp(Entry));
+	EntriesByKey.Add(Key, Index);
+	if (!Dependency.IsNone())
+	{
+		EntriesByDependency.Add(Dependency, Index);
+	}
+	Link(Index);
+	BytesHeld += Bytes;
+	return true;
+}
+
+void FMCPResultCache::Invalidate(FName Dependency)
+{
+	// Bumped even when nothing is cached for Dependency yet: a result for it may be in the making
+	Generation.fetch_add(1, std::memory_order_acq_rel);
+
+	FScopeLock ScopeLock(&Lock);
+	TArray<int32, TInlineAllocator<8>> Indices;
+	EntriesByDependency.MultiFind(Dependency, Indices);
+	for (int32 Index : Indices)
+	{
+		Remove(Index);
+	}
+	Invalidations += Indices.Num();
+}
+
+void FMCPResultCache::Empty()
+{
+	Generation.fetch_add(1, std::memory_order_acq_rel);
+
+	FScopeLock ScopeLock(&Lock);
+	Invalidations += Entries.Num();
+	Entries.Empty();
+	EntriesByKey.Empty();
+	EntriesByDependency.Empty();
+	MostRecent = INDEX_NONE;
+	LeastRecent = INDEX_NONE;
+	BytesHeld = 0;
+}
+
+FMCPResultCacheStats FMCPResultCache::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	FMCPResultCacheStats Stats;
+	Stats.BudgetBytes = BudgetBytes.load(std::memory_order_relaxed);
+	Stats.BytesHeld = BytesHeld;
+	Stats.Entries = Entries.Num();
+	Stats.Hits = Hits;
+	Stats.Misses = Misses;
+	Stats.Evictions = Evictions;
+	Stats.Invalidations = Invalidations;
+	return Stats;
+}
+
+void FMCPResultCache::Link(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	Entry.Newer = INDEX_NONE;
+	Entry.Older = MostRecent;
+	if (MostRecent != INDEX_NONE)
+	{
+		Entries[MostRecent].Newer = Index;
+	}
+	MostRecent = Index;
+	if (LeastRecent == INDEX_NONE)
+	{
+		LeastRecent = Index;
+	}
+}
+
+void FMCPResultCache::Unlink(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	if (Entry.Newer != INDEX_NONE)
+	{
+		Entries[Entry.Newer].Older = Entry.Older;
+	}
+	else
+	{
+		MostRecent = Entry.Older;
+	}
+	if (Entry.Older != INDEX_NONE)
+	{
+		Entries[Entry.Older].Newer = Entry.Newer;
+	}
+	else
+	{
+		LeastRecent = Entry.Newer;
+	}
+	Entry.Newer = INDEX_NONE;
+	Entry.Older = INDEX_NONE;
+}
+
+void FMCPResultCache::Remove(int32 Index)
+{
+	Unlink(Index);
+	const FEntry& Entry = Entries[Index];
+	EntriesByKey.Remove(Entry.Key);
+	if (!Entry.Dependency.IsNone())
+	{
+		EntriesByDependency.RemoveSingle(Entry.Dependency, Index);
+	}
+	BytesHeld -= Entry.Bytes;
+	Entries.RemoveAt(Index);
+}
+
+void FMCPResultCache::EvictToFit(int64 IncomingBytes, int64 Budget)
+{
+	while (LeastRecent != INDEX_NONE && (BytesHeld + IncomingBytes > Budget || Entries.Num() >= MaxEntries))
+	{
+		Remove(LeastRecent);
+		++Evictions;
+	}
+}
@@ -0,0 +1,69 @@
+#include "MCPServerConfig.h"
+#include "MCPServerSettings.h"
+
+FMCPServerConfig::FMCPServerConfig()
+	: ServerPort(8080)
+	, MaxConnections(10)
+	, ConnectionQueueSize(10)
+	, TimeoutSeconds(30)
+	, MaxRequestsPerConnection(100)
+	, bEnableCORS(false)
+	, bEnableAuth(false)
+	, bEnableDiagnostics(false)
+	, bEnableLocalSocket(false)
+	, bCompression(false)
+	, CompressionFlags(COMPRESS_BiasSpeed)
+	, CompressionMinBytes(1024)
+	, ResultCacheBytes(32 * 1024 * 1024)
+	, GameThreadBudgetSeconds(0.005)
+	, BlueprintRefreshDelaySeconds(0.2)
+	, RequestRateLimit(0)
+	, HeaderBlock(FMCPHttpHeaderBlock::Build(bEnableCORS, {}, CustomHeaders, TimeoutSeconds, MaxRequestsPerConnection, bCompression))
+	, RateLimiter(MakeShared<FMCPRateLimiter, ESPMode::ThreadSafe>(RequestRateLimit))
+{
+}
+
+TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> FMCPServerConfig::Build(const UMCPServerSettings& Settings, const FMCPServerConfig* Previous)
+{
+	TSharedRef<FMCPServerConfig, ESPMode::ThreadSafe> Config = MakeShared<FMCPServerConfig, ESPMode::ThreadSafe>();
+
+	Config->ServerPort = Settings.ServerPort;
+	Config->MaxConnections = Settings.MaxClientConnections;
+	Config->ConnectionQueueSize = Settings.ConnectionQueueSize;
+	Config->TimeoutSeconds = Settings.ServerTimeoutSeconds;
+	Config->MaxRequestsPerConnection = Settings.MaxRequestsPerConnection;
+	Config->bEnableCORS = Settings.bEnableCORS;
+	Config->bEnableAuth = Settings.bEnableAuthentication;
+	Config->APIKey = Settings.APIKey;
+	Config->CustomHeaders = Settings.CustomHeaders;
+	Config->bEnableDiagnostics = Settings.bEnableDiagnosticMethods;
+	Config->bEnableLocalSocket = Settings.bEnableLocalSocket;
+	Config->LocalSocketPath = Settings.GetLocalSocketPath();
+
+	// Map the compression level onto zlib's speed/size bias
+	Config->bCompression = Settings.CompressionLevel != EMCPCompressionLevel::Disabled;
+	Config->CompressionFlags = COMPRESS_NoFlags;
+	if (Settings.CompressionLevel == EMCPCompressionLevel::Fastest)
+	{
+		Config->CompressionFlags = COMPRESS_BiasSpeed;
+	}
+	else if (Settings.CompressionLevel == EMCPCompressionLevel::Smallest)
+	{
+		Config->CompressionFlags = COMPRESS_BiasSize;
+	}
+	Config->CompressionMinBytes = FMath::Max(0, Settings.CompressionMinBytes);
+	Config->ResultCacheBytes = (int64)FMath::Max(0, Settings.ResultCacheMegabytes) * 1024 * 1024;
+	Config->GameThreadBudgetSeconds = FMath::Max(1, Settings.GameThreadBudgetMs) / 1000.0;
+	Config->BlueprintRefreshDelaySeconds = FMath::Max(0, Settings.BlueprintRefreshDelayMs) / 1000.0;
+
+	// Keep the current buckets unless the limit actually changed
+	Config->RequestRateLimit = Settings.RequestRateLimit;
+	Config->RateLimiter = (Previous && Previous->RequestRateLimit == Config->RequestRateLimit)
+		? Previous->RateLimiter
+		: MakeShared<FMCPRateLimiter, ESPMode::ThreadSafe>(Config->RequestRateLimit);
+
+	Config->HeaderBlock = FMCPHttpHeaderBlock::Build(
+		Config->bEnableCORS, Settings.AllowedOrigins, Config->CustomHeaders, Config->TimeoutSeconds, Config->MaxRequestsPerConnection, Config->bCompression);
+
+	return Config;
+}
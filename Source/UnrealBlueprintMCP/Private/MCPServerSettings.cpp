@@ -9,6 +9,7 @@
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "Common/TcpSocketBuilder.h"
+#include "MCPLocalSocket.h"
 
 #if WITH_EDITOR
 #include "Framework/Notifications/NotificationManager.h"
@@ -28,14 +29,24 @@ UMCPServerSettings::UMCPServerSettings(const FObjectInitializer& ObjectInitializ
 	ServerPort = 8080;
 	bAutoStartServer = false;
 	MaxClientConnections = 10;
+	ConnectionQueueSize = 10;
 	ServerTimeoutSeconds = 30;
+	MaxRequestsPerConnection = 100;
 	bEnableCORS = false;
+	bEnableLocalSocket = false;
+	LocalSocketPath = TEXT("");
 	LogLevel = EMCPLogLevel::Basic;
 	bLogToFile = false;
 	LogFilePath = TEXT("Logs/MCPServer.log");
 	RequestRateLimit = 0;
 	bEnableAuthentication = false;
 	APIKey = TEXT("");
+	CompressionLevel = EMCPCompressionLevel::Fastest;
+	CompressionMinBytes = 1024;
+	ResultCacheMegabytes = 32;
+	GameThreadBudgetMs = 5;
+	BlueprintRefreshDelayMs = 200;
+	bEnableDiagnosticMethods = false;
 	CurrentPreset = EMCPServerPreset::Development;
 }
 
@@ -130,25 +141,10 @@ void UMCPServerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyC
 		UE_LOG(LogTemp, Warning, TEXT("MCP Server Settings Validation Error: %s"), *ErrorMessage);
 	}
 
-	// Check if server restart is required
-	bool bNeedsRestart = (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, ServerPort)) ||
-						 (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, MaxClientConnections)) ||
-						 (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, ServerTimeoutSeconds)) ||
-						 (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, bEnableCORS)) ||
-						 (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, bEnableAuthentication)) ||
-						 (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, APIKey));
-
-	if (bNeedsRestart)
-	{
-		FNotificationInfo RestartInfo(LOCTEXT("ServerRestartRequired", "Server restart required for changes to take effect"));
-		RestartInfo.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(RestartInfo);
-	}
-
 	// Broadcast settings changed
 	BroadcastSettingsChanged();
 
-	// Apply settings if server is running
+	// Apply settings to the running server; nothing here needs a restart
 	OnApplyServerSettings.Broadcast(this);
 
 	// Save config
@@ -173,6 +169,10 @@ bool UMCPServerSettings::CanEditChange(const FProperty* InProperty) const
 	{
 		return bEnableCORS;
 	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, LocalSocketPath))
+	{
+		return bEnableLocalSocket;
+	}
 	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UMCPServerSettings, APIKey))
 	{
 		return bEnableAuthentication;
@@ -213,6 +213,19 @@ bool UMCPServerSettings::ValidateSettings(FString& OutErrorMessage) const
 		OutErrorMessage += TEXT("API Key cannot be empty when authentication is enabled\\n");
 	}
 
+	if (bEnableLocalSocket)
+	{
+		const int32 PathBytes = FTCHARToUTF8(*GetLocalSocketPath()).Length();
+		if (!FMCPLocalSocket::IsSupported())
+		{
+			OutErrorMessage += TEXT("Local sockets are not supported on this platform\\n");
+		}
+		else if (PathBytes > FMCPLocalSocket::GetMaxPathLength())
+		{
+			OutErrorMessage += FString::Printf(TEXT("Local socket path is longer than %d bytes\\n"), FMCPLocalSocket::GetMaxPathLength());
+		}
+	}
+
 	return OutErrorMessage.IsEmpty();
 }
 
@@ -268,20 +281,31 @@ void UMCPServerSettings::ResetToDefaults()
 	ServerPort = 8080;
 	bAutoStartServer = false;
 	MaxClientConnections = 10;
+	ConnectionQueueSize = 10;
 	ServerTimeoutSeconds = 30;
+	MaxRequestsPerConnection = 100;
 	bEnableCORS = false;
+	bEnableLocalSocket = false;
+	LocalSocketPath = TEXT("");
 	LogLevel = EMCPLogLevel::Basic;
 	bLogToFile = false;
 	LogFilePath = TEXT("Logs/MCPServer.log");
 	RequestRateLimit = 0;
 	bEnableAuthentication = false;
 	APIKey = TEXT("");
+	CompressionLevel = EMCPCompressionLevel::Fastest;
+	CompressionMinBytes = 1024;
+	ResultCacheMegabytes = 32;
+	GameThreadBudgetMs = 5;
+	BlueprintRefreshDelayMs = 200;
+	bEnableDiagnosticMethods = false;
 	CurrentPreset = EMCPServerPreset::Development;
 	CustomHeaders.Empty();
 	AllowedOrigins.Empty();
 
 	SaveConfig();
 	BroadcastSettingsChanged();
+	OnApplyServerSettings.Broadcast(this);
 
 #if WITH_EDITOR
 	FNotificationInfo Info(LOCTEXT("SettingsReset", "MCP Server settings reset to defaults"));
@@ -311,6 +335,7 @@ void UMCPServerSettings::ApplyPreset(EMCPServerPreset Preset)
 
 	SaveConfig();
 	BroadcastSettingsChanged();
+	OnApplyServerSettings.Broadcast(this);
 
 #if WITH_EDITOR
 	FString PresetName = StaticEnum<EMCPServerPreset>()->GetDisplayNameTextByValue((int64)Preset).ToString();
@@ -327,14 +352,24 @@ FString UMCPServerSettings::ExportToJSON() const
 	JsonObject->SetNumberField(TEXT("ServerPort"), ServerPort);
 	JsonObject->SetBoolField(TEXT("AutoStartServer"), bAutoStartServer);
 	JsonObject->SetNumberField(TEXT("MaxClientConnections"), MaxClientConnections);
+	JsonObject->SetNumberField(TEXT("ConnectionQueueSize"), ConnectionQueueSize);
 	JsonObject->SetNumberField(TEXT("ServerTimeoutSeconds"), ServerTimeoutSeconds);
+	JsonObject->SetNumberField(TEXT("MaxRequestsPerConnection"), MaxRequestsPerConnection);
 	JsonObject->SetBoolField(TEXT("EnableCORS"), bEnableCORS);
+	JsonObject->SetBoolField(TEXT("EnableLocalSocket"), bEnableLocalSocket);
+	JsonObject->SetStringField(TEXT("LocalSocketPath"), LocalSocketPath);
 	JsonObject->SetNumberField(TEXT("LogLevel"), (int32)LogLevel);
 	JsonObject->SetBoolField(TEXT("LogToFile"), bLogToFile);
 	JsonObject->SetStringField(TEXT("LogFilePath"), LogFilePath);
 	JsonObject->SetNumberField(TEXT("RequestRateLimit"), RequestRateLimit);
 	JsonObject->SetBoolField(TEXT("EnableAuthentication"), bEnableAuthentication);
 	JsonObject->SetStringField(TEXT("APIKey"), APIKey);
+	JsonObject->SetNumberField(TEXT("CompressionLevel"), (int32)CompressionLevel);
+	JsonObject->SetNumberField(TEXT("CompressionMinBytes"), CompressionMinBytes);
+	JsonObject->SetNumberField(TEXT("ResultCacheMegabytes"), ResultCacheMegabytes);
+	JsonObject->SetNumberField(TEXT("GameThreadBudgetMs"), GameThreadBudgetMs);
+	JsonObject->SetNumberField(TEXT("BlueprintRefreshDelayMs"), BlueprintRefreshDelayMs);
+	JsonObject->SetBoolField(TEXT("EnableDiagnosticMethods"), bEnableDiagnosticMethods);
 	JsonObject->SetNumberField(TEXT("CurrentPreset"), (int32)CurrentPreset);
 
 	// Custom headers
@@ -384,14 +419,30 @@ bool UMCPServerSettings::ImportFromJSON(const FString& JSONString, FString& OutE
 	{
 		MaxClientConnections = JsonObject->GetIntegerField(TEXT("MaxClientConnections"));
 	}
+	if (JsonObject->HasField(TEXT("ConnectionQueueSize")))
+	{
+		ConnectionQueueSize = JsonObject->GetIntegerField(TEXT("ConnectionQueueSize"));
+	}
 	if (JsonObject->HasField(TEXT("ServerTimeoutSeconds")))
 	{
 		ServerTimeoutSeconds = JsonObject->GetIntegerField(TEXT("ServerTimeoutSeconds"));
 	}
+	if (JsonObject->HasField(TEXT("MaxRequestsPerConnection")))
+	{
+		MaxRequestsPerConnection = JsonObject->GetIntegerField(TEXT("MaxRequestsPerConnection"));
+	}
 	if (JsonObject->HasField(TEXT("EnableCORS")))
 	{
 		bEnableCORS = JsonObject->GetBoolField(TEXT("EnableCORS"));
 	}
+	if (JsonObject->HasField(TEXT("EnableLocalSocket")))
+	{
+		bEnableLocalSocket = JsonObject->GetBoolField(TEXT("EnableLocalSocket"));
+	}
+	if (JsonObject->HasField(TEXT("LocalSocketPath")))
+	{
+		LocalSocketPath = JsonObject->GetStringField(TEXT("LocalSocketPath"));
+	}
 	if (JsonObject->HasField(TEXT("LogLevel")))
 	{
 		LogLevel = (EMCPLogLevel)JsonObject->GetIntegerField(TEXT("LogLevel"));
@@ -416,6 +467,30 @@ bool UMCPServerSettings::ImportFromJSON(const FString& JSONString, FString& OutE
 	{
 		APIKey = JsonObject->GetStringField(TEXT("APIKey"));
 	}
+	if (JsonObject->HasField(TEXT("CompressionLevel")))
+	{
+		CompressionLevel = (EMCPCompressionLevel)JsonObject->GetIntegerField(TEXT("CompressionLevel"));
+	}
+	if (JsonObject->HasField(TEXT("CompressionMinBytes")))
+	{
+		CompressionMinBytes = JsonObject->GetIntegerField(TEXT("CompressionMinBytes"));
+	}
+	if (JsonObject->HasField(TEXT("ResultCacheMegabytes")))
+	{
+		ResultCacheMegabytes = JsonObject->GetIntegerField(TEXT("ResultCacheMegabytes"));
+	}
+	if (JsonObject->HasField(TEXT("GameThreadBudgetMs")))
+	{
+		GameThreadBudgetMs = JsonObject->GetIntegerField(TEXT("GameThreadBudgetMs"));
+	}
+	if (JsonObject->HasField(TEXT("BlueprintRefreshDelayMs")))
+	{
+		BlueprintRefreshDelayMs = JsonObject->GetIntegerField(TEXT("BlueprintRefreshDelayMs"));
+	}
+	if (JsonObject->HasField(TEXT("EnableDiagnosticMethods")))
+	{
+		bEnableDiagnosticMethods = JsonObject->GetBoolField(TEXT("EnableDiagnosticMethods"));
+	}
 	if (JsonObject->HasField(TEXT("CurrentPreset")))
 	{
 		CurrentPreset = (EMCPServerPreset)JsonObject->GetIntegerField(TEXT("CurrentPreset"));
@@ -465,6 +540,7 @@ bool UMCPServerSettings::ImportFromJSON(const FString& JSONString, FString& OutE
 
 	SaveConfig();
 	BroadcastSettingsChanged();
+	OnApplyServerSettings.Broadcast(this);
 
 	return true;
 }
@@ -502,6 +578,17 @@ FString UMCPServerSettings::GetServerURL() const
 	return FString::Printf(TEXT("http://localhost:%d"), ServerPort);
 }
 
+FString UMCPServerSettings::GetLocalSocketPath() const
+{
+	if (!LocalSocketPath.IsEmpty())
+	{
+		return FPaths::ConvertRelativePathToFull(LocalSocketPath);
+	}
+
+	// The temp directory keeps the default short enough for sockaddr_un (~104 bytes)
+	return FPaths::Combine(FPlatformProcess::UserTempDir(), TEXT("unreal-blueprint-mcp.sock"));
+}
+
 FString UMCPServerSettings::GetSettingsDisplayString() const
 {
 	FString LogLevelStr = StaticEnum<EMCPLogLevel>()->GetDisplayNameTextByValue((int64)LogLevel).ToString();
@@ -513,17 +600,8 @@ FString UMCPServerSettings::GetSettingsDisplayString() const
 
 bool UMCPServerSettings::RequiresServerRestart(const UMCPServerSettings* OtherSettings) const
 {
-	if (!OtherSettings)
-	{
-		return true;
-	}
-
-	return (ServerPort != OtherSettings->ServerPort) ||
-		   (MaxClientConnections != OtherSettings->MaxClientConnections) ||
-		   (ServerTimeoutSeconds != OtherSettings->ServerTimeoutSeconds) ||
-		   (bEnableCORS != OtherSettings->bEnableCORS) ||
-		   (bEnableAuthentication != OtherSettings->bEnableAuthentication) ||
-		   (APIKey != OtherSettings->APIKey);
+	// The server applies every setting live, including moving to a new port
+	return false;
 }
 
 void UMCPServerSettings::BroadcastSettingsChanged()
@@ -0,0 +1,100 @@
+#include "MCPTimerWheel.h"
+
+FMCPTimerWheel::FMCPTimerWheel(double InTickSeconds, int32 InNumSlots)
+	: TickSeconds(FMath::Max(InTickSeconds, 0.001))
+	, FreeList(INDEX_NONE)
+	, NumTimers(0)
+	, CurrentTick((int64)(FPlatformTime::Seconds() / TickSeconds))
+{
+	Slots.Init(INDEX_NONE, FMath::Max(InNumSlots, 1));
+}
+
+int32 FMCPTimerWheel::Schedule(double DeadlineSeconds, UPTRINT Key)
+{
+	int32 TimerId = FreeList;
+	if (TimerId != INDEX_NONE)
+	{
+		FreeList = Timers[TimerId].Next;
+	}
+	else
+	{
+		TimerId = Timers.AddDefaulted();
+	}
+
+	// Round up so a timer never fires before its deadline; one already due fires on the next Advance()
+	const int64 DeadlineTick = FMath::Max((int64)FMath::CeilToDouble(DeadlineSeconds / TickSeconds), CurrentTick + 1);
+	const int32 Slot = (int32)(DeadlineTick % Slots.Num());
+
+	FTimer& Timer = Timers[TimerId];
+	Timer.Key = Key;
+	Timer.DeadlineTick = DeadlineTick;
+	Timer.Slot = Slot;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = Slots[Slot];
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = TimerId;
+	}
+	Slots[Slot] = TimerId;
+
+	++NumTimers;
+	return TimerId;
+}
+
+void FMCPTimerWheel::Cancel(int32 TimerId)
+{
+	if (Timers.IsValidIndex(TimerId) && Timers[TimerId].Slot != INDEX_NONE)
+	{
+		Unlink(TimerId);
+	}
+}
+
+void FMCPTimerWheel::Advance(double NowSeconds, TArray<UPTRINT>& OutExpired)
+{
+	const int64 NowTick = (int64)(NowSeconds / TickSeconds);
+	if (NowTick <= CurrentTick)
+	{
+		return;
+	}
+
+	// After a long stall every bucket is due, but each still only needs one visit
+	const int64 TicksToVisit = FMath::Min<int64>(NowTick - CurrentTick, Slots.Num());
+	for (int64 Tick = NowTick - TicksToVisit + 1; Tick <= NowTick; ++Tick)
+	{
+		int32 TimerId = Slots[(int32)(Tick % Slots.Num())];
+		while (TimerId != INDEX_NONE)
+		{
+			const int32 Next = Timers[TimerId].Next;
+			if (Timers[TimerId].DeadlineTick <= NowTick)
+			{
+				OutExpired.Add(Timers[TimerId].Key);
+				Unlink(TimerId);
+			}
+			TimerId = Next;
+		}
+	}
+	CurrentTick = NowTick;
+}
+
+void FMCPTimerWheel::Unlink(int32 TimerId)
+{
+	FTimer& Timer = Timers[TimerId];
+	if (Timer.Prev != INDEX_NONE)
+	{
+		Timers[Timer.Prev].Next = Timer.Next;
+	}
+	else
+	{
+		Slots[Timer.Slot] = Timer.Next;
+	}
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Timer.Prev;
+	}
+
+	Timer.Slot = INDEX_NONE;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = FreeList;
+	FreeList = TimerId;
+	--NumTimers;
+}
@@ -0,0 +1,319 @@
+#include "MCPWebSocket.h"
+#include "Misc/SecureHash.h"
+#include "Misc/Base64.h"
+#include "Misc/ScopeLock.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+namespace MCPWebSocket
+{
+	/** Fixed GUID appended to the client key (RFC 6455 section 1.3) */
+	static const ANSICHAR* HandshakeGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+	/** Smallest receive buffer we hand out */
+	static constexpr int32 MinReadSize = 4 * 1024;
+
+	static bool IsControlOpcode(uint8 Opcode)
+	{
+		return (Opcode & 0x8) != 0;
+	}
+}
+
+FMCPWebSocketFrameParser::FMCPWebSocketFrameParser(int64 InMaxMessageBytes)
+	: ValidBytes(0)
+	, ReadOffset(0)
+	, FragmentOpcode(EMCPWebSocketOpcode::Text)
+	, bInFragmentedMessage(false)
+	, MaxMessageBytes(InMaxMessageBytes)
+	, CloseCode(0)
+{
+}
+
+uint8* FMCPWebSocketFrameParser::GetWriteBuffer(int32 MinBytes)
+{
+	MinBytes = FMath::Max(MinBytes, MCPWebSocket::MinReadSize);
+	if (Buffer.Num() - ValidBytes < MinBytes)
+	{
+		Buffer.SetNumUninitialized(ValidBytes + MinBytes, EAllowShrinking::No);
+	}
+	return Buffer.GetData() + ValidBytes;
+}
+
+void FMCPWebSocketFrameParser::CommitWrite(int32 BytesWritten)
+{
+	check(BytesWritten >= 0 && ValidBytes + BytesWritten <= Buffer.Num());
+	ValidBytes += BytesWritten;
+}
+
+void FMCPWebSocketFrameParser::Append(TArrayView<const uint8> Bytes)
+{
+	if (Bytes.Num() > 0)
+	{
+		FMemory::Memcpy(GetWriteBuffer(Bytes.Num()), Bytes.GetData(), Bytes.Num());
+		CommitWrite(Bytes.Num());
+	}
+}
+
+EMCPWebSocketParseResult FMCPWebSocketFrameParser::Parse(FMCPWebSocketMessage& OutMessage)
+{
+	if (CloseCode != 0)
+	{
+		return EMCPWebSocketParseResult::Error;
+	}
+
+	while (true)
+	{
+		const uint8* Data = Buffer.GetData() + ReadOffset;
+		const int32 Available = ValidBytes - ReadOffset;
+
+		// Base header, then the extended length and masking key (RFC 6455 section 5.2)
+		int64 HeaderBytes = 2;
+		if (Available < HeaderBytes)
+		{
+			break;
+		}
+
+		const bool bFinal = (Data[0] & 0x80) != 0;
+		const uint8 Opcode = Data[0] & 0x0F;
+		if ((Data[0] & 0x70) != 0 || (Data[1] & 0x80) == 0)
+		{
+			// No extensions are negotiated, and client frames must be masked
+			return SetError(1002);
+		}
+
+		uint64 PayloadBytes = Data[1] & 0x7F;
+		if (PayloadBytes == 126)
+		{
+			HeaderBytes += 2;
+			if (Available < HeaderBytes)
+			{
+				break;
+			}
+			PayloadBytes = ((uint64)Data[2] << 8) | Data[3];
+		}
+		else if (PayloadBytes == 127)
+		{
+			HeaderBytes += 8;
+			if (Available < HeaderBytes)
+			{
+				break;
+			}
+			PayloadBytes = 0;
+			for (int32 Index = 2; Index < 10; ++Index)
+			{
+				PayloadBytes = (PayloadBytes << 8) | Data[Index];
+			}
+		}
+		HeaderBytes += 4;
+
+		if (MCPWebSocket::IsControlOpcode(Opcode))
+		{
+			if (!bFinal || PayloadBytes > 125 || Opcode > (uint8)EMCPWebSocketOpcode::Pong)
+			{
+				return SetError(1002);
+			}
+		}
+		else
+		{
+			const bool bContinuation = Opcode == (uint8)EMCPWebSocketOpcode::Continuation;
+			if (Opcode > (uint8)EMCPWebSocketOpcode::Binary || bContinuation != bInFragmentedMessage)
+			{
+				return SetError(1002);
+			}
+			if (PayloadBytes > (uint64)MaxMessageBytes || FragmentPayload.Num() + (int64)PayloadBytes > MaxMessageBytes)
+			{
+				return SetError(1009);
+			}
+		}
+
+		const int64 FrameBytes = HeaderBytes + (int64)PayloadBytes;
+		if (Available < FrameBytes)
+		{
+			// Size the buffer for the whole frame once instead of growing it chunk by chunk
+			Buffer.Reserve(ReadOffset + FrameBytes);
+			break;
+		}
+
+		// Unmask while copying out of the receive buffer
+		const uint8* Mask = Data + HeaderBytes - 4;
+		const uint8* Payload = Data + HeaderBytes;
+		TArray<uint8>& Target = MCPWebSocket::IsControlOpcode(Opcode) ? OutMessage.Payload : FragmentPayload;
+		if (MCPWebSocket::IsControlOpcode(Opcode))
+		{
+			Target.Reset();
+		}
+		const int32 TargetStart = Target.Num();
+		Target.SetNumUninitialized(TargetStart + (int32)PayloadBytes, EAllowShrinking::No);
+		uint8* Out = Target.GetData() + TargetStart;
+		for (int32 Index = 0; Index < (int32)PayloadBytes; ++Index)
+		{
+			Out[Index] = Payload[Index] ^ Mask[Index & 3];
+		}
+		ReadOffset += (int32)FrameBytes;
+
+		if (MCPWebSocket::IsControlOpcode(Opcode))
+		{
+			OutMessage.Opcode = (EMCPWebSocketOpcode)Opcode;
+			return EMCPWebSocketParseResult::Message;
+		}
+
+		if (Opcode != (uint8)EMCPWebSocketOpcode::Continuation)
+		{
+			FragmentOpcode = (EMCPWebSocketOpcode)Opcode;
+			bInFragmentedMessage = true;
+		}
+
+		if (bFinal)
+		{
+			OutMessage.Opcode = FragmentOpcode;
+			OutMessage.Payload = MoveTemp(FragmentPayload);
+			FragmentPayload.Reset();
+			bInFragmentedMessage = false;
+			return EMCPWebSocketParseResult::Message;
+		}
+	}
+
+	// Keep the unparsed tail at the front so the buffer does not creep forward
+	if (ReadOffset > 0)
+	{
+		const int32 Remaining = ValidBytes - ReadOffset;
+		if (Remaining > 0)
+		{
+			FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + ReadOffset, Remaining);
+		}
+		ValidBytes = Remaining;
+		ReadOffset = 0;
+	}
+	return EMCPWebSocketParseResult::NeedMoreData;
+}
+
+EMCPWebSocketParseResult FMCPWebSocketFrameParser::SetError(uint16 InCloseCode)
+{
+	CloseCode = InCloseCode;
+	return EMCPWebSocketParseResult::Error;
+}
+
+FString FMCPWebSocket::ComputeAcceptKey(const FString& ClientKey)
+{
+	const FString Combined = ClientKey.TrimStartAndEnd() + ANSI_TO_TCHAR(MCPWebSocket::HandshakeGuid);
+	FTCHARToUTF8 Utf8(*Combined, Combined.Len());
+
+	uint8 Digest[FSHA1::DigestSize];
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Digest);
+	return FBase64::Encode(Digest, FSHA1::DigestSize);
+}
+
+bool FMCPWebSocket::IsValidClientKey(const FString& ClientKey)
+{
+	TArray<uint8> Decoded;
+	return FBase64::Decode(ClientKey.TrimStartAndEnd(), Decoded) && Decoded.Num() == 16;
+}
+
+void FMCPWebSocket::EncodeFrame(EMCPWebSocketOpcode Opcode, const uint8* Payload, int64 PayloadBytes, TArray<uint8>& Out)
+{
+	uint8 Header[10];
+	int32 HeaderBytes = 2;
+	Header[0] = 0x80 | (uint8)Opcode;
+	if (PayloadBytes < 126)
+	{
+		Header[1] = (uint8)PayloadBytes;
+	}
+	else if (PayloadBytes <= 0xFFFF)
+	{
+		Header[1] = 126;
+		Header[2] = (uint8)(PayloadBytes >> 8);
+		Header[3] = (uint8)PayloadBytes;
+		HeaderBytes = 4;
+	}
+	else
+	{
+		Header[1] = 127;
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Header[2 + Index] = (uint8)((uint64)PayloadBytes >> (56 - 8 * Index));
+		}
+		HeaderBytes = 10;
+	}
+
+	Out.Reserve(Out.Num() + HeaderBytes + PayloadBytes);
+	Out.Append(Header, HeaderBytes);
+	Out.Append(Payload, (int32)PayloadBytes);
+}
+
+void FMCPWebSocket::EncodeCloseFrame(uint16 CloseCode, TArray<uint8>& Out)
+{
+	const uint8 Payload[2] = { (uint8)(CloseCode >> 8), (uint8)CloseCode };
+	EncodeFrame(EMCPWebSocketOpcode::Close, Payload, 2, Out);
+}
+
+FMCPWebSocketSession::FMCPWebSocketSession(FSocket* InSocket, int64 InMaxOutboxBytes)
+	: Socket(InSocket)
+	, MaxOutboxBytes(InMaxOutboxBytes)
+	, bClosed(false)
+{
+}
+
+bool FMCPWebSocketSession::Send(TArrayView<const uint8> Frame)
+{
+	FScopeLock Lock(&OutboxLock);
+	if (bClosed)
+	{
+		return false;
+	}
+
+	// A client that stops reading must not make the server buffer without bound
+	if (Outbox.Num() + (int64)Frame.Num() > MaxOutboxBytes)
+	{
+		bClosed = true;
+		return false;
+	}
+
+	Outbox.Append(Frame.GetData(), Frame.Num());
+	if (!FlushLocked())
+	{
+		bClosed = true;
+		return false;
+	}
+	return true;
+}
+
+bool FMCPWebSocketSession::Flush()
+{
+	FScopeLock Lock(&OutboxLock);
+	return !bClosed && FlushLocked();
+}
+
+bool FMCPWebSocketSession::HasPendingOutput() const
+{
+	FScopeLock Lock(&OutboxLock);
+	return Outbox.Num() > 0;
+}
+
+void FMCPWebSocketSession::MarkClosed()
+{
+	FScopeLock Lock(&OutboxLock);
+	bClosed = true;
+}
+
+bool FMCPWebSocketSession::FlushLocked()
+{
+	int32 Offset = 0;
+	while (Offset < Outbox.Num())
+	{
+		int32 BytesSent = 0;
+		if (Socket->Send(Outbox.GetData() + Offset, Outbox.Num() - Offset, BytesSent) && BytesSent > 0)
+		{
+			Offset += BytesSent;
+			continue;
+		}
+
+		if (ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK)
+		{
+			return false;
+		}
+		break;
+	}
+
+	Outbox.RemoveAt(0, Offset, EAllowShrinking::No);
+	return true;
+}
@@ -0,0 +1,257 @@
+#include "MCPWorkerPool.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/IQueuedWork.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Queued work item wrapping the caller's functions
+ */
+class FMCPWorkerPool::FWorkItem : public IQueuedWork
+{
+public:
+	FWorkItem(FMCPWorkerPool& InPool, const TSharedPtr<FGeneration, ESPMode::ThreadSafe>& InGeneration, TUniqueFunction<void()>&& InWork, TUniqueFunction<void()>&& InOnAbandon)
+		: Pool(InPool)
+		, Generation(InGeneration)
+		, Work(MoveTemp(InWork))
+		, OnAbandon(MoveTemp(InOnAbandon))
+	{
+	}
+
+	virtual void DoThreadedWork() override
+	{
+		Pool.OnItemStarted();
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		Work();
+
+		Pool.OnItemFinished(FPlatformTime::Cycles64() - StartCycles);
+		Generation->PendingItems.Decrement();
+		delete this;
+	}
+
+	virtual void Abandon() override
+	{
+		if (OnAbandon)
+		{
+			OnAbandon();
+		}
+		Pool.PendingItems.Decrement();
+		Generation->PendingItems.Decrement();
+		delete this;
+	}
+
+private:
+	FMCPWorkerPool& Pool;
+	TSharedPtr<FGeneration, ESPMode::ThreadSafe> Generation;
+	TUniqueFunction<void()> Work;
+	TUniqueFunction<void()> OnAbandon;
+};
+
+FMCPWorkerPool::FMCPWorkerPool()
+	: ThreadPool(nullptr)
+	, NumWorkers(0)
+	, QueueCapacity(0)
+	, PeakQueueDepth(0)
+	, StartCycles(0)
+{
+}
+
+FMCPWorkerPool::~FMCPWorkerPool()
+{
+	Shutdown();
+}
+
+bool FMCPWorkerPool::Start(int32 InNumWorkers, int32 InQueueCapacity)
+{
+	if (ThreadPool)
+	{
+		return false;
+	}
+
+	NumWorkers = FMath::Max(1, InNumWorkers);
+	QueueCapacity = FMath::Max(0, InQueueCapacity);
+
+	FQueuedThreadPool* NewThreadPool = CreateThreads(NumWorkers);
+	if (!NewThreadPool)
+	{
+		return false;
+	}
+
+	{
+		FWriteScopeLock WriteLock(GenerationLock);
+		ThreadPool = NewThreadPool;
+		Current = MakeShared<FGeneration, ESPMode::ThreadSafe>();
+		Current->ThreadPool = NewThreadPool;
+	}
+
+	PendingItems.Reset();
+	ActiveItems.Reset();
+	PeakQueueDepth.store(0);
+	CompletedItems.Reset();
+	RejectedItems.Reset();
+	BusyCycles.Reset();
+	StartCycles = FPlatformTime::Cycles64();
+	return true;
+}
+
+void FMCPWorkerPool::Shutdown()
+{
+	if (!ThreadPool)
+	{
+		return;
+	}
+
+	// Stop admissions first so nothing lands on threads that are being destroyed
+	TSharedPtr<FGeneration, ESPMode::ThreadSafe> Stopping;
+	{
+		FWriteScopeLock WriteLock(GenerationLock);
+		Stopping = MoveTemp(Current);
+		ThreadPool = nullptr;
+	}
+
+	// Destroy() abandons queued items and blocks until running items return
+	Stopping->ThreadPool->Destroy();
+	delete Stopping->ThreadPool;
+	Stopping->ThreadPool = nullptr;
+
+	DestroyRetiredGenerations(true);
+}
+
+bool FMCPWorkerPool::Resize(int32 InNumWorkers, int32 InQueueCapacity)
+{
+	if (!ThreadPool)
+	{
+		return false;
+	}
+
+	QueueCapacity = FMath::Max(0, InQueueCapacity);
+
+	// Old generations that have finished their work can go now
+	DestroyRetiredGenerations(false);
+
+	const int32 NewNumWorkers = FMath::Max(1, InNumWorkers);
+	if (NewNumWorkers == NumWorkers)
+	{
+		return true;
+	}
+
+	FQueuedThreadPool* NewThreadPool = CreateThreads(NewNumWorkers);
+	if (!NewThreadPool)
+	{
+		return false;
+	}
+
+	TSharedPtr<FGeneration, ESPMode::ThreadSafe> NewGeneration = MakeShared<FGeneration, ESPMode::ThreadSafe>();
+	NewGeneration->ThreadPool = NewThreadPool;
+	{
+		FWriteScopeLock WriteLock(GenerationLock);
+		Retired.Add(MoveTemp(Current));
+		Current = NewGeneration;
+		ThreadPool = NewThreadPool;
+		NumWorkers = NewNumWorkers;
+
+		// Utilization is measured against the new worker count from here on
+		BusyCycles.Reset();
+		StartCycles = FPlatformTime::Cycles64();
+	}
+
+	DestroyRetiredGenerations(false);
+	return true;
+}
+
+FQueuedThreadPool* FMCPWorkerPool::CreateThreads(int32 NumThreads)
+{
+	FQueuedThreadPool* NewThreadPool = FQueuedThreadPool::Allocate();
+	if (!NewThreadPool->Create(NumThreads, 128 * 1024, TPri_Normal, TEXT("MCPWorkerPool")))
+	{
+		delete NewThreadPool;
+		return nullptr;
+	}
+	return NewThreadPool;
+}
+
+void FMCPWorkerPool::DestroyRetiredGenerations(bool bForce)
+{
+	TArray<TSharedPtr<FGeneration, ESPMode::ThreadSafe>> ToDestroy;
+	{
+		FWriteScopeLock WriteLock(GenerationLock);
+		for (int32 Index = Retired.Num() - 1; Index >= 0; --Index)
+		{
+			if (bForce || Retired[Index]->PendingItems.GetValue() == 0)
+			{
+				ToDestroy.Add(Retired[Index]);
+				Retired.RemoveAtSwap(Index);
+			}
+		}
+	}
+
+	// Idle threads exit immediately; a forced shutdown abandons queued items like Shutdown() does
+	for (const TSharedPtr<FGeneration, ESPMode::ThreadSafe>& Generation : ToDestroy)
+	{
+		Generation->ThreadPool->Destroy();
+		delete Generation->ThreadPool;
+		Generation->ThreadPool = nullptr;
+	}
+}
+
+bool FMCPWorkerPool::TryEnqueue(TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnAbandon)
+{
+	FReadScopeLock ReadLock(GenerationLock);
+	if (!Current.IsValid())
+	{
+		return false;
+	}
+
+	// Reserve a slot first so concurrent producers can never overshoot the bound
+	const int32 Pending = PendingItems.Increment();
+	if (Pending > NumWorkers + QueueCapacity)
+	{
+		PendingItems.Decrement();
+		RejectedItems.Increment();
+		return false;
+	}
+
+	const int32 QueueDepth = Pending - ActiveItems.GetValue();
+	int32 Peak = PeakQueueDepth.load(std::memory_order_relaxed);
+	while (QueueDepth > Peak && !PeakQueueDepth.compare_exchange_weak(Peak, QueueDepth, std::memory_order_relaxed))
+	{
+	}
+
+	Current->PendingItems.Increment();
+	Current->ThreadPool->AddQueuedWork(new FWorkItem(*this, Current, MoveTemp(Work), MoveTemp(OnAbandon)));
+	return true;
+}
+
+FMCPWorkerPoolStats FMCPWorkerPool::GetStats() const
+{
+	FReadScopeLock ReadLock(GenerationLock);
+
+	FMCPWorkerPoolStats Stats;
+	Stats.NumWorkers = NumWorkers;
+	Stats.QueueCapacity = QueueCapacity;
+	Stats.ActiveWorkers = ActiveItems.GetValue();
+	Stats.QueueDepth = FMath::Max(0, PendingItems.GetValue() - Stats.ActiveWorkers);
+	Stats.PeakQueueDepth = PeakQueueDepth.load(std::memory_order_relaxed);
+	Stats.CompletedItems = CompletedItems.GetValue();
+	Stats.RejectedItems = RejectedItems.GetValue();
+
+	const uint64 ElapsedCycles = FPlatformTime::Cycles64() - StartCycles;
+	if (ThreadPool && ElapsedCycles > 0 && NumWorkers > 0)
+	{
+		Stats.Utilization = FMath::Clamp((double)BusyCycles.GetValue() / ((double)ElapsedCycles * NumWorkers), 0.0, 1.0);
+	}
+	return Stats;
+}
+
+void FMCPWorkerPool::OnItemStarted()
+{
+	ActiveItems.Increment();
+}
+
+void FMCPWorkerPool::OnItemFinished(uint64 ItemBusyCycles)
+{
+	BusyCycles.Add((int64)ItemBusyCycles);
+	CompletedItems.Increment();
+	ActiveItems.Decrement();
+	PendingItems.Decrement();
+}
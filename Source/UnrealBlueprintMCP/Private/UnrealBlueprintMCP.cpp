@@ -584,16 +584,23 @@ void FUnrealBlueprintMCPModule::OnApplyServerSettings(const UMCPServerSettings*
 		return;
 	}
 
-	// If server is running, check if restart is needed
-	if (IsServerRunning())
+	if (!JsonRpcServer.IsValid())
 	{
-		// For now, just show a notification that restart is recommended
-		// In a full implementation, you might want to dynamically apply some settings
-		FNotificationInfo Info(LOCTEXT("ServerRestartRecommended", "Server restart recommended to apply all settings"));
-		Info.ExpireDuration = 5.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-		
-		UE_LOG(LogTemp, Warning, TEXT("MCP Server settings applied. Restart recommended for full effect."));
+		return;
+	}
+
+	// Every setting applies live; a port change moves the listener without dropping clients
+	const int32 OldPort = JsonRpcServer->GetPort();
+	JsonRpcServer->ApplySettings(Settings);
+
+	if (IsServerRunning() && JsonRpcServer->GetPort() != OldPort)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealBlueprintMCP: JSON-RPC Server moved to port %d"), JsonRpcServer->GetPort());
+		UpdateDashboardStatus();
+		if (ToolbarWidget.IsValid())
+		{
+			ToolbarWidget->UpdateServerStatus(true, JsonRpcServer->GetPort(), JsonRpcServer->GetConnectedClientCount());
+		}
 	}
 }
 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <atomic>
+
+class UBlueprint;
+class FObjectPreSaveContext;
+
+/**
+ * Snapshot of Blueprint refresh scheduler counters
+ */
+struct FMCPBlueprintRefreshStats
+{
+	/** UMCPServerSettings::BlueprintRefreshDelayMs; 0 refreshes right after every edit */
+	double DelayMs = 0.0;
+
+	/** Blueprints edited and not refreshed yet */
+	int32 Pending = 0;
+
+	/** Edits reported with MarkDirty() */
+	int64 Edits = 0;
+
+	/** RefreshAllNodes passes run, and edits that did not need one of their own */
+	int64 Refreshes = 0;
+	int64 Coalesced = 0;
+
+	/** Blueprints compiled, and the compilation manager passes that compiled them */
+	int64 Compiles = 0;
+	int64 CompilePasses = 0;
+
+	/** Refreshes run early because the Blueprint was about to be read, saved or played */
+	int64 ForcedFlushes = 0;
+};
+
+/**
+ * Refreshes edited Blueprints once edits to them stop, instead of after every edit
+ *
+ * RefreshAllNodes costs more the larger the Blueprint, and clients tend to edit the same one many
+ * times in a row. An edit only marks its Blueprint dirty; once no edit has come in for the delay,
+ * each dirty Blueprint is refreshed once, and the ones that asked for a compile are queued with
+ * FBlueprintCompilationManager and compiled together in one pass. Anything about to read a
+ * Blueprint calls Flush() first, and saves and Play In Editor flush everything, so nobody sees a
+ * Blueprint with stale nodes.
+ *
+ * Game thread only, apart from SetDelay() and GetStats().
+ */
+class UNREALBLUEPRINTMCP_API FMCPBlueprintRefreshScheduler
+{
+public:
+	FMCPBlueprintRefreshScheduler();
+	~FMCPBlueprintRefreshScheduler();
+
+	/** Start refreshing from the core ticker, and before saves and Play In Editor */
+	void Start();
+
+	/** Refresh whatever is pending and stop */
+	void Shutdown();
+
+	void SetDelay(double Seconds);
+
+	/** Schedule a refresh of Blueprint, and a compile if bCompile; without a delay, run it now */
+	void MarkDirty(UBlueprint& Blueprint, bool bCompile = false);
+
+	/** Refresh those of Blueprints that are pending now, compiling them in one pass */
+	void Flush(TConstArrayView<UBlueprint*> Blueprints);
+	void Flush(UBlueprint& Blueprint)
+	{
+		UBlueprint* Single = &Blueprint;
+		Flush(MakeArrayView(&Single, 1));
+	}
+
+	/** Refresh every pending Blueprint now */
+	void FlushAll();
+
+	FMCPBlueprintRefreshStats GetStats() const;
+
+private:
+	struct FPending
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		bool bCompile = false;
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** Refresh Entries, then compile those that asked for it */
+	void Refresh(TArray<FPending>&& Entries);
+
+	void HandleObjectPreSave(UObject* Object, FObjectPreSaveContext Context);
+	void HandlePreBeginPIE(bool bIsSimulating);
+
+	/** In the order they were first edited */
+	TArray<FPending> PendingBlueprints;
+
+	/** When the last edit arrived */
+	double LastEditSeconds = 0.0;
+
+	std::atomic<double> DelaySeconds;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PreSaveHandle;
+	FDelegateHandle PreBeginPIEHandle;
+
+	FThreadSafeCounter PendingCount;
+	FThreadSafeCounter64 Edits;
+	FThreadSafeCounter64 Refreshes;
+	FThreadSafeCounter64 Coalesced;
+	FThreadSafeCounter64 Compiles;
+	FThreadSafeCounter64 CompilePasses;
+	FThreadSafeCounter64 ForcedFlushes;
+};
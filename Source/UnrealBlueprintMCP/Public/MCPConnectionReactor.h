@@ -0,0 +1,206 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "MCPHttpRequestParser.h"
+#include "MCPHttpResponse.h"
+#include "MCPLocalSocket.h"
+#include "MCPTimerWheel.h"
+#include "Dom/JsonObject.h"
+
+class FMCPJsonWriter;
+
+/**
+ * What a connection parked with FMCPConnectionReactor is waiting for; also picks its deadline
+ */
+enum class EMCPConnectionPhase : uint8
+{
+	/** Between requests: waiting for the first byte of the next one */
+	Idle,
+	/** Part of a request has arrived: waiting for the rest */
+	Reading,
+	/** The client is not taking the response as fast as it is sent: waiting to send more */
+	Writing
+};
+
+/**
+ * One client connection and the state that outlives a single request
+ *
+ * A worker owns the connection while it serves a request. In between, and whenever a slow client
+ * would make the worker wait, the connection is parked with the reactor and no thread waits on it.
+ */
+struct UNREALBLUEPRINTMCP_API FMCPConnection
+{
+	FMCPConnection(FMCPLocalSocket* InSocket, int32 MaxHeaderBytes, int64 MaxBodyBytes);
+
+	FMCPLocalSocket* Socket;
+
+	/** Receive buffer and parser state; survives across requests so pipelined bytes are kept */
+	FMCPHttpRequestParser Parser;
+
+	/** Response buffers are reused for every request on this connection */
+	FMCPHttpResponse Response;
+
+	/** Requests received on this connection */
+	int32 RequestsServed = 0;
+
+	EMCPConnectionPhase Phase = EMCPConnectionPhase::Idle;
+
+	/** FPlatformTime::Seconds() by which the current phase has to complete */
+	double Deadline = 0.0;
+
+	/** Bytes of Response already sent, header block first */
+	int64 BytesSent = 0;
+
+	/** Close once Response is sent instead of waiting for another request */
+	bool bCloseAfterResponse = false;
+
+	/**
+	 * Set while the current request waits for a game-thread call and no thread holds the
+	 * connection; the worker that picks it up again answers with PendingResponse, with the
+	 * streamed result PendingStream writes or, for a batch, with the response array PendingBatch
+	 * appends to the body (it returns how many it wrote)
+	 */
+	bool bAwaitingGameThread = false;
+	TSharedPtr<FJsonObject> PendingResponse;
+	TFunction<void(FMCPJsonWriter&)> PendingStream;
+	TFunction<int32(TArray<uint8>&)> PendingBatch;
+
+	/** Reactor bookkeeping while parked */
+	int32 TimerId = INDEX_NONE;
+	int32 ParkedIndex = INDEX_NONE;
+};
+
+/**
+ * Snapshot of reactor counters
+ */
+struct FMCPConnectionReactorStats
+{
+	/** Connections currently waiting in the reactor */
+	int32 ParkedConnections = 0;
+
+	/** Keep-alive connections closed after waiting TimeoutSeconds for another request */
+	int64 IdleTimeouts = 0;
+
+	/** Connections closed because a request did not arrive in full within TimeoutSeconds */
+	int64 ReadTimeouts = 0;
+
+	/** Connections closed because the client stopped reading its response */
+	int64 WriteTimeouts = 0;
+};
+
+/**
+ * Single I/O thread that waits on every parked connection at once
+ *
+ * Workers park a connection instead of blocking on it: between keep-alive requests, while a request
+ * is still arriving, or while a response waits for the client to read. The reactor polls all parked
+ * sockets in one call and keeps their deadlines in a hashed timer wheel. A socket that becomes ready
+ * goes back to the worker pool through OnReady; one whose deadline passes goes to OnClose. Idle and
+ * slow clients therefore cost a socket and a few hundred bytes, not a worker thread.
+ */
+class UNREALBLUEPRINTMCP_API FMCPConnectionReactor : public FRunnable
+{
+public:
+	/** Receives ownership of a connection; called on the reactor thread */
+	typedef TFunction<void(FMCPConnection*)> FConnectionCallback;
+
+	/** Called once on the reactor thread; see AddTimer() */
+	typedef TUniqueFunction<void()> FTimerCallback;
+
+	FMCPConnectionReactor();
+	virtual ~FMCPConnectionReactor();
+
+	/** Start the I/O thread; returns false if it is already running or could not be created */
+	bool Start(FConnectionCallback InOnReady, FConnectionCallback InOnClose);
+
+	/** Stop the I/O thread and hand every parked connection to OnClose */
+	void Shutdown();
+
+	/**
+	 * Watch Connection until its socket is ready for its Phase or its Deadline passes. Callable from
+	 * any thread; the reactor owns the connection from here on. Once stopped, OnClose runs right away.
+	 */
+	void Park(FMCPConnection* Connection);
+
+	/** Close idle connections now and as they are parked from here on; used while the server drains */
+	void CloseIdleConnections();
+
+	/**
+	 * Run Callback on the reactor thread once DeadlineSeconds has passed; callable from any thread.
+	 * Timers cannot be cancelled, so a callback that is no longer needed should do nothing. Timers
+	 * still pending when the reactor stops run then; once stopped, Callback runs right away.
+	 */
+	void AddTimer(double DeadlineSeconds, FTimerCallback Callback);
+
+	/** Get a snapshot of the reactor counters */
+	FMCPConnectionReactorStats GetStats() const;
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	/** Interrupt the poll so newly parked connections are picked up */
+	void Wake();
+
+	/** Start watching a connection handed over by Park(), or close it if it is idle and the server drains */
+	void Adopt(FMCPConnection* Connection, TArray<FMCPConnection*>& OutClosed);
+
+	/** Stop watching a connection */
+	void Unpark(FMCPConnection* Connection);
+
+	FConnectionCallback OnReady;
+	FConnectionCallback OnClose;
+
+	FRunnableThread* Thread;
+
+	/** Connected pair; a byte written to WakeWriter ends the poll */
+	FMCPLocalSocket* WakeReader;
+	FMCPLocalSocket* WakeWriter;
+
+	/** Connections handed over by Park() and not yet adopted by the reactor thread */
+	TArray<FMCPConnection*> Incoming;
+
+	struct FTimer
+	{
+		double DeadlineSeconds = 0.0;
+		FTimerCallback Callback;
+	};
+
+	/** Timers handed over by AddTimer() and not yet scheduled by the reactor thread */
+	TArray<FTimer> IncomingTimers;
+
+	/** Guards Incoming, IncomingTimers and bAcceptingParks */
+	FCriticalSection IncomingLock;
+
+	/** False once Shutdown() started; Park() closes connections itself from then on */
+	bool bAcceptingParks;
+
+	FThreadSafeBool bStopping;
+	FThreadSafeBool bCloseIdle;
+
+	/** Reactor thread only: watched connections, their deadlines, and the poll set mirroring them */
+	TArray<FMCPConnection*> Parked;
+	FMCPTimerWheel Wheel;
+	TArray<FMCPPollEntry> PollEntries;
+
+	/** Reactor thread only: scheduled timer callbacks, keyed by index in TimerWheel */
+	TSparseArray<FTimerCallback> Timers;
+	FMCPTimerWheel TimerWheel;
+
+	FThreadSafeCounter ParkedConnections;
+	FThreadSafeCounter64 IdleTimeouts;
+	FThreadSafeCounter64 ReadTimeouts;
+	FThreadSafeCounter64 WriteTimeouts;
+
+	/** Deadline resolution; timeouts are whole seconds, so being up to a tick late does not matter */
+	static constexpr double TickSeconds = 0.1;
+
+	/** One revolution covers 51.2 s, which is most timeouts without a second lap */
+	static constexpr int32 NumSlots = 512;
+};
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "Async/Future.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include <atomic>
+
+/**
+ * Snapshot of an FMCPLatencyHistogram
+ */
+struct FMCPLatencyHistogramSnapshot
+{
+	/** Samples per bucket; bucket i holds durations up to GetBucketUpperMs(i) */
+	TArray<int64> Buckets;
+
+	int64 Count = 0;
+	double TotalMs = 0.0;
+	double MaxMs = 0.0;
+
+	/** Upper bound of the bucket holding the given fraction of samples, capped at MaxMs */
+	double GetPercentileMs(double Fraction) const;
+
+	double GetMeanMs() const { return Count > 0 ? TotalMs / (double)Count : 0.0; }
+
+	static double GetBucketUpperMs(int32 Index);
+};
+
+/**
+ * Lock-free histogram of durations in power-of-two microsecond buckets, from 1 us to about 8 s
+ */
+class UNREALBLUEPRINTMCP_API FMCPLatencyHistogram
+{
+public:
+	FMCPLatencyHistogram();
+
+	void Add(double Seconds);
+
+	FMCPLatencyHistogramSnapshot GetSnapshot() const;
+
+	static constexpr int32 NumBuckets = 24;
+
+private:
+	std::atomic<int64> Buckets[NumBuckets];
+	std::atomic<int64> Count;
+	std::atomic<int64> TotalMicroseconds;
+	std::atomic<int64> MaxMicroseconds;
+};
+
+/**
+ * Snapshot of game-thread queue counters
+ */
+struct FMCPGameThreadQueueStats
+{
+	/** Game-thread time each editor frame may spend on queued work */
+	double BudgetMs = 0.0;
+
+	/** Tasks waiting for the game thread */
+	int32 QueueDepth = 0;
+
+	/** Highest queue depth observed */
+	int32 PeakQueueDepth = 0;
+
+	int64 TasksExecuted = 0;
+
+	/** Drains that ran at least one task, and the most tasks one of them ran */
+	int64 Drains = 0;
+	int32 MaxTasksPerDrain = 0;
+
+	/** Drains that ran past the budget because a single task took longer than what was left */
+	int64 OverBudgetDrains = 0;
+
+	/** Calls that were cancelled, or had expired, before the game thread got to them, and never ran */
+	int64 SkippedCalls = 0;
+
+	/** Time from Enqueue() until the task started */
+	FMCPLatencyHistogramSnapshot QueueWait;
+
+	/** Time the task ran for */
+	FMCPLatencyHistogramSnapshot Execute;
+
+	/** Game-thread time per drain, i.e. what queued work added to an editor frame */
+	FMCPLatencyHistogramSnapshot DrainTime;
+
+	/** Editor frame time while work was queued */
+	FMCPLatencyHistogramSnapshot FrameTime;
+};
+
+/**
+ * Where a call queued with FMCPGameThreadQueue::Call() has got to
+ */
+enum class EMCPGameThreadCallPhase : uint8
+{
+	Queued,
+	Running,
+	Done,
+	/** Will not run: cancelled, or still queued when its deadline passed */
+	Skipped
+};
+
+/**
+ * State shared by a queued call, its caller, and whatever cancels it on a timeout
+ *
+ * The task's result goes into the promise rather than anywhere the caller owns, so a caller that
+ * gives up leaves nothing for the game thread to write through. The future resolves exactly once:
+ * with the result, or unset as soon as the call is cancelled, even if its task is already running;
+ * a result that arrives after that is dropped.
+ */
+template<typename ResultType>
+struct TMCPGameThreadCallState
+{
+	std::atomic<EMCPGameThreadCallPhase> Phase{EMCPGameThreadCallPhase::Queued};
+	std::atomic<bool> bResolved{false};
+	TPromise<TOptional<ResultType>> Promise;
+
+	/** Fulfil the promise unless something else got there first */
+	void Resolve(TOptional<ResultType>&& Value)
+	{
+		if (!bResolved.exchange(true))
+		{
+			Promise.SetValue(MoveTemp(Value));
+		}
+	}
+
+	/** Resolve the future unset now; returns whether this kept the task from running */
+	bool Cancel()
+	{
+		EMCPGameThreadCallPhase Expected = EMCPGameThreadCallPhase::Queued;
+		const bool bPrevented = Phase.compare_exchange_strong(Expected, EMCPGameThreadCallPhase::Skipped);
+		Resolve(TOptional<ResultType>());
+		return bPrevented;
+	}
+};
+
+/**
+ * Handle to a call queued with FMCPGameThreadQueue::Call()
+ */
+template<typename ResultType>
+struct TMCPGameThreadCall
+{
+	typedef TSharedRef<TMCPGameThreadCallState<ResultType>, ESPMode::ThreadSafe> FStateRef;
+
+	FStateRef State;
+
+	/** Set to the task's result, or unset if the call was cancelled or expired */
+	TFuture<TOptional<ResultType>> Future;
+
+	bool Cancel() const { return State->Cancel(); }
+};
+
+/**
+ * Work the server needs done on the game thread, drained once per editor frame within a budget
+ *
+ * Any thread can queue a task; the queue is a lock-free multi-producer, single-consumer list.
+ * The core ticker drains it on the game thread every frame, running tasks in the order they were
+ * queued until the frame's budget is spent, so a burst of hundreds of requests is spread over
+ * frames instead of landing in one, and many requests share one wake-up of the game thread. At
+ * least one task runs per frame, however long it takes, so the queue always makes progress.
+ *
+ * Tasks left when the ticker stops stay queued until Drain() is called or the ticker restarts.
+ */
+class UNREALBLUEPRINTMCP_API FMCPGameThreadQueue
+{
+public:
+	FMCPGameThreadQueue();
+	~FMCPGameThreadQueue();
+
+	/** Start draining from the core ticker */
+	void Start();
+
+	/** Stop draining from the core ticker */
+	void Shutdown();
+
+	void SetBudget(double Seconds);
+
+	/** Queue Task to run on the game thread; safe from any thread */
+	void Enqueue(TUniqueFunction<void()>&& Task);
+
+	/**
+	 * Queue Task and return the future of its result instead of waiting for it; safe from any
+	 * thread. If the game thread only gets to the call after TimeoutSeconds, or it was cancelled
+	 * by then, Task is not run and the future resolves unset. A call that has started is not
+	 * interrupted; cancelling it only stops anyone from waiting for it.
+	 */
+	template<typename ResultType>
+	TMCPGameThreadCall<ResultType> Call(TUniqueFunction<ResultType()>&& Task, double TimeoutSeconds)
+	{
+		typename TMCPGameThreadCall<ResultType>::FStateRef State = MakeShared<TMCPGameThreadCallState<ResultType>, ESPMode::ThreadSafe>();
+		TMCPGameThreadCall<ResultType> Handle{State, State->Promise.GetFuture()};
+
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		Enqueue([this, State, Task = MoveTemp(Task), Deadline]()
+		{
+			EMCPGameThreadCallPhase Expected = EMCPGameThreadCallPhase::Queued;
+			if (FPlatformTime::Seconds() > Deadline || !State->Phase.compare_exchange_strong(Expected, EMCPGameThreadCallPhase::Running))
+			{
+				SkippedCalls.Increment();
+				State->Cancel();
+				return;
+			}
+
+			TOptional<ResultType> Result(Task());
+			State->Phase = EMCPGameThreadCallPhase::Done;
+			State->Resolve(MoveTemp(Result));
+		});
+		return Handle;
+	}
+
+	/**
+	 * Run queued tasks on the game thread until the queue is empty or BudgetSeconds have passed.
+	 * Returns the number of tasks run; 0 when called from inside a task that is being drained.
+	 */
+	int32 Drain(double BudgetSeconds);
+
+	/** Whether the game thread is inside Drain(), i.e. running a queued task */
+	bool IsDraining() const { return bDraining; }
+
+	FMCPGameThreadQueueStats GetStats() const;
+
+private:
+	struct FTask
+	{
+		TUniqueFunction<void()> Function;
+		double EnqueueSeconds = 0.0;
+	};
+
+	bool Tick(float DeltaTime);
+
+	TQueue<FTask, EQueueMode::Mpsc> Tasks;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Game thread only */
+	bool bDraining = false;
+
+	std::atomic<double> BudgetSeconds;
+
+	FThreadSafeCounter QueueDepth;
+	std::atomic<int32> PeakQueueDepth;
+	FThreadSafeCounter64 TasksExecuted;
+	FThreadSafeCounter64 Drains;
+	std::atomic<int32> MaxTasksPerDrain;
+	FThreadSafeCounter64 OverBudgetDrains;
+	FThreadSafeCounter64 SkippedCalls;
+
+	FMCPLatencyHistogram QueueWait;
+	FMCPLatencyHistogram Execute;
+	FMCPLatencyHistogram DrainTime;
+	FMCPLatencyHistogram FrameTime;
+};
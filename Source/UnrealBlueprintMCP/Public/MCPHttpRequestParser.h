@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Result of feeding bytes to FMCPHttpRequestParser
+ */
+enum class EMCPHttpParseResult : uint8
+{
+	/** The request is not complete yet; receive more bytes and parse again */
+	NeedMoreData,
+	/** A full request (headers and body) is available via GetRequest() */
+	Complete,
+	/** The request is malformed or too large; see GetErrorStatusCode() */
+	Error
+};
+
+/**
+ * A parsed HTTP/1.x request. The body is a view into the parser's receive buffer and
+ * stays valid until FMCPHttpRequestParser::ConsumeRequest() is called.
+ */
+struct UNREALBLUEPRINTMCP_API FMCPHttpRequest
+{
+	/** Request method, e.g. "POST" */
+	FString Method;
+
+	/** Request target, e.g. "/" */
+	FString Target;
+
+	/** Protocol version, e.g. "HTTP/1.1" */
+	FString Version;
+
+	/** Header fields in arrival order; names are lower-cased */
+	TArray<TPair<FString, FString>> Headers;
+
+	/** Raw UTF-8 body bytes */
+	TArrayView<const uint8> Body;
+
+	/** Find a header value by lower-case name, or nullptr if absent */
+	const FString* FindHeader(const TCHAR* LowerCaseName) const;
+
+	/** Check whether the client wants the connection kept open after this request */
+	bool IsKeepAlive() const;
+
+	void Reset();
+};
+
+/**
+ * Incremental HTTP/1.x request parser
+ *
+ * Bytes are received straight into the parser's buffer (GetWriteBuffer/CommitWrite) and
+ * Parse() only scans bytes it has not seen before, so a request of any size is parsed in
+ * linear time. Bodies are framed by Content-Length; the buffer is sized once the length
+ * is known so multi-megabyte bodies do not reallocate repeatedly. Pipelined requests are
+ * kept in the buffer and parsed after ConsumeRequest().
+ */
+class UNREALBLUEPRINTMCP_API FMCPHttpRequestParser
+{
+public:
+	FMCPHttpRequestParser(int32 InMaxHeaderBytes = 64 * 1024, int64 InMaxBodyBytes = 64 * 1024 * 1024);
+
+	/** Get space for at least MinBytes of incoming data; follow with CommitWrite() */
+	uint8* GetWriteBuffer(int32 MinBytes);
+
+	/** Mark BytesWritten bytes of the write buffer as received */
+	void CommitWrite(int32 BytesWritten);
+
+	/** Suggested size for the next receive: the rest of the body when known, else a small chunk */
+	int32 GetRecommendedReadSize() const;
+
+	/** Advance the state machine over newly received bytes */
+	EMCPHttpParseResult Parse();
+
+	/** The request parsed by the last Parse() that returned Complete */
+	const FMCPHttpRequest& GetRequest() const { return Request; }
+
+	/** Drop the completed request, keeping any bytes of a pipelined next request */
+	void ConsumeRequest();
+
+	/** True if bytes of an unfinished request are buffered */
+	bool HasBufferedData() const { return ValidBytes > 0; }
+
+	/** Bytes received beyond the consumed requests, e.g. to hand over to another protocol after an Upgrade */
+	TArrayView<const uint8> GetBufferedBytes() const { return TArrayView<const uint8>(Buffer.GetData(), ValidBytes); }
+
+	/** HTTP status code describing the last parse error (400, 413, 431, 501) */
+	int32 GetErrorStatusCode() const { return ErrorStatusCode; }
+
+	/** Human readable description of the last parse error */
+	const FString& GetErrorMessage() const { return ErrorMessage; }
+
+private:
+	enum class EState : uint8
+	{
+		RequestLine,
+		Headers,
+		Body,
+		Complete,
+		Error
+	};
+
+	/** Find the next line terminator at or after ScanOffset; returns the line length excluding CR/LF or INDEX_NONE */
+	int32 FindLineEnd(int32& OutNextLineStart);
+
+	bool ParseRequestLine(const ANSICHAR* Line, int32 Length);
+	bool ParseHeaderLine(const ANSICHAR* Line, int32 Length);
+	bool OnHeadersComplete();
+	EMCPHttpParseResult SetError(int32 StatusCode, const FString& Message);
+
+	/** Receive buffer; always starts at the first byte of the current request */
+	TArray<uint8> Buffer;
+
+	/** Number of valid bytes in Buffer (the tail beyond this is write space) */
+	int32 ValidBytes;
+
+	/** First byte not yet examined by the line scanner */
+	int32 ScanOffset;
+
+	/** Start of the line currently being scanned */
+	int32 LineStart;
+
+	/** Offset of the first body byte */
+	int32 BodyStart;
+
+	/** Declared body length */
+	int64 ContentLength;
+
+	int32 MaxHeaderBytes;
+	int64 MaxBodyBytes;
+
+	EState State;
+	FMCPHttpRequest Request;
+
+	int32 ErrorStatusCode;
+	FString ErrorMessage;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Compression.h"
+
+/**
+ * HTTP response assembled directly as UTF-8 bytes
+ *
+ * The header block and the body live in two separate buffers that are sent back to back
+ * (scatter/gather), so the body never has to be copied behind the headers. One instance
+ * is kept per connection and Reset() between requests, which keeps the buffers' capacity
+ * and makes steady-state responses allocation free.
+ */
+struct UNREALBLUEPRINTMCP_API FMCPHttpResponse
+{
+	/** Status line and header fields, terminated by an empty line once FinishHeaders() ran */
+	TArray<uint8> Header;
+
+	/** Response body; Content-Length is always Body.Num() */
+	TArray<uint8> Body;
+
+	/** Bytes written into Header/Body while building this response */
+	int64 BytesCopied = 0;
+
+	/** Times Header or Body had to grow while building this response */
+	int32 Allocations = 0;
+
+	/**
+	 * Produces the body incrementally instead of filling Body.
+	 * When set, the body is sent with Transfer-Encoding: chunked and Body stays empty.
+	 */
+	TFunction<void(FArchive&)> BodyStreamer;
+
+	/** Content-Encoding applied to Body by CompressBody(), NAME_None for identity */
+	FName ContentEncoding;
+
+	/** Spare buffer compression writes into before it is swapped with Body; capacity is kept across requests */
+	TArray<uint8> Scratch;
+
+	/** Clear both buffers and any streamer for the next response, keeping buffer capacity */
+	void Reset();
+
+	/** Replace the body with raw UTF-8 bytes */
+	void SetBody(const ANSICHAR* Utf8, int32 Length);
+	void SetBody(const ANSICHAR* Utf8Literal) { SetBody(Utf8Literal, FCStringAnsi::Strlen(Utf8Literal)); }
+
+	/** Replace the body with the UTF-8 encoding of Text */
+	void SetBody(const FString& Text);
+
+	/**
+	 * Compress Body in place with NAME_Gzip or NAME_Zlib.
+	 * Leaves Body untouched and returns false if compression fails or would not make it smaller.
+	 */
+	bool CompressBody(FName FormatName, ECompressionFlags Flags);
+
+	/**
+	 * Pick the response encoding for an Accept-Encoding header value: NAME_Gzip, NAME_Zlib ("deflate"),
+	 * or NAME_None when the client accepts neither. q-values are honored; gzip wins ties.
+	 */
+	static FName NegotiateContentEncoding(const FString* AcceptEncoding);
+
+	/** HTTP content-coding token for a compression format */
+	static const ANSICHAR* GetContentEncodingToken(FName FormatName);
+
+	/** Start the header block with the status line */
+	void BeginHeaders(int32 StatusCode);
+
+	/** Append one header field */
+	void AddHeader(const ANSICHAR* Name, const ANSICHAR* Value);
+	void AddHeader(const ANSICHAR* Name, const FString& Value);
+	void AddHeader(const ANSICHAR* Name, int64 Value);
+
+	/** Append a pre-formatted block of header lines, each already terminated by CRLF */
+	void AddRawHeaders(const uint8* Data, int32 Length);
+
+	/** Terminate the header block */
+	void FinishHeaders();
+
+	/** Check whether the body is produced by BodyStreamer */
+	bool IsStreamed() const { return (bool)BodyStreamer; }
+
+	/** Total bytes on the wire; excludes streamed bodies, which are never held in full */
+	int64 GetTotalSize() const { return (int64)Header.Num() + Body.Num(); }
+
+	/** Standard reason phrase for a status code */
+	static const ANSICHAR* GetReasonPhrase(int32 StatusCode);
+
+	/** Append bytes to a buffer, tracking copies and growth */
+	void Append(TArray<uint8>& Buffer, const void* Data, int32 Length);
+};
+
+/**
+ * Settings-dependent part of the response header block, compiled once per ApplySettings
+ *
+ * Instances are immutable after Build(); the server swaps in a new one when settings change,
+ * and in-flight responses keep the one they started with. Only the Access-Control-Allow-Origin
+ * line depends on the request, everything else is copied verbatim.
+ */
+struct UNREALBLUEPRINTMCP_API FMCPHttpHeaderBlock
+{
+	/** "Connection: keep-alive" plus the Keep-Alive parameters */
+	TArray<uint8> KeepAliveLines;
+
+	/** "Connection: close" */
+	TArray<uint8> CloseLines;
+
+	/** CORS, Vary, custom and security header lines that are the same for every response */
+	TArray<uint8> StaticLines;
+
+	/** Whether CORS headers are sent at all */
+	bool bEnableCORS = false;
+
+	/** CORS is enabled with no origin list, so every origin is allowed via "*" (already in StaticLines) */
+	bool bAllowAnyOrigin = false;
+
+	/** Allowed origins, lower-cased for case-insensitive matching */
+	TSet<FString> AllowedOrigins;
+
+	static TSharedRef<const FMCPHttpHeaderBlock, ESPMode::ThreadSafe> Build(
+		bool bInEnableCORS,
+		const TArray<FString>& InAllowedOrigins,
+		const TMap<FString, FString>& CustomHeaders,
+		int32 TimeoutSeconds,
+		int32 MaxRequestsPerConnection,
+		bool bCompressionEnabled);
+
+	/** Check whether the request's Origin header value is in the allowed set */
+	bool IsOriginAllowed(const FString& Origin) const;
+};
+
+/**
+ * Archive that frames everything written to it as HTTP/1.1 chunks
+ *
+ * Output is collected in one fixed-size buffer and handed to the sink each time it fills,
+ * so memory stays bounded no matter how much a streamer writes. Each buffer starts with a
+ * reserved, zero-padded size line, which lets a chunk go out in a single send. Once the sink
+ * fails the archive is marked as errored and further writes are dropped.
+ */
+class UNREALBLUEPRINTMCP_API FMCPChunkedArchive : public FArchive
+{
+public:
+	/** Sink receives complete chunks and returns false if the client can no longer be written to */
+	FMCPChunkedArchive(TFunction<bool(const uint8*, int32)> InSink, int32 InChunkBytes = 32 * 1024);
+
+	virtual void Serialize(void* Data, int64 Length) override;
+	virtual FString GetArchiveName() const override { return TEXT("FMCPChunkedArchive"); }
+
+	/** Send any buffered data followed by the terminating zero-length chunk; returns false on send failure */
+	bool Finish();
+
+	/** Body bytes written so far, excluding chunk framing */
+	int64 GetBodyBytes() const { return BodyBytes; }
+
+	/** Sends handed to the sink so far */
+	int32 GetChunkCount() const { return ChunkCount; }
+
+private:
+	/** Fixed-width "XXXXXXXX\r\n" size line reserved at the start of every chunk */
+	static constexpr int32 SizeLineBytes = 10;
+
+	bool FlushChunk(bool bLastChunk);
+
+	TFunction<bool(const uint8*, int32)> Sink;
+	TArray<uint8> Buffer;
+	int32 ChunkBytes;
+	int64 BodyBytes;
+	int32 ChunkCount;
+};
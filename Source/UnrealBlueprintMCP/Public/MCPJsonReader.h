@@ -0,0 +1,165 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * Kind of the next value in a JSON document, as reported by FMCPJsonReader::Peek()
+ */
+enum class EMCPJsonToken : uint8
+{
+	/** Malformed input, or nothing left to read */
+	Error,
+	Object,
+	Array,
+	String,
+	Number,
+	Boolean,
+	Null
+};
+
+/**
+ * Pull reader over a UTF-8 JSON document
+ *
+ * Values are read in document order straight from the caller's buffer; nothing is built that the
+ * caller does not ask for. Objects are walked with BeginObject()/NextMember() and arrays with
+ * BeginArray()/NextElement(), and values the caller does not need are passed over with
+ * SkipValue(), which still checks their syntax. The buffer must outlive the reader and any view
+ * it hands out.
+ *
+ * After the first error every call fails and GetError() says what went wrong and where.
+ */
+class UNREALBLUEPRINTMCP_API FMCPJsonReader
+{
+public:
+	explicit FMCPJsonReader(FUtf8StringView InJson);
+
+	/** Kind of the next value, without consuming it */
+	EMCPJsonToken Peek();
+
+	/** Consume the '{' of an object; follow with NextMember() until it returns false */
+	bool BeginObject();
+
+	/**
+	 * Move to the next member of the current object and read its key. The caller must then consume
+	 * the member's value. Returns false once the closing '}' is consumed, or on error. OutKey stays
+	 * valid until the next call.
+	 */
+	bool NextMember(FUtf8StringView& OutKey);
+
+	/** Consume the '[' of an array; follow with NextElement() until it returns false */
+	bool BeginArray();
+
+	/** Move to the next element of the current array; false once the closing ']' is consumed, or on error */
+	bool NextElement();
+
+	/** Read a string into Out, reusing its allocation */
+	bool ReadString(FString& Out);
+
+	/** Read a string as UTF-8, without conversion; the view stays valid until the next call */
+	bool ReadStringView(FUtf8StringView& Out);
+
+	bool ReadNumber(double& Out);
+	bool ReadBool(bool& bOut);
+	bool ReadNull();
+
+	/** Pass over the next value of any kind, checking its syntax; OutRaw receives its text */
+	bool SkipValue(FUtf8StringView* OutRaw = nullptr);
+
+	/** Build an FJsonValue for the next value, for the few values a caller keeps (e.g. request ids) */
+	TSharedPtr<FJsonValue> ReadValue();
+
+	/** Check that nothing but whitespace follows the value just read */
+	bool AtEnd();
+
+	bool HasError() const { return !Error.IsEmpty(); }
+	const FString& GetError() const { return Error; }
+
+	/** Deepest nesting accepted, so hostile input cannot exhaust the stack */
+	static constexpr int32 MaxDepth = 256;
+
+private:
+	void SkipWhitespace();
+	bool Fail(const TCHAR* What);
+	bool Expect(UTF8CHAR Char, const TCHAR* What);
+	bool EnterContainer(UTF8CHAR Open);
+	bool NextInContainer(UTF8CHAR Close);
+
+	/** Scan a string starting at the opening quote; OutRaw is the text between the quotes */
+	bool ScanString(FUtf8StringView& OutRaw, bool& bOutEscaped);
+
+	/** Scan a string and return its decoded UTF-8 text, from the buffer or from Scratch */
+	bool ReadStringInternal(FUtf8StringView& Out);
+
+	bool ScanNumber(FUtf8StringView& OutRaw);
+	bool ScanLiteral(const char* Literal, int32 Length);
+
+	const UTF8CHAR* Begin;
+	const UTF8CHAR* Cursor;
+	const UTF8CHAR* End;
+
+	/** Containers entered and not yet closed */
+	int32 Depth = 0;
+
+	/** Whether the current container has had no member or element yet, i.e. needs no comma */
+	bool bFirstInContainer = false;
+
+	/** Decoded text of the last string that contained escapes */
+	TArray<UTF8CHAR> Scratch;
+
+	FString Error;
+};
+
+/**
+ * What kind of JSON-RPC body FMCPJsonRpcEnvelope::ReadBody() found
+ */
+enum class EMCPJsonRpcBody : uint8
+{
+	/** Not well-formed JSON */
+	Malformed,
+	/** A single request object */
+	Request,
+	/** An array of requests */
+	Batch,
+	/** Well-formed JSON that is neither an object nor an array */
+	Other
+};
+
+/**
+ * The members of one JSON-RPC request the server needs before it dispatches
+ *
+ * A request object is read in one pass: jsonrpc, method and id are extracted, and params is
+ * checked for well-formedness but kept as raw text. It is decoded only once the method is known,
+ * and then straight into the form its handler takes. Params views into the request body, which
+ * must outlive the envelope.
+ */
+struct UNREALBLUEPRINTMCP_API FMCPJsonRpcEnvelope
+{
+	/** False for a batch entry that is not a JSON object */
+	bool bIsObject = false;
+
+	/** Whether jsonrpc is the string "2.0" */
+	bool bVersion2 = false;
+
+	/** Whether method is present and a string */
+	bool bHasMethod = false;
+
+	FString Method;
+
+	/** Request id, JSON null included; invalid when the request has no id, i.e. is a notification */
+	TSharedPtr<FJsonValue> Id;
+
+	/** Text of the params value; empty when params is absent or null */
+	FUtf8StringView Params;
+
+	bool IsNotification() const { return bIsObject && !Id.IsValid(); }
+
+	/** Read one value at the reader's position; anything but an object leaves bIsObject false */
+	static bool Read(FMCPJsonReader& Reader, FMCPJsonRpcEnvelope& Out);
+
+	/**
+	 * Read a whole request body, a single request (OutRequest) or a batch (OutBatch). Malformed
+	 * bodies put the reader's message in OutError.
+	 */
+	static EMCPJsonRpcBody ReadBody(FUtf8StringView Body, FMCPJsonRpcEnvelope& OutRequest, TArray<FMCPJsonRpcEnvelope>& OutBatch, FString& OutError);
+};
@@ -3,14 +3,202 @@
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
+#include "HAL/CriticalSection.h"
 #include "Networking.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
-#include "Serialization/JsonWriter.h"
+#include "MCPHttpRequestParser.h"
+#include "MCPWorkerPool.h"
+#include "MCPHttpResponse.h"
+#include "MCPWebSocket.h"
+#include "MCPRateLimiter.h"
+#include "MCPServerConfig.h"
+#include "MCPConnectionReactor.h"
+#include "MCPMethodRegistry.h"
+#include "MCPMethodParams.h"
+#include "MCPJsonReader.h"
+#include "MCPJsonWriter.h"
+#include "MCPResultCache.h"
+#include "MCPGameThreadQueue.h"
+#include "MCPBlueprintRefreshScheduler.h"
+#include "Async/Future.h"
+#include <atomic>
 
 class UMCPServerSettings;
+class UBlueprint;
+struct FAssetData;
+
+/**
+ * Snapshot of server counters, used by the server.stats method and the editor UI
+ */
+struct FMCPServerStats
+{
+	/** Connections currently open */
+	int32 ActiveConnections = 0;
+
+	/** Connections accepted since the server started */
+	int64 ConnectionsAccepted = 0;
+
+	/** Of those, connections accepted on the Unix domain socket */
+	int64 LocalConnectionsAccepted = 0;
+
+	/** HTTP requests served since the server started */
+	int64 RequestsServed = 0;
+
+	/** Requests that arrived on a connection which had already served a request */
+	int64 ReusedConnectionRequests = 0;
+
+	/** Connections answered with 503 because the worker pool was saturated */
+	int64 RejectedConnections = 0;
+
+	/** HTTP responses fully written to clients */
+	int64 ResponsesSent = 0;
+
+	/** Bytes written to clients, headers included */
+	int64 ResponseBytesSent = 0;
+
+	/** Bytes copied into response buffers while building responses */
+	int64 ResponseBytesCopied = 0;
+
+	/** Response buffer growths while building responses */
+	int64 ResponseAllocations = 0;
+
+	/** Responses sent with Transfer-Encoding: chunked */
+	int64 StreamedResponses = 0;
+
+	/** Body bytes sent in chunked responses, excluding chunk framing */
+	int64 StreamedBodyBytes = 0;
+
+	/** Responses sent with gzip or deflate Content-Encoding */
+	int64 CompressedResponses = 0;
+
+	/** Body bytes before compression, for compressed responses */
+	int64 CompressionInputBytes = 0;
+
+	/** Body bytes after compression, for compressed responses */
+	int64 CompressionOutputBytes = 0;
+
+	/** Time spent compressing, including attempts that were discarded */
+	double CompressionSeconds = 0.0;
+
+	/** WebSocket sessions currently open */
+	int32 ActiveWebSocketSessions = 0;
+
+	/** WebSocket sessions opened since the server started */
+	int64 WebSocketSessionsOpened = 0;
+
+	/** WebSocket data messages received */
+	int64 WebSocketMessagesReceived = 0;
+
+	/** Notification frames queued to WebSocket sessions */
+	int64 NotificationsSent = 0;
+
+	/** Requests charged against the rate limiter */
+	int64 RateLimitHits = 0;
+
+	/** Requests refused because a rate limit bucket was empty */
+	int64 RateLimitRejects = 0;
+
+	/** Time the last StopServer()/RestartServer() spent waiting for in-flight work */
+	double LastDrainSeconds = 0.0;
+
+	/** Drains that hit DrainTimeoutSeconds with work still outstanding */
+	int64 DrainTimeouts = 0;
+
+	/** JSON-RPC batch (array) requests processed */
+	int64 BatchRequests = 0;
+
+	/** Entries across all batch requests */
+	int64 BatchEntries = 0;
+
+	/** HTTP requests that gave their worker back while their handler waited for the game thread */
+	int64 DeferredRequests = 0;
+
+	/** Game-thread calls given up on after their method's timeout */
+	int64 GameThreadTimeouts = 0;
+
+	/** Operations applied by tools.batch, and batches undone because one of their operations failed */
+	int64 ToolBatchOperations = 0;
+	int64 ToolBatchRollbacks = 0;
+
+	/** resources.* asset registry lookups answered on a worker, and those that had to run on the game thread */
+	int64 RegistryWorkerReads = 0;
+	int64 RegistryGameThreadReads = 0;
+
+	/** JSON-RPC bodies read, over HTTP or WebSocket */
+	int64 RequestsParsed = 0;
+
+	/** Bytes of those bodies */
+	int64 RequestBytesParsed = 0;
+
+	/** Time spent reading bodies and decoding params, handlers excluded */
+	double RequestParseSeconds = 0.0;
+
+	/** FJsonValue nodes built while reading requests: ids, and params of handlers that take an FJsonObject */
+	int64 RequestJsonValues = 0;
+
+	/** FJsonValue nodes serialized into responses and notifications: ids, and results of handlers that build an FJsonObject */
+	int64 ResponseJsonValues = 0;
+
+	/** Connection worker pool counters */
+	FMCPWorkerPoolStats WorkerPool;
+
+	/** Idle and slow-client connection counters */
+	FMCPConnectionReactorStats Reactor;
+
+	/** Cached read results */
+	FMCPResultCacheStats ResultCache;
+
+	/** Game-thread queue depth, drain and latency counters */
+	FMCPGameThreadQueueStats GameThread;
+
+	/** Refreshes and compiles after tools.* edits, and how many edits shared one */
+	FMCPBlueprintRefreshStats BlueprintRefresh;
+
+	double GetBytesCopiedPerResponse() const
+	{
+		return ResponsesSent > 0 ? (double)ResponseBytesCopied / (double)ResponsesSent : 0.0;
+	}
+
+	double GetAllocationsPerResponse() const
+	{
+		return ResponsesSent > 0 ? (double)ResponseAllocations / (double)ResponsesSent : 0.0;
+	}
+
+	/** Compressed size as a fraction of the original size (lower is better) */
+	double GetCompressionRatio() const
+	{
+		return CompressionInputBytes > 0 ? (double)CompressionOutputBytes / (double)CompressionInputBytes : 0.0;
+	}
+
+	double GetCompressionMsPerResponse() const
+	{
+		return CompressedResponses > 0 ? CompressionSeconds * 1000.0 / (double)CompressedResponses : 0.0;
+	}
+
+	double GetParseMsPerRequest() const
+	{
+		return RequestsParsed > 0 ? RequestParseSeconds * 1000.0 / (double)RequestsParsed : 0.0;
+	}
+
+	double GetJsonValuesPerRequest() const
+	{
+		return RequestsParsed > 0 ? (double)RequestJsonValues / (double)RequestsParsed : 0.0;
+	}
+
+	double GetResponseJsonValuesPerRequest() const
+	{
+		return RequestsParsed > 0 ? (double)ResponseJsonValues / (double)RequestsParsed : 0.0;
+	}
+
+	/** Fraction of requests that did not pay for a new TCP connection */
+	double GetConnectionReuseRatio() const
+	{
+		return RequestsServed > 0 ? (double)ReusedConnectionRequests / (double)RequestsServed : 0.0;
+	}
+};
 
 /**
  * Simple JSON-RPC Server for MCP (Model Context Protocol)
@@ -27,14 +215,17 @@ public:
 	/** Start the server on the specified port */
 	bool StartServer(int32 Port = 8080);
 
-	/** Stop the server */
+	/**
+	 * Stop the server. Listeners close first so no new connections arrive, requests already being
+	 * received or processed get up to DrainTimeoutSeconds to finish, then the workers shut down.
+	 */
 	void StopServer();
 
 	/** Check if server is running */
 	bool IsRunning() const { return bIsRunning; }
 
 	/** Get the current port */
-	int32 GetPort() const { return ServerPort; }
+	int32 GetPort() const { return ServerPort.load(); }
 
 	/** Get server start time */
 	FDateTime GetServerStartTime() const { return ServerStartTime; }
@@ -42,8 +233,20 @@ public:
 	/** Get connected client count */
 	int32 GetConnectedClientCount() const { return ConnectedClientCount; }
 
+	/**
+	 * Push a JSON-RPC notification to every connected WebSocket client.
+	 * Safe to call from any thread; never blocks on slow clients.
+	 */
+	void BroadcastNotification(const FString& Method, TSharedPtr<FJsonObject> Params);
+
+	/** Get a snapshot of the server counters */
+	FMCPServerStats GetServerStats() const;
+
 	/** Get server URL */
-	FString GetServerURL() const { return FString::Printf(TEXT("http://localhost:%d"), ServerPort); }
+	FString GetServerURL() const { return FString::Printf(TEXT("http://localhost:%d"), ServerPort.load()); }
+
+	/** Path of the Unix domain socket being served, or empty when the local listener is off */
+	FString GetLocalSocketPath() const { return LocalServerSocket ? ActiveLocalSocketPath : FString(); }
 
 	/** Try starting server with alternative port if main port fails */
 	bool StartServerWithFallback(int32 PreferredPort = 8080);
@@ -51,10 +254,14 @@ public:
 	/** Check if port is available */
 	static bool IsPortAvailable(int32 Port);
 
-	/** Restart the server */
+	/** Restart the server; the port is reopened as soon as in-flight requests have drained */
 	bool RestartServer();
 
-	/** Apply settings from UMCPServerSettings */
+	/**
+	 * Apply settings from UMCPServerSettings without restarting. Connections pick up the new
+	 * snapshot on their next request; the worker pool and local socket are resized or reopened
+	 * in place, and a new port is bound before the old listener closes.
+	 */
 	void ApplySettings(const UMCPServerSettings* Settings);
 
 	/** Get current settings applied to server */
@@ -68,71 +275,498 @@ public:
 
 private:
 	/** Server socket */
-	FSocket* ServerSocket;
+	FMCPLocalSocket* ServerSocket;
+
+	/** Ends the accept loop on ServerSocket without stopping the server; used to hand over to a new port */
+	FThreadSafeBool bRetireServerSocket;
+
+	/** Listener RebindPort() created; the server thread swaps it in once the retired loop returns */
+	FMCPLocalSocket* PendingServerSocket;
+
+	/** Guards PendingServerSocket and the handover of ServerSocket while the server is running */
+	FCriticalSection ServerSocketLock;
 
 	/** Server thread */
 	FRunnableThread* ServerThread;
 
-	/** Port number */
-	int32 ServerPort;
+	/** Optional Unix domain socket listener; shares the worker pool and request pipeline with TCP */
+	FMCPLocalSocket* LocalServerSocket;
+
+	/** Accept loop for LocalServerSocket, run on its own thread */
+	TFuture<void> LocalAcceptLoop;
+
+	/** Socket path LocalServerSocket is bound to */
+	FString ActiveLocalSocketPath;
+
+	/** Ends the accept loop on LocalServerSocket without stopping the server */
+	FThreadSafeBool bRetireLocalListener;
+
+	/** Port number; written on the game thread, read by the accept thread and workers */
+	std::atomic<int32> ServerPort;
 
 	/** Running flag */
 	FThreadSafeBool bIsRunning;
 
-	/** Stop requested flag */
+	/** Stop requested flag; connections finish their current request and close */
 	FThreadSafeBool bStopRequested;
 
+	/** Set once the drain deadline has passed; partial reads and stalled sends are abandoned */
+	FThreadSafeBool bForceClose;
+
+	/** Connections and game-thread tasks still running; StopServer() waits for this to reach zero */
+	FThreadSafeCounter OutstandingWork;
+
+	/** Triggered whenever OutstandingWork drops to zero */
+	FEvent* WorkDrainedEvent;
+
+	/** Upper bound on how long StopServer() waits for in-flight work */
+	static constexpr double DrainTimeoutSeconds = 5.0;
+
+	/** Drain counters (thread-safe) */
+	FThreadSafeCounter64 LastDrainCycles;
+	FThreadSafeCounter64 DrainTimeouts;
+
 	/** Server start time */
 	FDateTime ServerStartTime;
 
 	/** Connected client count (thread-safe) */
 	FThreadSafeCounter ConnectedClientCount;
 
+	/** Connection reuse counters (thread-safe) */
+	FThreadSafeCounter64 TotalConnectionsAccepted;
+	FThreadSafeCounter64 LocalConnectionsAccepted;
+	FThreadSafeCounter64 TotalRequestsServed;
+	FThreadSafeCounter64 ReusedConnectionRequests;
+	FThreadSafeCounter64 RejectedConnections;
+
+	/** Response path counters (thread-safe) */
+	FThreadSafeCounter64 ResponsesSent;
+	FThreadSafeCounter64 ResponseBytesSent;
+	FThreadSafeCounter64 ResponseBytesCopied;
+	FThreadSafeCounter64 ResponseAllocations;
+	FThreadSafeCounter64 StreamedResponses;
+	FThreadSafeCounter64 StreamedBodyBytes;
+	FThreadSafeCounter64 CompressedResponses;
+	FThreadSafeCounter64 CompressionInputBytes;
+	FThreadSafeCounter64 CompressionOutputBytes;
+	FThreadSafeCounter64 CompressionCycles;
+	FThreadSafeCounter64 BatchRequests;
+	FThreadSafeCounter64 BatchEntries;
+	FThreadSafeCounter64 DeferredRequests;
+	FThreadSafeCounter64 GameThreadTimeouts;
+	FThreadSafeCounter64 ToolBatchOperations;
+	FThreadSafeCounter64 ToolBatchRollbacks;
+	FThreadSafeCounter64 RegistryWorkerReads;
+	FThreadSafeCounter64 RegistryGameThreadReads;
+	FThreadSafeCounter64 RequestsParsed;
+	FThreadSafeCounter64 RequestBytesParsed;
+	FThreadSafeCounter64 RequestParseCycles;
+	FThreadSafeCounter64 RequestJsonValues;
+	FThreadSafeCounter64 ResponseJsonValues;
+	FThreadSafeCounter64 RateLimitHits;
+	FThreadSafeCounter64 RateLimitRejects;
+
+	/** Open WebSocket sessions; notifications are queued to each of them */
+	TArray<TSharedRef<FMCPWebSocketSession, ESPMode::ThreadSafe>> WebSocketSessions;
+	mutable FCriticalSection WebSocketSessionsLock;
+	FThreadSafeCounter ActiveWebSocketSessions;
+	FThreadSafeCounter64 WebSocketSessionsOpened;
+	FThreadSafeCounter64 WebSocketMessagesReceived;
+	FThreadSafeCounter64 NotificationsSent;
+
+	/** Idle time after which a WebSocket session is pinged */
+	static constexpr double WebSocketPingIntervalSeconds = 15.0;
+
+	/** Queued output after which a WebSocket client that is not reading gets disconnected */
+	static constexpr int64 MaxWebSocketOutboxBytes = 16 * 1024 * 1024;
+
+	/** Editor event subscriptions that feed WebSocket notifications and invalidate cached results (game thread only) */
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	TArray<TWeakObjectPtr<UBlueprint>> CompilingBlueprints;
+
+	/** Serialized results of methods with a CacheDependency; sized by UMCPServerSettings::ResultCacheMegabytes */
+	FMCPResultCache ResultCache;
+
+	/** Editor work queued by ExecuteOnGameThread and batches; drained each frame within UMCPServerSettings::GameThreadBudgetMs */
+	FMCPGameThreadQueue GameThreadQueue;
+
+	/** Refreshes Blueprints edited by tools.* methods once edits to them pause; see UMCPServerSettings::BlueprintRefreshDelayMs */
+	FMCPBlueprintRefreshScheduler RefreshScheduler;
+
+	/** Largest JSON-RPC batch accepted in one HTTP request */
+	static constexpr int32 MaxBatchEntries = 1000;
+
+	/** Most operations one tools.batch request may apply */
+	static constexpr int32 MaxToolOperations = 1000;
+
+	/** Buffer size for chunked responses; each full buffer goes out as one chunk */
+	static constexpr int32 StreamChunkBytes = 32 * 1024;
+
+	/** Upper bound for diagnostics.synthetic_assets */
+	static constexpr int32 MaxSyntheticAssets = 10 * 1000 * 1000;
+
+	/** Upper bound for diagnostics.game_thread_work */
+	static constexpr double MaxGameThreadWorkMs = 1000.0;
+
+	/** Dedicated pool that runs client connections */
+	FMCPWorkerPool WorkerPool;
+
+	/** Watches connections that are waiting on their client, so they do not hold a worker */
+	FMCPConnectionReactor Reactor;
+
+	/** How long a request waits for game-thread work when the method does not set its own timeout */
+	static constexpr double DefaultGameThreadTimeoutSeconds = 5.0;
+
+	/** Timeout of methods that create assets or compile Blueprints, which can take a while on large projects */
+	static constexpr double EditorWriteTimeoutSeconds = 30.0;
+
+	/** Retry-After value sent with 503 responses */
+	static constexpr int32 RetryAfterSeconds = 1;
+
+	/** Largest HTTP header block accepted before the connection is dropped */
+	static constexpr int32 MaxHttpHeaderBytes = 64 * 1024;
+
+	/** Largest HTTP request body accepted */
+	static constexpr int64 MaxHttpBodyBytes = 64 * 1024 * 1024;
+
 	/** Last used port for settings persistence */
 	static int32 LastUsedPort;
 
+	/** Upper bound for a single blocking wait on the listen socket; StopServer() wakes the wait early */
+	static constexpr double AcceptWaitTimeoutSeconds = 1.0;
+
+	/** WebSocket sessions and streamed sends wait on their sockets in slices this long so a draining server is noticed within milliseconds */
+	static constexpr double StopPollIntervalSeconds = 0.05;
+
 	/** Default fallback ports to try */
 	TArray<int32> FallbackPorts;
 
-	/** Applied settings cache */
-	int32 AppliedMaxConnections;
-	int32 AppliedTimeoutSeconds;
-	bool bAppliedEnableCORS;
-	bool bAppliedEnableAuth;
-	FString AppliedAPIKey;
-	TMap<FString, FString> AppliedCustomHeaders;
+	/** Applied settings; replaced wholesale by ApplySettings */
+	TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> Config;
+
+	/** Guards swapping Config; readers only hold it long enough to copy the pointer */
+	mutable FRWLock ConfigLock;
+
+	/** Get the current settings snapshot; the returned reference stays valid across a concurrent ApplySettings */
+	TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> GetConfig() const;
+
+	/** Charge a request to the rate limiter; returns a JSON-RPC error response if it is over the limit, else nullptr */
+	TSharedPtr<FJsonObject> CheckRateLimit(const FMCPJsonRpcEnvelope& Request);
+
+	/** Wake the accept loops out of their blocking waits so they can observe bStopRequested */
+	void WakeAcceptLoop();
+
+	/** Connect to our own listener so its blocking Wait() returns; the connection carries no request */
+	void WakeTcpListener(int32 Port);
+	void WakeLocalListener();
+
+	/** Create a listening socket on localhost:Port, or nullptr */
+	FMCPLocalSocket* CreateTcpListener(int32 Port);
 
-	/** Handle incoming client connection */
-	void HandleClientConnection(FSocket* ClientSocket);
+	/**
+	 * Move the TCP listener to NewPort without waiting for the handover; the new socket is
+	 * listening before this returns, and the server thread closes the old one once it has
+	 * accepted what was already in its backlog
+	 */
+	bool RebindPort(int32 NewPort);
 
-	/** Process HTTP request */
-	FString ProcessHttpRequest(const FString& RequestData);
+	/** Track a unit of work (a connection or a queued game-thread task) that must finish before shutdown */
+	void BeginWork();
+	void EndWork();
 
-	/** Process JSON-RPC request */
-	TSharedPtr<FJsonObject> ProcessJsonRpcRequest(TSharedPtr<FJsonObject> Request);
+	/**
+	 * Wait until OutstandingWork reaches zero or the timeout expires. On the game thread, the
+	 * game-thread queue is drained while waiting, since workers may be blocked on its tasks.
+	 */
+	bool DrainOutstandingWork(double TimeoutSeconds);
+
+	/** Accept connections on Listener and hand them to the worker pool until the server stops or bRetired is set */
+	void RunAcceptLoop(FMCPLocalSocket* Listener, const FThreadSafeBool& bRetired);
+
+	/** Open the Unix domain socket listener if enabled; failure leaves TCP serving alone */
+	void StartLocalListener();
+
+	/** Close the Unix domain socket listener and remove its socket file */
+	void StopLocalListener();
+
+	/** Queue a connection that has something to do on the worker pool, or answer 503 if the pool is saturated */
+	void DispatchConnection(FMCPConnection* Connection);
+
+	/**
+	 * Serve requests on a connection until it has to wait for its client, then park it with the
+	 * reactor; runs on a worker. Closes the connection when the client or the server is done with it.
+	 */
+	void ServeConnection(FMCPConnection* Connection);
+
+	/** Close the socket, free the connection and end its unit of work */
+	void CloseConnection(FMCPConnection* Connection);
+
+	/** Answer a client with 503 and close it; used when the worker pool is saturated */
+	void RejectClientConnection(FMCPConnection* Connection);
+
+	/** Close and destroy a client socket */
+	void CloseClientSocket(FSocket* ClientSocket);
+
+	/**
+	 * Receive what the socket already holds into the connection's parser, without waiting. Returns
+	 * NeedMoreData once the socket is drained, with bOutConnectionLost set if the peer closed or the socket failed.
+	 */
+	EMCPHttpParseResult ReceiveHttpRequest(FMCPConnection& Connection, bool& bOutConnectionLost);
+
+	/**
+	 * Process HTTP request, building the reply into OutResponse. Returns false instead when the
+	 * request is a single call to a game-thread method: the call is queued, and Connection goes
+	 * back to the worker pool to be answered once it completes, so the caller must not touch it.
+	 */
+	bool ProcessHttpRequest(FMCPConnection* Connection, const FMCPHttpRequest& Request, bool bKeepAlive, FMCPHttpResponse& OutResponse);
+
+	/** Answer a request that was waiting for the game thread; returns false if the connection is gone */
+	bool SendPendingResponse(FMCPConnection* Connection);
+
+	/** Send header block and body, riding out partial sends; false if the client went away or timed out */
+	bool SendHttpResponse(FSocket* ClientSocket, const FMCPHttpResponse& Response);
+
+	/** Send all bytes on a non-blocking socket; fails if the client makes no progress for the connection timeout */
+	bool SendAll(FSocket* ClientSocket, const uint8* Data, int32 Length);
+
+	/**
+	 * Send as much of the connection's buffered response as the socket takes. Returns true once all
+	 * of it is out. Otherwise the connection was parked until the client reads more, or closed, and
+	 * the caller no longer owns it.
+	 */
+	bool SendBufferedResponse(FMCPConnection* Connection);
+
+	/** Add a fully sent response to the response counters */
+	void CountSentResponse(const FMCPHttpResponse& Response);
+
+	/** Write a complete JSON-RPC success envelope around a streamed result */
+	void WriteStreamedJsonRpcResponse(FMCPJsonWriter& Writer, const FMCPResultStreamer& Streamer, TSharedPtr<FJsonValue> Id);
+
+	/** Check whether a request asks to switch the connection to WebSocket */
+	static bool IsWebSocketUpgrade(const FMCPHttpRequest& Request);
+
+	/**
+	 * Validate a WebSocket upgrade and build the 101 response, reserving a session slot.
+	 * Returns false with an HTTP error in OutResponse if the upgrade is refused.
+	 */
+	bool AcceptWebSocketUpgrade(const FMCPHttpRequest& Request, FMCPHttpResponse& OutResponse);
+
+	/** Run a WebSocket session until either side closes it; InitialBytes are bytes received after the upgrade request */
+	void ServeWebSocket(FSocket* ClientSocket, TArrayView<const uint8> InitialBytes);
+
+	/** Answer one JSON-RPC text message; returns false if the session should close */
+	bool HandleWebSocketMessage(FMCPWebSocketSession& Session, const TArray<uint8>& Payload, TArray<uint8>& JsonScratch, TArray<uint8>& FrameScratch);
+
+	/** Subscribe to editor events that become WebSocket notifications or invalidate cached results */
+	void RegisterNotificationSources();
+	void UnregisterNotificationSources();
+
+	/** Drop cached results for an asset's folder and package */
+	void InvalidateCachedResults(const FAssetData& AssetData);
+
+	/** Add the built-in methods to FMCPMethodRegistry, owned by this server */
+	void RegisterBuiltinMethods();
+
+	/** Describe a built-in method whose handler takes a params struct */
+	template<typename TParams>
+	FMCPMethodDescriptor MakeTypedMethod(const TCHAR* Name, TSharedPtr<FJsonObject> (FMCPJsonRpcServer::*Func)(const TParams&), EMCPMethodThreading Threading, EMCPMethodAccess Access, const TCHAR* Description);
+
+	/** Describe a built-in method that writes its result, from a params struct */
+	template<typename TParams>
+	FMCPMethodDescriptor MakeTypedStreamMethod(const TCHAR* Name, TFuture<FMCPResultStreamer> (FMCPJsonRpcServer::*Func)(const TParams&), EMCPMethodThreading Threading, EMCPMethodAccess Access, const TCHAR* Description);
+
+	/** Find a method the current settings allow clients to call, or nullptr */
+	FMCPMethodRegistry::FDescriptorPtr FindMethod(const FString& Method) const;
+
+	/**
+	 * A request whose method has been looked up and whose params have been decoded. It owns
+	 * everything its handler needs, so it can run after the request body is gone.
+	 */
+	struct FPreparedRequest
+	{
+		TSharedPtr<FJsonValue> Id;
+		FMCPMethodRegistry::FDescriptorPtr Descriptor;
+
+		/** Calls the handler with the decoded params */
+		TFunction<TSharedPtr<FJsonObject>()> Invoke;
+
+		/**
+		 * Set instead of Invoke for streamed methods: calls the stream handler, on the calling
+		 * worker; the streamer may still be on its way from the game thread when it returns
+		 */
+		TFunction<TFuture<FMCPResultStreamer>()> Stream;
+
+		/** Set instead of Invoke when the request is answered without running a handler */
+		TSharedPtr<FJsonObject> ErrorResponse;
+
+		/** Streamed methods hop to the game thread themselves, for only as long as they need it */
+		bool RequiresGameThread() const
+		{
+			return !ErrorResponse.IsValid() && !Stream && Descriptor.IsValid() && Descriptor->Threading == EMCPMethodThreading::GameThread;
+		}
+
+		bool IsStreamed() const
+		{
+			return !ErrorResponse.IsValid() && Stream;
+		}
+	};
+
+	/** Read a request body without building a JSON tree, adding to the parse counters */
+	EMCPJsonRpcBody ReadJsonRpcBody(TArrayView<const uint8> Body, FMCPJsonRpcEnvelope& OutRequest, TArray<FMCPJsonRpcEnvelope>& OutBatch);
+
+	/** Look up the method and decode params into the form its handler takes; runs on the calling worker */
+	void PrepareJsonRpcRequest(const FMCPJsonRpcEnvelope& Request, FPreparedRequest& Out);
+
+	/**
+	 * Turn a prepared request for a cacheable method into a stream that replays its result from
+	 * ResultCache, running the handler and keeping what it produced only on a miss. TypedParams is
+	 * the decoded params struct, or nullptr for methods that take an FJsonObject.
+	 */
+	void PrepareCachedRequest(const FMCPJsonRpcEnvelope& Request, const void* TypedParams, FPreparedRequest& Out);
+
+	/**
+	 * Run a prepared request, on the game thread if its method needs it, and build its response,
+	 * waiting for the game thread on the calling worker; for WebSocket sessions, which hold theirs
+	 * anyway. Streamed methods set OutStreamer instead and return nullptr.
+	 */
+	TSharedPtr<FJsonObject> RunPreparedRequest(const FPreparedRequest& Prepared, FMCPResultStreamer& OutStreamer);
+
+	/** Wrap a handler's result in a JSON-RPC response; an invalid result means it failed or timed out */
+	TSharedPtr<FJsonObject> CreateResultResponse(TSharedPtr<FJsonObject> Result, TSharedPtr<FJsonValue> Id);
+
+	/** Descriptor's own game-thread timeout, or DefaultGameThreadTimeoutSeconds */
+	static double GetGameThreadTimeout(const FMCPMethodDescriptor& Descriptor);
+
+	/**
+	 * Queue Prepared's handler on the game thread and hand Connection back to the worker pool when
+	 * it completes or its timeout passes, with the response in PendingResponse
+	 */
+	void DeferToGameThread(FMCPConnection* Connection, FPreparedRequest&& Prepared);
+
+	/**
+	 * Hand Connection back to the worker pool once a stream handler's PendingStreamer is ready,
+	 * with the response in PendingStream, or in PendingResponse if the handler failed
+	 */
+	void DeferStreamedResult(FMCPConnection* Connection, TFuture<FMCPResultStreamer>&& PendingStreamer, TSharedPtr<FJsonValue> Id);
+
+	/**
+	 * Process JSON-RPC request, dispatching through FMCPMethodRegistry. Streamed methods set
+	 * OutStreamer, for the caller to write the result, and return nullptr; everything else, errors
+	 * included, returns the response.
+	 */
+	TSharedPtr<FJsonObject> ProcessJsonRpcRequest(const FMCPJsonRpcEnvelope& Request, FMCPResultStreamer& OutStreamer);
+
+	/** Entries and responses of a batch in progress, shared with the continuations of its game-thread calls */
+	struct FJsonRpcBatch;
+
+	/**
+	 * Start a JSON-RPC batch. Entries that need the editor are queued for the game thread in
+	 * order, each with its method's own timeout, while the others run one after another on the
+	 * calling worker before this returns; streamed methods may leave their game-thread part
+	 * queued. The batch's Done future is ready once every entry has a response or a streamer.
+	 * Each entry is charged to the rate limit.
+	 */
+	TSharedRef<FJsonRpcBatch, ESPMode::ThreadSafe> StartJsonRpcBatch(const TArray<FMCPJsonRpcEnvelope>& Entries);
+
+	/**
+	 * Append the array of a finished batch's responses in entry order to Out, without entries for
+	 * notifications (requests that have no id), and return how many there are; nothing is written
+	 * when there are none
+	 */
+	int32 WriteJsonRpcBatch(const FJsonRpcBatch& Batch, TArray<uint8>& Out);
+
+	/**
+	 * Start a batch and wait for it on the calling worker, for callers that hold one anyway; the
+	 * wait is bounded by the longest timeout among its game-thread entries. Returns what
+	 * WriteJsonRpcBatch() wrote to Out.
+	 */
+	int32 ProcessJsonRpcBatch(const TArray<FMCPJsonRpcEnvelope>& Entries, TArray<uint8>& Out);
+
+	/** Answer an HTTP batch with the response array WriteResponses appends, or with 204 No Content when it writes none */
+	void WriteBatchResponse(FMCPHttpResponse& Response, TFunctionRef<int32(TArray<uint8>&)> WriteResponses, bool bKeepAlive, const FMCPHttpRequest& Request);
+
+	/** Build the FJsonObject form of params for handlers that take one; nullptr when there are none */
+	TSharedPtr<FJsonObject> ReadParamsObject(FUtf8StringView Params);
+
+	/** Serialize a JSON-RPC response straight into the UTF-8 body buffer */
+	void WriteJsonBody(FMCPHttpResponse& Response, const FJsonObject& Object);
+
+	/** Append the condensed UTF-8 JSON for Object to Out */
+	void SerializeJsonUtf8(const FJsonObject& Object, TArray<uint8>& Out);
 
 	/** Handle specific JSON-RPC methods */
 	TSharedPtr<FJsonObject> HandleGetBlueprints(TSharedPtr<FJsonObject> Params);
 	TSharedPtr<FJsonObject> HandleGetActors(TSharedPtr<FJsonObject> Params);
 	TSharedPtr<FJsonObject> HandlePing(TSharedPtr<FJsonObject> Params);
+	TSharedPtr<FJsonObject> HandleServerStats(TSharedPtr<FJsonObject> Params);
+	TSharedPtr<FJsonObject> HandleServerMethods(TSharedPtr<FJsonObject> Params);
 
 	/** Handle resources namespace methods */
-	TSharedPtr<FJsonObject> HandleResourcesList(TSharedPtr<FJsonObject> Params);
-	TSharedPtr<FJsonObject> HandleResourcesGet(TSharedPtr<FJsonObject> Params);
-	TSharedPtr<FJsonObject> HandleResourcesCreate(TSharedPtr<FJsonObject> Params);
+	TFuture<FMCPResultStreamer> StreamResourcesList(const FMCPResourcesListParams& Params);
+	TFuture<FMCPResultStreamer> StreamResourcesGet(const FMCPResourcesGetParams& Params);
+	TSharedPtr<FJsonObject> HandleResourcesCreate(const FMCPResourcesCreateParams& Params);
 
 	/** Handle tools namespace methods */
-	TSharedPtr<FJsonObject> HandleToolsCreateBlueprint(TSharedPtr<FJsonObject> Params);
-	TSharedPtr<FJsonObject> HandleToolsAddVariable(TSharedPtr<FJsonObject> Params);
-	TSharedPtr<FJsonObject> HandleToolsAddFunction(TSharedPtr<FJsonObject> Params);
-	TSharedPtr<FJsonObject> HandleToolsEditGraph(TSharedPtr<FJsonObject> Params);
+	TSharedPtr<FJsonObject> HandleToolsCreateBlueprint(const FMCPCreateBlueprintParams& Params);
+	TSharedPtr<FJsonObject> HandleToolsAddVariable(const FMCPAddVariableParams& Params);
+	TSharedPtr<FJsonObject> HandleToolsAddFunction(const FMCPAddFunctionParams& Params);
+	TSharedPtr<FJsonObject> HandleToolsEditGraph(const FMCPEditGraphParams& Params);
+	TSharedPtr<FJsonObject> HandleToolsBatch(const FMCPToolsBatchParams& Params);
+
+	/**
+	 * The edits behind tools.add_variable, tools.add_function and tools.edit_graph, shared with
+	 * tools.batch. They call Modify() on what they change, so an open transaction records them, and
+	 * leave refreshing the Blueprint to the caller, through RefreshScheduler. Failures are reported
+	 * in the result's "error".
+	 */
+	static TSharedPtr<FJsonObject> AddVariable(UBlueprint& Blueprint, const FMCPAddVariableParams& Params);
+	static TSharedPtr<FJsonObject> AddFunction(UBlueprint& Blueprint, const FMCPAddFunctionParams& Params);
+	static TSharedPtr<FJsonObject> AddGraphNodes(UBlueprint& Blueprint, const FMCPEditGraphParams& Params);
 
 	/** Handle prompts namespace methods */
 	TSharedPtr<FJsonObject> HandlePromptsList(TSharedPtr<FJsonObject> Params);
-	TSharedPtr<FJsonObject> HandlePromptsGet(TSharedPtr<FJsonObject> Params);
+	TSharedPtr<FJsonObject> HandlePromptsGet(const FMCPPromptsGetParams& Params);
+
+	/** Handle diagnostics namespace methods (only when diagnostics are enabled in settings) */
+	TFuture<FMCPResultStreamer> StreamDiagnosticsSyntheticAssets(const FMCPSyntheticAssetsParams& Params);
+	TSharedPtr<FJsonObject> HandleDiagnosticsApplySettings(TSharedPtr<FJsonObject> Params);
+	TSharedPtr<FJsonObject> HandleDiagnosticsGameThreadWork(const FMCPGameThreadWorkParams& Params);
+
+	/**
+	 * Whether the asset registry can be queried from the calling thread: always on the game thread,
+	 * and elsewhere once its initial scan is done
+	 */
+	static bool CanReadAssetRegistry();
+
+	/** Collect the assets resources.list reports; see CanReadAssetRegistry() */
+	static void GatherResourcesList(const FString& SearchPath, TArray<FAssetData>& OutAssets);
+
+	/**
+	 * Put a content folder in the form the asset registry keys it by (no trailing slash), which is
+	 * also the package path asset change events report; false if it is not a content folder
+	 */
+	static bool NormalizeContentPath(const FString& Path, FString& OutPath);
+
+	/** Write the resources.get result for AssetData, with the details of Blueprint if it has been loaded */
+	static void WriteResourceDetails(FMCPJsonWriter& Writer, const FAssetData& AssetData, const UBlueprint* Blueprint);
 
-	/** Create HTTP response */
-	FString CreateHttpResponse(const FString& Content, const FString& ContentType = TEXT("application/json"));
+	/**
+	 * Write the header block for the JSON body in Response (or its streamer); 204 responses carry no body.
+	 * Compresses a buffered body first when the request's Accept-Encoding allows it.
+	 */
+	void CreateHttpResponse(FMCPHttpResponse& Response, bool bKeepAlive, const FMCPHttpRequest& Request, int32 StatusCode = 200);
+
+	/** Compress a buffered body if settings, size and the client's Accept-Encoding allow it */
+	void CompressHttpResponse(FMCPHttpResponse& Response, const FMCPHttpRequest& Request, const FMCPServerConfig& ResponseConfig);
+
+	/** Create an HTTP error response for requests that could not be parsed; always closes the connection */
+	void CreateHttpErrorResponse(int32 StatusCode, const FString& ErrorMessage, FMCPHttpResponse& Response);
 
 	/** Create JSON-RPC error response */
 	TSharedPtr<FJsonObject> CreateErrorResponse(int32 ErrorCode, const FString& ErrorMessage, TSharedPtr<FJsonValue> Id = nullptr);
@@ -140,9 +774,31 @@ private:
 	/** Log server messages */
 	void LogMessage(const FString& Message);
 
-	/** Thread-safe wrapper for editor API calls */
+	/**
+	 * Thread-safe wrapper for editor API calls: runs Task inline on the game thread, and elsewhere
+	 * waits up to TimeoutSeconds for it, returning a default value if it times out or the server stops
+	 */
+	template<typename ReturnType>
+	ReturnType ExecuteOnGameThread(TFunction<ReturnType()> Task, double TimeoutSeconds = DefaultGameThreadTimeoutSeconds);
+
+	/** Queue Task on the game-thread queue without waiting for it */
+	template<typename ReturnType>
+	TMCPGameThreadCall<ReturnType> CallOnGameThread(TUniqueFunction<ReturnType()>&& Task, double TimeoutSeconds);
+
+	/**
+	 * Queue Task on the game-thread queue and have the reactor cancel it once TimeoutSeconds have
+	 * passed, so the returned future always resolves, unset on timeout, and nothing waits for it
+	 */
 	template<typename ReturnType>
-	ReturnType ExecuteOnGameThread(TFunction<ReturnType()> Task);
+	TFuture<TOptional<ReturnType>> QueueOnGameThread(TUniqueFunction<ReturnType()>&& Task, double TimeoutSeconds = DefaultGameThreadTimeoutSeconds);
+
+	/**
+	 * Wait up to TimeoutSeconds for a future the game thread resolves, in StopPollIntervalSeconds
+	 * slices; gives up early once bForceClose is set, because StopServer() then joins the workers
+	 * on the game thread and nothing drains the queue. Returns whether the future is ready.
+	 */
+	template<typename FutureType>
+	bool WaitForGameThread(const FutureType& Future, double TimeoutSeconds) const;
 	
 	/** Thread-safe asynchronous execution for editor API calls */
 	void ExecuteOnGameThreadAsync(TFunction<void()> Task);
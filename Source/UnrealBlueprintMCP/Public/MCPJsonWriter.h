@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+struct FBPVariableDescription;
+class UEdGraph;
+class FJsonObject;
+class FJsonValue;
+
+/**
+ * Condensed UTF-8 JSON writer for response bodies
+ *
+ * Values are encoded straight into the output buffer as they are written, so a result can be
+ * emitted without building an FJsonObject first and without a temporary FString per value: keys
+ * and strings are taken as views, and names and paths are formatted through a reusable scratch
+ * builder. Helpers write the engine types results are made of (assets, Blueprint variables,
+ * graphs) in the shape every method reports them.
+ *
+ * The writer does not check structure; callers pair the Start/End calls and give every value
+ * inside an object a key. DOM values can still be written, for handlers that build FJsonObjects,
+ * and are counted so the server can report how much of its output still goes through a tree.
+ */
+class UNREALBLUEPRINTMCP_API FMCPJsonWriter
+{
+public:
+	/** Append to Out */
+	explicit FMCPJsonWriter(TArray<uint8>& InOut);
+
+	/** Write to Archive through an internal buffer, flushed every FlushBytes and on Close() */
+	explicit FMCPJsonWriter(FArchive& InArchive);
+
+	~FMCPJsonWriter();
+
+	FMCPJsonWriter(const FMCPJsonWriter&) = delete;
+	FMCPJsonWriter& operator=(const FMCPJsonWriter&) = delete;
+
+	void WriteObjectStart();
+	void WriteObjectStart(FStringView Key);
+	void WriteObjectEnd();
+
+	void WriteArrayStart();
+	void WriteArrayStart(FStringView Key);
+	void WriteArrayEnd();
+
+	/** Write the key of the next object member; the value follows with any of the value calls */
+	void WriteIdentifierPrefix(FStringView Key);
+
+	void WriteValue(FStringView Value);
+	void WriteValue(const TCHAR* Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(const FString& Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(FName Value);
+	void WriteValue(bool bValue);
+	void WriteValue(int32 Value) { WriteValue((int64)Value); }
+	void WriteValue(int64 Value);
+	void WriteValue(double Value);
+	void WriteNull();
+
+	/** Write an FJsonValue tree; an invalid pointer is written as null */
+	void WriteValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteValue(const FJsonObject& Object);
+
+	template<typename TValue>
+	void WriteValue(FStringView Key, TValue&& Value)
+	{
+		WriteIdentifierPrefix(Key);
+		WriteValue(Forward<TValue>(Value));
+	}
+
+	/** Write a value that is already condensed UTF-8 JSON, e.g. a result rendered earlier */
+	void WriteRawValue(FUtf8StringView Json);
+
+	/** { "name", "path", "class", "package" } of an asset, as resources.list and resources.get report it */
+	void WriteAsset(const FAssetData& AssetData);
+
+	/** The members of WriteAsset() alone, for results that add their own to the same object */
+	void WriteAssetFields(const FAssetData& AssetData);
+
+	/** { "name", "type", "is_public" } of a Blueprint member variable */
+	void WriteVariable(const FBPVariableDescription& Variable);
+
+	/** { "name" } of a Blueprint graph */
+	void WriteGraph(const UEdGraph& Graph);
+
+	/** Flush buffered output to the archive; the writer must not be used afterwards */
+	void Close();
+
+	/** FJsonValue nodes written through the DOM overloads so far */
+	int64 GetJsonValuesWritten() const { return JsonValuesWritten; }
+
+	/** Buffered bytes at which output is handed to the archive */
+	static constexpr int32 FlushBytes = 16 * 1024;
+
+private:
+	/** Comma before a value or key that follows another in the same container */
+	void BeginValue();
+
+	void WriteString(FStringView Text);
+	void WriteAscii(const ANSICHAR* Text, int32 Length);
+	void WriteObjectMembers(const FJsonObject& Object);
+
+	/** Write whatever is in Scratch as a string, then empty it */
+	void WriteScratch();
+
+	void FlushIfFull();
+
+	TArray<uint8>* Out;
+	FArchive* Archive = nullptr;
+
+	/** Output buffer when writing to an archive */
+	TArray<uint8> Buffer;
+
+	/** Whether the next value or key follows another in the same container */
+	bool bNeedsComma = false;
+
+	/** Reused to format names and paths without a heap allocation per value */
+	TStringBuilder<256> Scratch;
+
+	int64 JsonValuesWritten = 0;
+};
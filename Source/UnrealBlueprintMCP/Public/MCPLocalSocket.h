@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sockets.h"
+
+class FMCPLocalSocket;
+
+/**
+ * One socket's entry in FMCPLocalSocket::Poll()
+ */
+struct FMCPPollEntry
+{
+	FMCPLocalSocket* Socket = nullptr;
+
+	/** What to wait for */
+	ESocketWaitConditions::Type Condition = ESocketWaitConditions::WaitForRead;
+
+	/** Set by Poll() when the condition is met; hang-up and errors count as ready so Recv/Send observes them */
+	bool bReady = false;
+};
+
+/**
+ * Stream socket on a native handle: a Unix domain socket (AF_UNIX) or a loopback TCP socket
+ *
+ * The engine's socket subsystem only speaks IP and hides its handles, so this wraps the native
+ * handle itself while exposing the FSocket interface the connection pipeline already uses (Wait,
+ * Recv, Send, SetNonBlocking). Owning the handle is also what lets Poll() wait on every connection
+ * at once from a single thread. Calls that only make sense for other socket types fail. Errors are
+ * reported through the platform's normal socket error state, so ISocketSubsystem::GetLastErrorCode()
+ * still works.
+ *
+ * Windows 10 1803 and later support AF_UNIX as well, so the same code serves every editor platform.
+ */
+class UNREALBLUEPRINTMCP_API FMCPLocalSocket : public FSocket
+{
+public:
+	/** Reported by GetProtocol() for Unix domain sockets; these sockets are deleted directly rather than through ISocketSubsystem */
+	static const FName ProtocolName;
+
+	/** Reported by GetProtocol() for loopback TCP sockets; deleted directly as well */
+	static const FName LoopbackProtocolName;
+
+	/** Check whether Socket is an FMCPLocalSocket of either kind */
+	static bool IsLocalSocket(const FSocket* Socket);
+
+	/** Check whether this platform can create Unix domain sockets */
+	static bool IsSupported();
+
+	/** Longest path that fits in sockaddr_un */
+	static int32 GetMaxPathLength();
+
+	/**
+	 * Create a listening socket at Path. A socket file left behind by a crashed editor is replaced;
+	 * a path another live server is listening on is an error.
+	 */
+	static FMCPLocalSocket* CreateListener(const FString& Path, int32 MaxBacklog, FString& OutError);
+
+	/** Create a TCP socket listening on 127.0.0.1:Port */
+	static FMCPLocalSocket* CreateTcpListener(int32 Port, int32 MaxBacklog, FString& OutError);
+
+	/** Create two connected sockets, e.g. to wake a thread blocked in Poll() */
+	static bool CreatePair(FMCPLocalSocket*& OutFirst, FMCPLocalSocket*& OutSecond);
+
+	/**
+	 * Wait until at least one entry is ready or WaitTime passes (a negative WaitTime waits forever).
+	 * Returns the number of ready entries, 0 on timeout, or -1 if polling failed.
+	 */
+	static int32 Poll(TArrayView<FMCPPollEntry> Entries, FTimespan WaitTime);
+
+	/** Connect to a listening socket at Path, or nullptr */
+	static FMCPLocalSocket* ConnectTo(const FString& Path);
+
+	/** Remove the socket file of a listener that has been closed */
+	static void DeleteSocketFile(const FString& Path);
+
+	virtual ~FMCPLocalSocket();
+
+	//~ Begin FSocket Interface
+	virtual bool Shutdown(ESocketShutdownMode Mode) override;
+	virtual bool Close() override;
+	virtual bool Bind(const FInternetAddr& Addr) override;
+	virtual bool Connect(const FInternetAddr& Addr) override;
+	virtual bool Listen(int32 MaxBacklog) override;
+	virtual bool WaitForPendingConnection(bool& bHasPendingConnection, const FTimespan& WaitTime) override;
+	virtual bool HasPendingConnection(bool& bHasPendingConnection) override;
+	virtual bool HasPendingData(uint32& PendingDataSize) override;
+	virtual FSocket* Accept(const FString& InSocketDescription) override;
+	virtual FSocket* Accept(FInternetAddr& OutAddr, const FString& InSocketDescription) override;
+	virtual bool SendTo(const uint8* Data, int32 Count, int32& BytesSent, const FInternetAddr& Destination) override;
+	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override;
+	virtual bool RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInternetAddr& Source, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None) override;
+	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None) override;
+	virtual bool Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime) override;
+	virtual ESocketConnectionState GetConnectionState() override;
+	virtual void GetAddress(FInternetAddr& OutAddr) override;
+	virtual bool GetPeerAddress(FInternetAddr& OutAddr) override;
+	virtual bool SetNonBlocking(bool bIsNonBlocking = true) override;
+	virtual bool SetBroadcast(bool bAllowBroadcast = true) override;
+	virtual bool SetNoDelay(bool bIsNoDelay = true) override;
+	virtual bool JoinMulticastGroup(const FInternetAddr& GroupAddress) override;
+	virtual bool JoinMulticastGroup(const FInternetAddr& GroupAddress, const FInternetAddr& InterfaceAddress) override;
+	virtual bool LeaveMulticastGroup(const FInternetAddr& GroupAddress) override;
+	virtual bool LeaveMulticastGroup(const FInternetAddr& GroupAddress, const FInternetAddr& InterfaceAddress) override;
+	virtual bool SetMulticastLoopback(bool bLoopback) override;
+	virtual bool SetMulticastTtl(uint8 TimeToLive) override;
+	virtual bool SetMulticastInterface(const FInternetAddr& InterfaceAddress) override;
+	virtual bool SetReuseAddr(bool bAllowReuse = true) override;
+	virtual bool SetLinger(bool bShouldLinger = true, int32 Timeout = 0) override;
+	virtual bool SetRecvErr(bool bUseErrorQueue = true) override;
+	virtual bool SetSendBufferSize(int32 Size, int32& NewSize) override;
+	virtual bool SetReceiveBufferSize(int32 Size, int32& NewSize) override;
+	virtual int32 GetPortNo() override;
+	//~ End FSocket Interface
+
+private:
+	FMCPLocalSocket(UPTRINT InHandle, const FString& InSocketDescription, const FName& InProtocol);
+
+	/** Native socket handle (SOCKET on Windows, file descriptor elsewhere) */
+	UPTRINT Handle;
+};
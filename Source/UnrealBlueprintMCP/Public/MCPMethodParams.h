@@ -0,0 +1,194 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPMethodParams.generated.h"
+
+/*
+ * Params structs for the built-in JSON-RPC methods, decoded by FMCPParamsBinding.
+ * Each property is read from the snake_case form of its name (AssetPath -> "asset_path",
+ * bIsPublic -> "is_public"); meta = (Required) makes the field mandatory.
+ */
+
+/** resources.list */
+USTRUCT()
+struct FMCPResourcesListParams
+{
+	GENERATED_BODY()
+
+	/** Content folder to list; its subfolders are not searched */
+	UPROPERTY()
+	FString Path = TEXT("/Game");
+};
+
+/** resources.get */
+USTRUCT()
+struct FMCPResourcesGetParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString AssetPath;
+};
+
+/** resources.create */
+USTRUCT()
+struct FMCPResourcesCreateParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString AssetType;
+
+	UPROPERTY(meta = (Required))
+	FString AssetName;
+
+	UPROPERTY(meta = (Required))
+	FString Path;
+
+	/** Defaults to Actor */
+	UPROPERTY()
+	FString ParentClass;
+};
+
+/** tools.create_blueprint */
+USTRUCT()
+struct FMCPCreateBlueprintParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString BlueprintName;
+
+	UPROPERTY(meta = (Required))
+	FString Path;
+
+	UPROPERTY(meta = (Required))
+	FString ParentClass;
+};
+
+/** tools.add_variable */
+USTRUCT()
+struct FMCPAddVariableParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString BlueprintPath;
+
+	UPROPERTY(meta = (Required))
+	FString VariableName;
+
+	UPROPERTY(meta = (Required))
+	FString VariableType;
+
+	UPROPERTY()
+	bool bIsPublic = false;
+};
+
+/** tools.add_function */
+USTRUCT()
+struct FMCPAddFunctionParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString BlueprintPath;
+
+	UPROPERTY(meta = (Required))
+	FString FunctionName;
+};
+
+/** One entry of tools.edit_graph nodes_to_add */
+USTRUCT()
+struct FMCPGraphNodeParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString Type;
+
+	UPROPERTY()
+	int32 X = 0;
+
+	UPROPERTY()
+	int32 Y = 0;
+};
+
+/** tools.edit_graph */
+USTRUCT()
+struct FMCPEditGraphParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString BlueprintPath;
+
+	/** EventGraph or the name of a function graph */
+	UPROPERTY(meta = (Required))
+	FString GraphName;
+
+	UPROPERTY()
+	TArray<FMCPGraphNodeParams> NodesToAdd;
+};
+
+/** One entry of tools.batch operations */
+USTRUCT()
+struct FMCPToolOperationParams
+{
+	GENERATED_BODY()
+
+	/** tools.add_variable, tools.add_function or tools.edit_graph */
+	UPROPERTY(meta = (Required))
+	FString Method;
+
+	/** The params that method takes on its own, decoded once the method is known */
+	UPROPERTY(meta = (RawJson))
+	FString Params;
+};
+
+/** tools.batch */
+USTRUCT()
+struct FMCPToolsBatchParams
+{
+	GENERATED_BODY()
+
+	/** Applied in order; at most FMCPJsonRpcServer::MaxToolOperations */
+	UPROPERTY(meta = (Required))
+	TArray<FMCPToolOperationParams> Operations;
+
+	/** Compile each Blueprint the batch changed, once, after refreshing it */
+	UPROPERTY()
+	bool bCompile = false;
+};
+
+/** prompts.get */
+USTRUCT()
+struct FMCPPromptsGetParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(meta = (Required))
+	FString PromptName;
+};
+
+/** diagnostics.synthetic_assets */
+USTRUCT()
+struct FMCPSyntheticAssetsParams
+{
+	GENERATED_BODY()
+
+	/** Clamped to FMCPJsonRpcServer::MaxSyntheticAssets */
+	UPROPERTY()
+	int32 Count = 100000;
+};
+
+/** diagnostics.game_thread_work */
+USTRUCT()
+struct FMCPGameThreadWorkParams
+{
+	GENERATED_BODY()
+
+	/** Game-thread time to burn, clamped to FMCPJsonRpcServer::MaxGameThreadWorkMs */
+	UPROPERTY()
+	double WorkMs = 1.0;
+};
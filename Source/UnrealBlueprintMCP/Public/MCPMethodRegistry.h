@@ -0,0 +1,202 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Dom/JsonObject.h"
+#include "Async/Future.h"
+
+class UScriptStruct;
+class FMCPJsonWriter;
+
+/** Writes one JSON-RPC result value straight into the response body, without building an FJsonObject */
+typedef TFunction<void(FMCPJsonWriter&)> FMCPResultStreamer;
+
+/** Builds the JSON-RPC result for a method from its params */
+typedef TFunction<TSharedPtr<FJsonObject>(TSharedPtr<FJsonObject>)> FMCPMethodHandler;
+
+/**
+ * Does the up-front work for a streamed result and returns the streamer that writes it, as a
+ * future so work queued on the game thread is not waited for; an unbound streamer means it failed
+ */
+typedef TFunction<TFuture<FMCPResultStreamer>(TSharedPtr<FJsonObject>)> FMCPMethodStreamHandler;
+
+/** Builds the result from params already decoded into the descriptor's ParamsStruct */
+typedef TFunction<TSharedPtr<FJsonObject>(const void*)> FMCPTypedMethodHandler;
+
+/** Streamed form of FMCPTypedMethodHandler */
+typedef TFunction<TFuture<FMCPResultStreamer>(const void*)> FMCPTypedMethodStreamHandler;
+
+/** Names what a cacheable result depends on, from the decoded params struct (nullptr without one) */
+typedef TFunction<FName(const void*)> FMCPCacheDependency;
+
+/** Rate-limit tokens a request takes, from the text of its params (empty without them) */
+typedef TFunction<int32(FUtf8StringView)> FMCPRateCost;
+
+/**
+ * Where a method's handler has to run
+ */
+enum class EMCPMethodThreading : uint8
+{
+	/** Safe on worker threads; runs on the worker that received the request */
+	AnyThread,
+	/** Touches editor state; the server runs the handler on the game thread */
+	GameThread
+};
+
+/**
+ * Whether a method changes editor state
+ */
+enum class EMCPMethodAccess : uint8
+{
+	Read,
+	Write
+};
+
+/**
+ * Everything the server needs to know to dispatch one JSON-RPC method
+ */
+struct UNREALBLUEPRINTMCP_API FMCPMethodDescriptor
+{
+	FMCPMethodDescriptor() = default;
+	FMCPMethodDescriptor(FName InName, FMCPMethodHandler InHandler, EMCPMethodThreading InThreading, EMCPMethodAccess InAccess, const FString& InDescription);
+
+	/**
+	 * Describe a method whose handler takes a USTRUCT. The server decodes params into TParams with
+	 * FMCPParamsBinding before calling it and answers -32602 itself when they do not fit.
+	 */
+	template<typename TParams>
+	static FMCPMethodDescriptor MakeTyped(FName InName, TFunction<TSharedPtr<FJsonObject>(const TParams&)> InHandler, EMCPMethodThreading InThreading, EMCPMethodAccess InAccess, const FString& InDescription)
+	{
+		FMCPMethodDescriptor Descriptor(InName, FMCPMethodHandler(), InThreading, InAccess, InDescription);
+		Descriptor.ParamsStruct = TParams::StaticStruct();
+		Descriptor.TypedHandler = [Handler = MoveTemp(InHandler)](const void* Params)
+		{
+			return Handler(*static_cast<const TParams*>(Params));
+		};
+		return Descriptor;
+	}
+
+	/**
+	 * Describe a method that writes its result with FMCPJsonWriter, from params decoded into TParams.
+	 * InHandler is called on a worker, as StreamHandler is.
+	 */
+	template<typename TParams>
+	static FMCPMethodDescriptor MakeTypedStream(FName InName, TFunction<TFuture<FMCPResultStreamer>(const TParams&)> InHandler, EMCPMethodThreading InThreading, EMCPMethodAccess InAccess, const FString& InDescription)
+	{
+		FMCPMethodDescriptor Descriptor(InName, FMCPMethodHandler(), InThreading, InAccess, InDescription);
+		Descriptor.ParamsStruct = TParams::StaticStruct();
+		Descriptor.TypedStreamHandler = [Handler = MoveTemp(InHandler)](const void* Params)
+		{
+			return Handler(*static_cast<const TParams*>(Params));
+		};
+		return Descriptor;
+	}
+
+	bool HasHandler() const { return Handler || TypedHandler || IsStreamed(); }
+
+	/** Whether the result is written with FMCPJsonWriter rather than built as an FJsonObject */
+	bool IsStreamed() const { return StreamHandler || TypedStreamHandler; }
+
+	/** JSON-RPC method name, e.g. "tools.add_variable"; matched case-insensitively */
+	FName Name;
+
+	/** Builds the result; unbound for methods that stream it */
+	FMCPMethodHandler Handler;
+
+	/** Set by MakeTyped() and MakeTypedStream(): the params struct and the handler that takes it */
+	const UScriptStruct* ParamsStruct = nullptr;
+	FMCPTypedMethodHandler TypedHandler;
+	FMCPTypedMethodStreamHandler TypedStreamHandler;
+
+	/**
+	 * Streamed form, used instead of Handler whenever it is bound, batch entries included. Called on
+	 * a worker whatever Threading says, so it queues anything that needs the game thread itself and
+	 * returns a future the game thread fulfils, which has to resolve by its own deadline; the
+	 * request waits for it without holding a worker. The streamer runs on the worker that writes
+	 * the response.
+	 */
+	FMCPMethodStreamHandler StreamHandler;
+
+	EMCPMethodThreading Threading = EMCPMethodThreading::GameThread;
+
+	EMCPMethodAccess Access = EMCPMethodAccess::Write;
+
+	/** Longest a request waits for the handler to run on the game thread; 0 uses the server default */
+	double TimeoutSeconds = 0.0;
+
+	/** Only served while diagnostics are enabled in the server settings */
+	bool bDiagnostic = false;
+
+	/**
+	 * Bound for read methods whose serialized result the server may keep and replay, see
+	 * FMCPResultCache. Returns the content folder or package the result describes, so a change to
+	 * it drops the cached copy, or NAME_None if nothing in the editor changes the result.
+	 */
+	FMCPCacheDependency CacheDependency;
+
+	/**
+	 * Bound for methods that do the work of several requests in one, such as tools.batch. Read
+	 * before the params are decoded, so it has to be cheap; unbound, a request costs one token.
+	 */
+	FMCPRateCost RateCost;
+
+	/** One line for the server.methods listing */
+	FString Description;
+};
+
+/**
+ * Process-wide table of JSON-RPC methods served by FMCPJsonRpcServer
+ *
+ * The server registers its built-in methods when it is created. Other editor modules can add
+ * their own from StartupModule() and remove them again in ShutdownModule():
+ *
+ *     FMCPMethodRegistry::Get().RegisterMethod(FMCPMethodDescriptor(TEXT("mytool.run"), ...), this);
+ *     FMCPMethodRegistry::Get().UnregisterAll(this);
+ *
+ * Lookups are a name-table probe plus a map lookup, whatever the number of methods. Descriptors are
+ * immutable once registered, so a request keeps using the one it looked up even if the method is
+ * replaced or removed while it runs. Thread-safe.
+ */
+class UNREALBLUEPRINTMCP_API FMCPMethodRegistry
+{
+public:
+	typedef TSharedRef<const FMCPMethodDescriptor, ESPMode::ThreadSafe> FDescriptorRef;
+	typedef TSharedPtr<const FMCPMethodDescriptor, ESPMode::ThreadSafe> FDescriptorPtr;
+
+	static FMCPMethodRegistry& Get();
+
+	/**
+	 * Add a method, replacing any method of the same name. Owner is an opaque tag for UnregisterAll().
+	 * Returns false if the descriptor has no name or no handler is bound.
+	 */
+	bool RegisterMethod(const FMCPMethodDescriptor& Descriptor, const void* Owner = nullptr);
+
+	/** Remove a method; returns false if it was not registered */
+	bool UnregisterMethod(FName Name);
+
+	/** Remove every method still registered under Owner */
+	void UnregisterAll(const void* Owner);
+
+	/** Find a method by name */
+	FDescriptorPtr FindMethod(FName Name) const;
+
+	/** Find a method by the name a client sent; never adds the name to the global name table */
+	FDescriptorPtr FindMethod(const FString& Name) const;
+
+	/** All registered methods, sorted by name */
+	TArray<FDescriptorRef> GetMethods() const;
+
+	static const TCHAR* LexThreading(EMCPMethodThreading Threading);
+	static const TCHAR* LexAccess(EMCPMethodAccess Access);
+
+private:
+	struct FEntry
+	{
+		FDescriptorRef Descriptor;
+		const void* Owner;
+	};
+
+	TMap<FName, FEntry> Methods;
+
+	mutable FRWLock MethodsLock;
+};
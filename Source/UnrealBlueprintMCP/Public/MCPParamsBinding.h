@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UScriptStruct;
+class FMCPJsonReader;
+
+/**
+ * Decodes JSON-RPC params into a reflected USTRUCT
+ *
+ * The property list of each struct is turned into a field table once, on first use: JSON name,
+ * property, whether it is required. Decoding then pulls the params text through FMCPJsonReader
+ * once, matching each member against the table and writing it straight into the struct, so no
+ * FJsonObject is built and array elements are decoded one at a time as they are read.
+ *
+ * Supported property types: FString, FName, bool, integer and floating point numbers, nested
+ * USTRUCTs (JSON objects) and TArrays of any of these. Unknown JSON members are ignored and null
+ * counts as absent. Errors name the offending field, e.g. "nodes_to_add[2].type".
+ *
+ * An FString member marked meta = (RawJson) takes any JSON value and keeps its text, checked for
+ * syntax but not decoded, for params whose shape depends on another field (see tools.batch).
+ */
+class UNREALBLUEPRINTMCP_API FMCPParamsBinding
+{
+public:
+	struct FFieldInfo
+	{
+		FString JsonName;
+		const FProperty* Property;
+		bool bRequired;
+
+		/** meta = (RawJson): the value's text is stored instead of being decoded */
+		bool bRawJson;
+	};
+
+	/**
+	 * Fill Out, an initialized instance of Struct, from the JSON text of a params object. Empty
+	 * text counts as an empty object. Returns false with a message suitable for a -32602 error if
+	 * params is not an object or a field is missing or has the wrong type.
+	 */
+	static bool Decode(const UScriptStruct* Struct, void* Out, FUtf8StringView Params, FString& OutError);
+
+	template<typename TParams>
+	static bool Decode(FUtf8StringView Params, TParams& Out, FString& OutError)
+	{
+		return Decode(TParams::StaticStruct(), &Out, Params, OutError);
+	}
+
+	/** Field table for Struct, built on first use and kept for the lifetime of the process */
+	static const TArray<FFieldInfo>& DescribeFields(const UScriptStruct* Struct);
+
+	/** JSON member name for a property: its name in snake_case, without the b prefix of bools */
+	static FString GetJsonName(const FProperty* Property);
+
+private:
+
+	/** Path is the JSON path of the value being decoded, for error messages; restored before returning true */
+	static bool DecodeObject(const UScriptStruct* Struct, void* Out, FMCPJsonReader& Reader, FString& Path, FString& OutError);
+	static bool DecodeValue(const FProperty* Property, void* ValuePtr, FMCPJsonReader& Reader, FString& Path, FString& OutError);
+};
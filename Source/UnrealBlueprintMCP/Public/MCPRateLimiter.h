@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Rate limit classes; the server has one bucket per class
+ */
+enum class EMCPRateClass : uint8
+{
+	/** Queries and status calls */
+	Read,
+
+	/** Methods registered with EMCPMethodAccess::Write */
+	Mutation
+};
+
+/**
+ * Lock-free token bucket
+ *
+ * Stored as the time at which the bucket would be full again (the "theoretical arrival time" form
+ * of a token bucket), so taking a token is a single compare-and-swap on one 64-bit value and
+ * concurrent callers never block each other.
+ */
+class UNREALBLUEPRINTMCP_API FMCPTokenBucket
+{
+public:
+	/** A bucket holding up to Burst tokens, refilled at TokensPerSecond */
+	FMCPTokenBucket(double TokensPerSecond, double Burst);
+
+	/**
+	 * Take Tokens tokens at once; when there are not enough, returns false with the time until
+	 * there are. Tokens must not exceed GetCapacity(), or that time never comes.
+	 */
+	bool TryConsume(int64 NowMicroseconds, int32 Tokens, int64& OutRetryAfterMicroseconds);
+
+	/** Most tokens the bucket holds */
+	int32 GetCapacity() const;
+
+private:
+	/** Time needed to earn one token */
+	int64 IntervalMicroseconds;
+
+	/** How far ahead of now the arrival time may run, i.e. the bucket capacity in time */
+	int64 CapacityMicroseconds;
+
+	std::atomic<int64> TheoreticalArrivalMicroseconds;
+};
+
+/**
+ * Enforces UMCPServerSettings::RequestRateLimit
+ *
+ * Every request is charged against the server-wide bucket of its class. Mutations have their own,
+ * smaller bucket so a burst of edits cannot queue up seconds of game-thread work, while
+ * reads stay fast. There are no per-client buckets: the server only accepts connections from
+ * localhost and knows a single API key, so it has no identity to tell clients apart by, and the
+ * limit protects the editor rather than sharing it out. Instances are immutable apart from bucket
+ * state; ApplySettings swaps in a new limiter when the limit changes.
+ */
+class UNREALBLUEPRINTMCP_API FMCPRateLimiter
+{
+public:
+	/** RequestsPerSecond <= 0 disables limiting */
+	explicit FMCPRateLimiter(int32 RequestsPerSecond);
+
+	bool IsEnabled() const { return RequestsPerSecond > 0; }
+
+	/**
+	 * Charge a request of the given class Cost tokens; returns false with a retry hint when its
+	 * bucket does not hold that many. A cost above GetCapacity() is never granted.
+	 */
+	bool TryAcquire(EMCPRateClass RateClass, int32 Cost, double& OutRetryAfterSeconds);
+
+	/** Most tokens one request of the class can be charged */
+	int32 GetCapacity(EMCPRateClass RateClass) const;
+
+	/** Mutations get this fraction of the read rate */
+	static constexpr int32 MutationRateDivisor = 5;
+
+private:
+	int32 RequestsPerSecond;
+	double ReadRate;
+	double MutationRate;
+
+	FMCPTokenBucket Read;
+	FMCPTokenBucket Mutation;
+};
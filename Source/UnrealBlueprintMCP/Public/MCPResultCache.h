@@ -0,0 +1,134 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Snapshot of result cache counters
+ */
+struct FMCPResultCacheStats
+{
+	/** UMCPServerSettings::ResultCacheMegabytes in bytes; 0 when the cache is off */
+	int64 BudgetBytes = 0;
+
+	/** Results, keys and bookkeeping currently held */
+	int64 BytesHeld = 0;
+
+	int32 Entries = 0;
+
+	/** Requests answered from the cache, and cacheable requests that had to run their handler */
+	int64 Hits = 0;
+	int64 Misses = 0;
+
+	/** Entries dropped to stay within the budget */
+	int64 Evictions = 0;
+
+	/** Entries dropped because an asset or Blueprint they describe changed */
+	int64 Invalidations = 0;
+
+	double GetHitRate() const
+	{
+		return Hits + Misses > 0 ? (double)Hits / (double)(Hits + Misses) : 0.0;
+	}
+};
+
+/**
+ * Serialized results of idempotent read methods, shared by every connection
+ *
+ * Entries are keyed by method and normalized params and hold the condensed UTF-8 "result" value,
+ * ready for FMCPJsonWriter::WriteRawValue. Each entry names the one thing its result depends on:
+ * a content folder for listings, a package for single assets, or NAME_None for results nothing in
+ * the editor can change. Editor events call Invalidate() with the folder and package of whatever
+ * changed, which drops exactly the entries that described it.
+ *
+ * A result is computed outside the lock, so an event can arrive while it is being built. Fills
+ * take the generation first and Store() refuses them if any invalidation happened since, so a
+ * result built from the registry before a change is never published after it.
+ *
+ * The least recently used entries are evicted to keep the total within the budget.
+ */
+class UNREALBLUEPRINTMCP_API FMCPResultCache
+{
+public:
+	typedef TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> FResultPtr;
+
+	FMCPResultCache();
+
+	/** Change the memory budget, evicting down to it; 0 turns the cache off and empties it */
+	void SetBudget(int64 InBudgetBytes);
+
+	bool IsEnabled() const { return BudgetBytes.load(std::memory_order_relaxed) > 0; }
+
+	/** The cached result for Key, marked as most recently used, or nullptr; counts a hit or a miss */
+	FResultPtr Find(const FString& Key);
+
+	/** Take before computing a result, and pass to Store() */
+	uint64 GetGeneration() const { return Generation.load(std::memory_order_acquire); }
+
+	/**
+	 * Publish a result computed since FillGeneration was taken. Refused if something was
+	 * invalidated in the meantime, or if the result would take more than a quarter of the budget.
+	 */
+	bool Store(const FString& Key, FName Dependency, FResultPtr Result, uint64 FillGeneration);
+
+	/** Drop every entry that depends on Dependency; safe to call from any thread */
+	void Invalidate(FName Dependency);
+
+	/** Drop everything, e.g. when a change cannot be attributed to one folder or package */
+	void Empty();
+
+	FMCPResultCacheStats GetStats() const;
+
+	/** Upper bound on the entry count, whatever the budget */
+	static constexpr int32 MaxEntries = 16 * 1024;
+
+	/** Charged per entry on top of its key and result, for the entry, index and map slots */
+	static constexpr int64 EntryOverheadBytes = 128;
+
+private:
+	struct FEntry
+	{
+		FString Key;
+		FName Dependency;
+		FResultPtr Result;
+		int64 Bytes = 0;
+
+		/** Neighbours in the recency list, towards MostRecent and LeastRecent */
+		int32 Newer = INDEX_NONE;
+		int32 Older = INDEX_NONE;
+	};
+
+	/** Keys differ in argument text, so they compare case-sensitively unlike FString's defaults */
+	struct FKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	/** The following require Lock */
+	void Link(int32 Index);
+	void Unlink(int32 Index);
+	void Remove(int32 Index);
+	void EvictToFit(int64 IncomingBytes, int64 Budget);
+
+	TSparseArray<FEntry> Entries;
+	TMap<FString, int32, FDefaultSetAllocator, FKeyFuncs> EntriesByKey;
+	TMultiMap<FName, int32> EntriesByDependency;
+
+	int32 MostRecent = INDEX_NONE;
+	int32 LeastRecent = INDEX_NONE;
+
+	int64 BytesHeld = 0;
+	int64 Hits = 0;
+	int64 Misses = 0;
+	int64 Evictions = 0;
+	int64 Invalidations = 0;
+
+	std::atomic<int64> BudgetBytes;
+
+	/** Bumped by every invalidation, before entries are dropped */
+	std::atomic<uint64> Generation;
+
+	mutable FCriticalSection Lock;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPHttpResponse.h"
+#include "MCPRateLimiter.h"
+
+class UMCPServerSettings;
+
+/**
+ * Immutable snapshot of the settings the connection pipeline reads
+ *
+ * ApplySettings builds a new snapshot off the hot path and publishes it with one pointer swap.
+ * Connections take a reference per request, so each request sees one consistent set of values
+ * and a settings change takes effect on the next request without restarting the server.
+ */
+struct UNREALBLUEPRINTMCP_API FMCPServerConfig
+{
+	/** Defaults matching UMCPServerSettings, used until settings are applied */
+	FMCPServerConfig();
+
+	/**
+	 * Build a snapshot from Settings. Previous, when given, donates its rate limiter if the
+	 * limit is unchanged, so clients keep their bucket state across unrelated changes.
+	 */
+	static TSharedRef<const FMCPServerConfig, ESPMode::ThreadSafe> Build(const UMCPServerSettings& Settings, const FMCPServerConfig* Previous);
+
+	/** TCP port the listener should be bound to */
+	int32 ServerPort;
+
+	/** Worker threads and queue slots for connections */
+	int32 MaxConnections;
+	int32 ConnectionQueueSize;
+
+	/** Idle, receive and send timeouts */
+	int32 TimeoutSeconds;
+
+	/** Requests served on one keep-alive connection before it is closed */
+	int32 MaxRequestsPerConnection;
+
+	bool bEnableCORS;
+	bool bEnableAuth;
+	FString APIKey;
+	TMap<FString, FString> CustomHeaders;
+
+	/** UMCPServerSettings::bEnableDiagnosticMethods */
+	bool bEnableDiagnostics;
+
+	/** Unix domain socket listener; the path is already resolved */
+	bool bEnableLocalSocket;
+	FString LocalSocketPath;
+
+	/** Compression is off when bCompression is false */
+	bool bCompression;
+	ECompressionFlags CompressionFlags;
+	int32 CompressionMinBytes;
+
+	/** UMCPServerSettings::ResultCacheMegabytes in bytes; 0 disables the result cache */
+	int64 ResultCacheBytes;
+
+	/** UMCPServerSettings::GameThreadBudgetMs in seconds */
+	double GameThreadBudgetSeconds;
+
+	/** UMCPServerSettings::BlueprintRefreshDelayMs in seconds; 0 refreshes after every edit */
+	double BlueprintRefreshDelaySeconds;
+
+	/** UMCPServerSettings::RequestRateLimit; 0 disables limiting */
+	int32 RequestRateLimit;
+
+	/** Header lines compiled from the values above */
+	TSharedRef<const FMCPHttpHeaderBlock, ESPMode::ThreadSafe> HeaderBlock;
+
+	/** Limiter for RequestRateLimit; shared with the previous snapshot while the limit is unchanged */
+	TSharedRef<FMCPRateLimiter, ESPMode::ThreadSafe> RateLimiter;
+};
@@ -16,6 +16,18 @@ enum class EMCPLogLevel : uint8
 	Detailed		UMETA(DisplayName = "Detailed")
 };
 
+/**
+ * Response compression level for gzip/deflate encoded responses
+ */
+UENUM(BlueprintType)
+enum class EMCPCompressionLevel : uint8
+{
+	Disabled		UMETA(DisplayName = "Disabled"),
+	Fastest			UMETA(DisplayName = "Fastest"),
+	Balanced		UMETA(DisplayName = "Balanced"),
+	Smallest		UMETA(DisplayName = "Smallest")
+};
+
 /**
  * Server Preset enumeration for common configurations
  */
@@ -69,14 +81,30 @@ public:
 		meta = (DisplayName = "Max Client Connections", ToolTip = "Maximum number of simultaneous client connections", ClampMin = "1", ClampMax = "100"))
 	int32 MaxClientConnections = 10;
 
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Configuration",
+		meta = (DisplayName = "Connection Queue Size", ToolTip = "Connections allowed to wait for a free worker when all are busy; further clients get 503 Service Unavailable", ClampMin = "0", ClampMax = "1000"))
+	int32 ConnectionQueueSize = 10;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Configuration",
 		meta = (DisplayName = "Server Timeout (seconds)", ToolTip = "Connection timeout in seconds", ClampMin = "5", ClampMax = "300"))
 	int32 ServerTimeoutSeconds = 30;
 
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Configuration",
+		meta = (DisplayName = "Max Requests Per Connection", ToolTip = "Maximum number of requests served on one keep-alive connection before it is closed", ClampMin = "1", ClampMax = "10000"))
+	int32 MaxRequestsPerConnection = 100;
+
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Configuration",
 		meta = (DisplayName = "Enable CORS", ToolTip = "Enable Cross-Origin Resource Sharing for web clients"))
 	bool bEnableCORS = false;
 
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Configuration",
+		meta = (DisplayName = "Enable Local Socket", ToolTip = "Also serve the same API on a Unix domain socket, which same-host clients can use without going through TCP"))
+	bool bEnableLocalSocket = false;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Configuration",
+		meta = (DisplayName = "Local Socket Path", ToolTip = "Path of the Unix domain socket (empty = unreal-blueprint-mcp.sock in the user temp directory)", EditCondition = "bEnableLocalSocket"))
+	FString LocalSocketPath;
+
 	// Logging Configuration
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Logging",
 		meta = (DisplayName = "Log Level", ToolTip = "Verbosity level for server logging"))
@@ -100,7 +128,7 @@ public:
 	TArray<FString> AllowedOrigins;
 
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
-		meta = (DisplayName = "Request Rate Limit", ToolTip = "Maximum requests per second per client (0 = unlimited)", ClampMin = "0", ClampMax = "1000"))
+		meta = (DisplayName = "Request Rate Limit", ToolTip = "Maximum requests per second across all clients (0 = unlimited). Methods that change editor state are limited to a fifth of this", ClampMin = "0", ClampMax = "1000"))
 	int32 RequestRateLimit = 0;
 
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
@@ -111,6 +139,30 @@ public:
 		meta = (DisplayName = "API Key", ToolTip = "API key for authentication (leave empty to disable)", EditCondition = "bEnableAuthentication", PasswordField = true))
 	FString APIKey;
 
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
+		meta = (DisplayName = "Response Compression", ToolTip = "gzip/deflate level for responses to clients that send Accept-Encoding"))
+	EMCPCompressionLevel CompressionLevel = EMCPCompressionLevel::Fastest;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
+		meta = (DisplayName = "Compression Threshold (bytes)", ToolTip = "Responses smaller than this are sent uncompressed", ClampMin = "0", ClampMax = "10485760"))
+	int32 CompressionMinBytes = 1024;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
+		meta = (DisplayName = "Result Cache (MB)", ToolTip = "Memory kept for cached resources.* and prompts.* results, dropped when the assets they describe change (0 = no caching)", ClampMin = "0", ClampMax = "1024"))
+	int32 ResultCacheMegabytes = 32;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
+		meta = (DisplayName = "Game Thread Budget (ms)", ToolTip = "Editor frame time spent running queued requests before the rest wait for the next frame; one request always runs per frame", ClampMin = "1", ClampMax = "100"))
+	int32 GameThreadBudgetMs = 5;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
+		meta = (DisplayName = "Blueprint Refresh Delay (ms)", ToolTip = "How long edits to a Blueprint must pause before its nodes are refreshed once for all of them; reads, saves and Play In Editor refresh first (0 = refresh after every edit)", ClampMin = "0", ClampMax = "10000"))
+	int32 BlueprintRefreshDelayMs = 200;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Advanced",
+		meta = (DisplayName = "Enable Diagnostic Methods", ToolTip = "Expose diagnostics.* methods that generate synthetic load for benchmarking (development only)"))
+	bool bEnableDiagnosticMethods = false;
+
 	// Preset Management
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Presets",
 		meta = (DisplayName = "Current Preset", ToolTip = "Current configuration preset"))
@@ -172,12 +224,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MCP Server Settings")
 	FString GetServerURL() const;
 
+	/** Get the Unix domain socket path, resolving the default when LocalSocketPath is empty */
+	UFUNCTION(BlueprintCallable, Category = "MCP Server Settings")
+	FString GetLocalSocketPath() const;
+
 	/** Get settings as formatted string for display */
 	UFUNCTION(BlueprintCallable, Category = "MCP Server Settings")
 	FString GetSettingsDisplayString() const;
 
-	/** Check if settings require server restart */
-	UFUNCTION(BlueprintCallable, Category = "MCP Server Settings")
+	/** Check if settings require server restart; always false now that every setting is applied live */
+	UFUNCTION(BlueprintCallable, Category = "MCP Server Settings", meta = (DeprecatedFunction, DeprecationMessage = "Settings are applied without restarting the server"))
 	bool RequiresServerRestart(const UMCPServerSettings* OtherSettings) const;
 
 private:
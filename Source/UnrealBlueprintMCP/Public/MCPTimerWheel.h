@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hashed timer wheel for connection deadlines
+ *
+ * Each deadline is rounded up to a tick and hashed into one of NumSlots buckets, so scheduling and
+ * cancelling are O(1) however many timers are pending, and Advance() only visits the buckets whose
+ * ticks have passed. Deadlines more than one revolution away share a bucket with nearer ones and
+ * are skipped until their own tick comes round. Timers never fire early; they fire up to one tick late.
+ *
+ * Not thread-safe: the wheel belongs to the thread that advances it.
+ */
+class UNREALBLUEPRINTMCP_API FMCPTimerWheel
+{
+public:
+	FMCPTimerWheel(double InTickSeconds, int32 InNumSlots);
+
+	/**
+	 * Schedule Key to expire at DeadlineSeconds, on the FPlatformTime::Seconds() clock.
+	 * Returns the timer id to pass to Cancel(); it is only valid until the timer expires or is cancelled.
+	 */
+	int32 Schedule(double DeadlineSeconds, UPTRINT Key);
+
+	/** Remove a pending timer; INDEX_NONE is ignored */
+	void Cancel(int32 TimerId);
+
+	/** Expire every timer whose deadline is at or before NowSeconds and append their keys to OutExpired */
+	void Advance(double NowSeconds, TArray<UPTRINT>& OutExpired);
+
+	/** Number of pending timers */
+	int32 Num() const { return NumTimers; }
+
+	/** Resolution of the wheel */
+	double GetTickSeconds() const { return TickSeconds; }
+
+private:
+	struct FTimer
+	{
+		UPTRINT Key = 0;
+		int64 DeadlineTick = 0;
+
+		/** Bucket the timer is linked into, INDEX_NONE while the entry is free */
+		int32 Slot = INDEX_NONE;
+
+		/** Neighbours in the bucket list; free entries are chained through Next */
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	void Unlink(int32 TimerId);
+
+	double TickSeconds;
+
+	/** First timer of each bucket */
+	TArray<int32> Slots;
+
+	/** Timer storage, indexed by timer id */
+	TArray<FTimer> Timers;
+
+	/** First free entry in Timers */
+	int32 FreeList;
+
+	int32 NumTimers;
+
+	/** Last tick Advance() has processed */
+	int64 CurrentTick;
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class FSocket;
+
+/**
+ * WebSocket frame opcodes (RFC 6455 section 5.2)
+ */
+enum class EMCPWebSocketOpcode : uint8
+{
+	Continuation = 0x0,
+	Text = 0x1,
+	Binary = 0x2,
+	Close = 0x8,
+	Ping = 0x9,
+	Pong = 0xA
+};
+
+/**
+ * Result of feeding bytes to FMCPWebSocketFrameParser
+ */
+enum class EMCPWebSocketParseResult : uint8
+{
+	/** No complete message is buffered yet */
+	NeedMoreData,
+
+	/** A complete message (or control frame) was produced */
+	Message,
+
+	/** The peer violated the protocol; close with GetCloseCode() */
+	Error
+};
+
+/**
+ * One complete WebSocket message; fragmented data messages are already reassembled
+ */
+struct FMCPWebSocketMessage
+{
+	EMCPWebSocketOpcode Opcode = EMCPWebSocketOpcode::Text;
+	TArray<uint8> Payload;
+};
+
+/**
+ * Incremental parser for client-to-server WebSocket frames
+ *
+ * Uses the same receive-in-place interface as FMCPHttpRequestParser. Client frames must be
+ * masked; payloads are unmasked while being copied out. Control frames are returned as soon
+ * as they arrive, even in the middle of a fragmented message.
+ */
+class UNREALBLUEPRINTMCP_API FMCPWebSocketFrameParser
+{
+public:
+	explicit FMCPWebSocketFrameParser(int64 InMaxMessageBytes = 64 * 1024 * 1024);
+
+	/** Get space for at least MinBytes of incoming data; follow with CommitWrite() */
+	uint8* GetWriteBuffer(int32 MinBytes);
+
+	/** Mark BytesWritten bytes of the write buffer as received */
+	void CommitWrite(int32 BytesWritten);
+
+	/** Copy already received bytes into the parser, e.g. what followed the Upgrade request */
+	void Append(TArrayView<const uint8> Bytes);
+
+	/** Extract the next complete message, if any */
+	EMCPWebSocketParseResult Parse(FMCPWebSocketMessage& OutMessage);
+
+	/** Close status code describing the last parse error (1002, 1009) */
+	uint16 GetCloseCode() const { return CloseCode; }
+
+private:
+	EMCPWebSocketParseResult SetError(uint16 InCloseCode);
+
+	/** Receive buffer; frames start at ReadOffset */
+	TArray<uint8> Buffer;
+	int32 ValidBytes;
+	int32 ReadOffset;
+
+	/** Data message being reassembled from fragments */
+	TArray<uint8> FragmentPayload;
+	EMCPWebSocketOpcode FragmentOpcode;
+	bool bInFragmentedMessage;
+
+	int64 MaxMessageBytes;
+	uint16 CloseCode;
+};
+
+/**
+ * WebSocket helpers shared by the handshake and the session loop
+ */
+struct UNREALBLUEPRINTMCP_API FMCPWebSocket
+{
+	/** Compute Sec-WebSocket-Accept for a client's Sec-WebSocket-Key */
+	static FString ComputeAcceptKey(const FString& ClientKey);
+
+	/** Check that a Sec-WebSocket-Key is the base64 encoding of 16 bytes */
+	static bool IsValidClientKey(const FString& ClientKey);
+
+	/** Append one unmasked server-to-client frame */
+	static void EncodeFrame(EMCPWebSocketOpcode Opcode, const uint8* Payload, int64 PayloadBytes, TArray<uint8>& Out);
+
+	/** Append a Close frame carrying a status code */
+	static void EncodeCloseFrame(uint16 CloseCode, TArray<uint8>& Out);
+};
+
+/**
+ * Server side of one WebSocket connection
+ *
+ * The session's worker thread reads frames and answers requests; other threads (e.g. the
+ * game thread raising notifications) may queue frames at any time through Send(). Sends never
+ * block the caller: whatever the socket does not accept right away waits in the outbox until
+ * the session thread sees the socket become writable.
+ */
+class UNREALBLUEPRINTMCP_API FMCPWebSocketSession
+{
+public:
+	FMCPWebSocketSession(FSocket* InSocket, int64 InMaxOutboxBytes);
+
+	/**
+	 * Queue an encoded frame and push out as much as the socket accepts without blocking.
+	 * Returns false if the session is closed or the client stopped reading and the outbox overflowed.
+	 */
+	bool Send(TArrayView<const uint8> Frame);
+
+	/** Push out queued bytes without blocking; returns false on a socket error */
+	bool Flush();
+
+	/** Check whether queued bytes are waiting for the socket */
+	bool HasPendingOutput() const;
+
+	/** Stop accepting frames; once this returns no other thread will touch the socket */
+	void MarkClosed();
+	bool IsClosed() const { return bClosed; }
+
+	FSocket* GetSocket() const { return Socket; }
+
+private:
+	/** Send outbox bytes until the socket would block; caller holds OutboxLock */
+	bool FlushLocked();
+
+	FSocket* Socket;
+	int64 MaxOutboxBytes;
+
+	mutable FCriticalSection OutboxLock;
+	TArray<uint8> Outbox;
+	std::atomic<bool> bClosed;
+};
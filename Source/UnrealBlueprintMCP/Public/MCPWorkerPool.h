@@ -0,0 +1,134 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+class FQueuedThreadPool;
+
+/**
+ * Snapshot of worker pool counters
+ */
+struct FMCPWorkerPoolStats
+{
+	/** Number of worker threads */
+	int32 NumWorkers = 0;
+
+	/** Maximum number of items allowed to wait for a worker */
+	int32 QueueCapacity = 0;
+
+	/** Workers currently running an item */
+	int32 ActiveWorkers = 0;
+
+	/** Items waiting for a worker */
+	int32 QueueDepth = 0;
+
+	/** Highest queue depth observed since the pool started */
+	int32 PeakQueueDepth = 0;
+
+	/** Items that finished running */
+	int64 CompletedItems = 0;
+
+	/** Items turned away because workers and queue were full */
+	int64 RejectedItems = 0;
+
+	/** Fraction of total worker time spent running items since the pool started or was resized */
+	double Utilization = 0.0;
+};
+
+/**
+ * Fixed-size thread pool with a bounded queue, dedicated to MCP connections
+ *
+ * Work is admitted only while busy workers plus waiting items stay within
+ * NumWorkers + QueueCapacity; anything beyond that is rejected immediately so the
+ * caller can answer with 503 instead of letting a burst pile up. The pool owns its
+ * threads, so MCP load never competes with the engine's shared background task graph.
+ *
+ * Resize() swaps in a new set of threads without stopping: items already queued on the old
+ * threads still run there, and the old threads are destroyed by the next Resize() or Shutdown()
+ * after they have gone idle.
+ */
+class UNREALBLUEPRINTMCP_API FMCPWorkerPool
+{
+public:
+	FMCPWorkerPool();
+	~FMCPWorkerPool();
+
+	/** Create the worker threads; returns false if the pool is already running or thread creation failed */
+	bool Start(int32 InNumWorkers, int32 InQueueCapacity);
+
+	/** Run OnAbandon for queued items, wait for running items to finish, and destroy the threads */
+	void Shutdown();
+
+	/**
+	 * Change the worker count and queue capacity of a running pool. Queue capacity applies to the
+	 * next admission; a new worker count starts a fresh set of threads and retires the old one.
+	 * Returns false if the new threads could not be created, leaving the pool as it was.
+	 */
+	bool Resize(int32 InNumWorkers, int32 InQueueCapacity);
+
+	/** Check if the pool has been started */
+	bool IsRunning() const { return ThreadPool != nullptr; }
+
+	/**
+	 * Queue Work for a worker thread.
+	 * Returns false without taking ownership of anything if the pool is saturated.
+	 * OnAbandon runs instead of Work if the pool shuts down before Work starts.
+	 */
+	bool TryEnqueue(TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnAbandon);
+
+	/** Get a snapshot of the pool counters */
+	FMCPWorkerPoolStats GetStats() const;
+
+private:
+	class FWorkItem;
+
+	/** One set of threads; a resize replaces the current generation and retires the old one */
+	struct FGeneration
+	{
+		FQueuedThreadPool* ThreadPool = nullptr;
+
+		/** Items admitted to this generation and not yet finished */
+		FThreadSafeCounter PendingItems;
+	};
+
+	void OnItemStarted();
+	void OnItemFinished(uint64 BusyCycles);
+
+	/** Create NumThreads workers, or nullptr */
+	static FQueuedThreadPool* CreateThreads(int32 NumThreads);
+
+	/** Destroy retired generations that have no items left; with bForce, abandon their queued items instead */
+	void DestroyRetiredGenerations(bool bForce);
+
+	/** Threads of the current generation, or nullptr when stopped */
+	FQueuedThreadPool* ThreadPool;
+
+	/** Current generation; TryEnqueue() reads it under GenerationLock */
+	TSharedPtr<FGeneration, ESPMode::ThreadSafe> Current;
+
+	/** Generations replaced by Resize() that may still be running items */
+	TArray<TSharedPtr<FGeneration, ESPMode::ThreadSafe>> Retired;
+
+	/** Guards Current, ThreadPool and Retired */
+	mutable FRWLock GenerationLock;
+
+	std::atomic<int32> NumWorkers;
+	std::atomic<int32> QueueCapacity;
+
+	/** Items admitted and not yet finished (queued + running) */
+	FThreadSafeCounter PendingItems;
+
+	/** Items currently running */
+	FThreadSafeCounter ActiveItems;
+
+	std::atomic<int32> PeakQueueDepth;
+	FThreadSafeCounter64 CompletedItems;
+	FThreadSafeCounter64 RejectedItems;
+	FThreadSafeCounter64 BusyCycles;
+
+	/** FPlatformTime::Cycles64() when the pool started */
+	uint64 StartCycles;
+};
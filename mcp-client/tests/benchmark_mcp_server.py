@@ -0,0 +1,1245 @@
+#!/usr/bin/env python3
+"""
+UnrealBlueprintMCP Server Benchmark Script
+
+Measures latency and throughput of the UnrealBlueprintMCP JSON-RPC server.
+Make sure the Unreal Editor with the plugin is running before executing this script.
+
+Results can be saved to a JSON file and compared against a previous run, which is
+how changes to the server are evaluated (e.g. run once against the old build with
+--save before.json, then against the new build with --compare before.json).
+
+Usage:
+    python benchmark_mcp_server.py                       # run all scenarios
+    python benchmark_mcp_server.py connect               # run a single scenario
+    python benchmark_mcp_server.py --save after.json --compare before.json
+
+Author: UnrealBlueprintMCP Team
+Version: 1.0
+"""
+
+import argparse
+import base64
+import gzip
+import json
+import os
+import socket
+import statistics
+import struct
+import sys
+import threading
+import time
+from typing import Any, Callable, Dict, List, Optional
+
+DEFAULT_HOST = "127.0.0.1"
+DEFAULT_PORT = 8080
+
+
+def build_http_request(method: str, params: Optional[Dict[str, Any]] = None, request_id: Any = 1,
+                       extra_headers: Optional[Dict[str, str]] = None) -> bytes:
+    """Build a raw HTTP/1.1 POST carrying a single JSON-RPC request"""
+    payload: Dict[str, Any] = {"jsonrpc": "2.0", "method": method, "id": request_id}
+    if params is not None:
+        payload["params"] = params
+    body = json.dumps(payload).encode("utf-8")
+
+    headers = {
+        "Host": "localhost",
+        "Content-Type": "application/json",
+        "Content-Length": str(len(body)),
+    }
+    if extra_headers:
+        headers.update(extra_headers)
+
+    head = "POST / HTTP/1.1\r\n" + "".join(f"{k}: {v}\r\n" for k, v in headers.items()) + "\r\n"
+    return head.encode("ascii") + body
+
+
+def read_http_response(sock: socket.socket, on_first_byte: Optional[Callable[[], None]] = None) -> bytes:
+    """
+    Read one complete HTTP response from the socket and return head + de-chunked body.
+
+    Handles both Content-Length and Transfer-Encoding: chunked framing. on_first_byte is
+    called as soon as the first bytes of the response arrive.
+    """
+    data = b""
+    while b"\r\n\r\n" not in data:
+        chunk = sock.recv(65536)
+        if not chunk:
+            return data
+        if not data and on_first_byte:
+            on_first_byte()
+        data += chunk
+
+    head, _, rest = data.partition(b"\r\n\r\n")
+    content_length = 0
+    chunked = False
+    for line in head.split(b"\r\n")[1:]:
+        name, _, value = line.partition(b":")
+        name = name.strip().lower()
+        if name == b"content-length":
+            content_length = int(value.strip())
+        elif name == b"transfer-encoding" and b"chunked" in value.lower():
+            chunked = True
+
+    if not chunked:
+        body = rest
+        while len(body) < content_length:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            body += chunk
+        return head + b"\r\n\r\n" + body
+
+    buffer = bytearray(rest)
+    parts: List[bytes] = []
+
+    def fill(minimum: int) -> bool:
+        while len(buffer) < minimum:
+            more = sock.recv(65536)
+            if not more:
+                return False
+            buffer.extend(more)
+        return True
+
+    while True:
+        while b"\r\n" not in buffer:
+            if not fill(len(buffer) + 1):
+                return head + b"\r\n\r\n" + b"".join(parts)
+        line_end = buffer.index(b"\r\n")
+        size = int(bytes(buffer[:line_end]).split(b";")[0], 16)
+        del buffer[:line_end + 2]
+        if size == 0:
+            fill(2)
+            break
+        if not fill(size + 2):
+            parts.append(bytes(buffer))
+            break
+        parts.append(bytes(buffer[:size]))
+        del buffer[:size + 2]
+    return head + b"\r\n\r\n" + b"".join(parts)
+
+
+def websocket_connect(host: str, port: int) -> socket.socket:
+    """Open a WebSocket connection using only the standard library; returns the upgraded socket"""
+    sock = socket.create_connection((host, port), timeout=10)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    key = base64.b64encode(os.urandom(16)).decode("ascii")
+    sock.sendall((f"GET / HTTP/1.1\r\nHost: {host}:{port}\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                  f"Sec-WebSocket-Key: {key}\r\nSec-WebSocket-Version: 13\r\n\r\n").encode("ascii"))
+
+    head = b""
+    while b"\r\n\r\n" not in head:
+        chunk = sock.recv(1)
+        if not chunk:
+            raise RuntimeError("connection closed during WebSocket handshake")
+        head += chunk
+    if not head.startswith(b"HTTP/1.1 101"):
+        sock.close()
+        status_line = head.split(b"\r\n", 1)[0].decode("latin-1")
+        raise RuntimeError(f"WebSocket upgrade refused: {status_line}")
+    return sock
+
+
+def websocket_send(sock: socket.socket, payload: bytes, opcode: int = 0x1) -> None:
+    """Send one masked client frame"""
+    header = bytes([0x80 | opcode])
+    if len(payload) < 126:
+        header += bytes([0x80 | len(payload)])
+    elif len(payload) <= 0xFFFF:
+        header += bytes([0x80 | 126]) + struct.pack("!H", len(payload))
+    else:
+        header += bytes([0x80 | 127]) + struct.pack("!Q", len(payload))
+    mask = os.urandom(4)
+    masked = bytes(b ^ mask[i & 3] for i, b in enumerate(payload))
+    sock.sendall(header + mask + masked)
+
+
+def websocket_recv(sock: socket.socket) -> bytes:
+    """Receive the next text message, answering pings and skipping server notifications"""
+    def read_exact(count: int) -> bytes:
+        data = b""
+        while len(data) < count:
+            chunk = sock.recv(count - len(data))
+            if not chunk:
+                raise RuntimeError("WebSocket connection closed")
+            data += chunk
+        return data
+
+    while True:
+        first, second = read_exact(2)
+        length = second & 0x7F
+        if length == 126:
+            length = struct.unpack("!H", read_exact(2))[0]
+        elif length == 127:
+            length = struct.unpack("!Q", read_exact(8))[0]
+        payload = read_exact(length)
+        opcode = first & 0x0F
+        if opcode == 0x9:
+            websocket_send(sock, payload, 0xA)
+        elif opcode == 0x8:
+            raise RuntimeError("server closed the WebSocket session")
+        elif opcode == 0x1 and b'"id"' in payload:
+            return payload
+
+
+def raise_open_file_limit(minimum: int) -> None:
+    """Lift the soft descriptor limit so a scenario can hold many sockets open (POSIX only)"""
+    try:
+        import resource
+    except ImportError:
+        return
+    soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+    if soft != resource.RLIM_INFINITY and soft < minimum:
+        target = minimum if hard == resource.RLIM_INFINITY else min(minimum, hard)
+        resource.setrlimit(resource.RLIMIT_NOFILE, (target, hard))
+
+
+def summarize(samples_ms: List[float]) -> Dict[str, float]:
+    """Reduce raw latency samples to the percentiles we report"""
+    if not samples_ms:
+        return {"count": 0}
+    ordered = sorted(samples_ms)
+
+    def percentile(p: float) -> float:
+        index = min(len(ordered) - 1, int(round(p / 100.0 * (len(ordered) - 1))))
+        return ordered[index]
+
+    return {
+        "count": len(ordered),
+        "mean_ms": statistics.fmean(ordered),
+        "p50_ms": percentile(50),
+        "p90_ms": percentile(90),
+        "p99_ms": percentile(99),
+        "max_ms": ordered[-1],
+    }
+
+
+class MCPServerBenchmark:
+    """Collection of benchmark scenarios run against a live MCP server"""
+
+    def __init__(self, host: str = DEFAULT_HOST, port: int = DEFAULT_PORT, iterations: int = 500,
+                 unix_socket: Optional[str] = None):
+        self.host = host
+        self.port = port
+        self.iterations = iterations
+        self.unix_socket = unix_socket
+        self.results: Dict[str, Dict[str, Any]] = {}
+
+    def scenarios(self) -> Dict[str, Callable[[], Dict[str, Any]]]:
+        """All available scenarios keyed by name, in execution order"""
+        return {
+            "connect": self.bench_connect,
+            "keepalive": self.bench_keepalive,
+            "parser": self.bench_parser,
+            "request_parse": self.bench_request_parse,
+            "burst": self.bench_burst,
+            "response": self.bench_response,
+            "streaming": self.bench_streaming,
+            "result_write": self.bench_result_write,
+            "result_cache": self.bench_result_cache,
+            "compression": self.bench_compression,
+            "batch": self.bench_batch,
+            "game_thread": self.bench_game_thread,
+            "game_thread_waits": self.bench_game_thread_waits,
+            "tool_batch": self.bench_tool_batch,
+            "registry_reads": self.bench_registry_reads,
+            "websocket": self.bench_websocket,
+            "local": self.bench_local,
+            "idle": self.bench_idle,
+        }
+
+    def open_connection(self) -> socket.socket:
+        sock = socket.create_connection((self.host, self.port), timeout=10)
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        return sock
+
+    def bench_connect(self) -> Dict[str, Any]:
+        """
+        New-connection latency: connect, send one ping, read the reply, close.
+
+        Every sample pays the full accept path, so this is the number that moves when
+        the listener's accept loop changes.
+        """
+        request = build_http_request("ping")
+        connect_ms: List[float] = []
+        round_trip_ms: List[float] = []
+
+        for _ in range(self.iterations):
+            start = time.perf_counter()
+            sock = self.open_connection()
+            connected = time.perf_counter()
+            try:
+                sock.sendall(request)
+                read_http_response(sock)
+            finally:
+                sock.close()
+            done = time.perf_counter()
+
+            connect_ms.append((connected - start) * 1000.0)
+            round_trip_ms.append((done - start) * 1000.0)
+
+        return {
+            "connect": summarize(connect_ms),
+            "first_request_round_trip": summarize(round_trip_ms),
+        }
+
+    def open_local_connection(self) -> socket.socket:
+        """Connect to the server's Unix domain socket (path from --unix-socket or server.stats)"""
+        path = self.unix_socket or self.server_stats().get("local_socket_path")
+        if not path:
+            raise RuntimeError("local socket is not enabled; turn on Enable Local Socket in the server settings")
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        sock.settimeout(10)
+        sock.connect(path)
+        return sock
+
+    def call(self, sock: socket.socket, method: str, params: Optional[Dict[str, Any]] = None,
+             extra_headers: Optional[Dict[str, str]] = None) -> Dict[str, Any]:
+        """Send one JSON-RPC request on an open connection and decode the JSON body"""
+        sock.sendall(build_http_request(method, params, extra_headers=extra_headers))
+        response = read_http_response(sock)
+        _, _, body = response.partition(b"\r\n\r\n")
+        return json.loads(body.decode("utf-8")) if body else {}
+
+    def server_stats(self) -> Dict[str, Any]:
+        """Fetch the server.stats counters on a fresh connection"""
+        sock = self.open_connection()
+        try:
+            return self.call(sock, "server.stats", extra_headers={"Connection": "close"}).get("result", {})
+        finally:
+            sock.close()
+
+    def bench_keepalive(self) -> Dict[str, Any]:
+        """
+        Small-call latency on one persistent connection vs. a new connection per call.
+
+        Also reports how the server-side connection reuse ratio moved during the run.
+        """
+        stats_before = self.server_stats()
+
+        persistent_ms: List[float] = []
+        sock = self.open_connection()
+        try:
+            for _ in range(self.iterations):
+                start = time.perf_counter()
+                self.call(sock, "ping")
+                persistent_ms.append((time.perf_counter() - start) * 1000.0)
+        finally:
+            sock.close()
+
+        per_call_ms: List[float] = []
+        for _ in range(self.iterations):
+            start = time.perf_counter()
+            sock = self.open_connection()
+            try:
+                self.call(sock, "ping", extra_headers={"Connection": "close"})
+            finally:
+                sock.close()
+            per_call_ms.append((time.perf_counter() - start) * 1000.0)
+
+        stats_after = self.server_stats()
+        served = stats_after.get("requests_served", 0) - stats_before.get("requests_served", 0)
+        reused = stats_after.get("reused_connection_requests", 0) - stats_before.get("reused_connection_requests", 0)
+
+        return {
+            "persistent_connection": summarize(persistent_ms),
+            "connection_per_call": summarize(per_call_ms),
+            "run_connection_reuse_ratio": (reused / served) if served else 0.0,
+            "server_connection_reuse_ratio": stats_after.get("connection_reuse_ratio", 0.0),
+        }
+
+    def bench_parser(self) -> Dict[str, Any]:
+        """
+        Request parsing cost for growing body sizes.
+
+        Each request is a ping padded with an unused parameter, so the handler cost is
+        constant and the time is dominated by receiving and parsing the body.
+        """
+        results: Dict[str, Any] = {}
+        sock = self.open_connection()
+        try:
+            for size in (1024, 100 * 1024, 1024 * 1024, 8 * 1024 * 1024):
+                params = {"padding": "x" * size}
+                samples: List[float] = []
+                for _ in range(max(3, self.iterations // max(1, size // 1024))):
+                    start = time.perf_counter()
+                    response = self.call(sock, "ping", params)
+                    samples.append((time.perf_counter() - start) * 1000.0)
+                    if "result" not in response:
+                        raise RuntimeError(f"ping with {size} byte body failed: {response}")
+                summary = summarize(samples)
+                summary["mb_per_s"] = (size / (1024 * 1024)) / (summary["p50_ms"] / 1000.0) if summary["p50_ms"] else 0.0
+                results[f"body_{size}"] = summary
+        finally:
+            sock.close()
+        return results
+
+    def bench_request_parse(self) -> Dict[str, Any]:
+        """
+        Server-side request decoding cost for 1 KB, 100 KB and 10 MB bodies.
+
+        Each body is a tools.edit_graph call whose nodes_to_add array is sized to fill it, aimed
+        at a Blueprint that does not exist, so the handler returns at once and the work measured
+        is reading the body and decoding the array. Reports the server's parse time and the
+        number of JSON values it had to build per request, alongside client round trips.
+        """
+        node = {"type": "PrintString", "x": 100, "y": 200}
+        node_bytes = len(json.dumps(node)) + 2
+        results: Dict[str, Any] = {}
+        sock = self.open_connection()
+        try:
+            for size in (1024, 100 * 1024, 10 * 1024 * 1024):
+                params = {
+                    "blueprint_path": "/Game/__MCPBenchmark/Missing",
+                    "graph_name": "EventGraph",
+                    "nodes_to_add": [node] * max(1, size // node_bytes),
+                }
+                body_bytes = len(build_http_request("tools.edit_graph", params).partition(b"\r\n\r\n")[2])
+                stats_before = self.server_stats()
+
+                samples: List[float] = []
+                for _ in range(max(3, self.iterations // max(1, size // 1024))):
+                    start = time.perf_counter()
+                    response = self.call(sock, "tools.edit_graph", params)
+                    samples.append((time.perf_counter() - start) * 1000.0)
+                    if "result" not in response:
+                        raise RuntimeError(f"tools.edit_graph with a {size} byte body failed: {response}")
+
+                stats_after = self.server_stats()
+                parsed = stats_after.get("requests_parsed", 0) - stats_before.get("requests_parsed", 0)
+
+                def total(stats: Dict[str, Any], per_request: str) -> float:
+                    return stats.get(per_request, 0.0) * stats.get("requests_parsed", 0)
+
+                summary = summarize(samples)
+                summary["body_bytes"] = body_bytes
+                summary["server_parse_ms"] = ((total(stats_after, "request_parse_ms_per_request")
+                                               - total(stats_before, "request_parse_ms_per_request")) / parsed) if parsed else 0.0
+                summary["server_json_values"] = ((total(stats_after, "request_json_values_per_request")
+                                                  - total(stats_before, "request_json_values_per_request")) / parsed) if parsed else 0.0
+                summary["server_peak_rss_mb"] = stats_after.get("process_peak_used_physical_bytes", 0) / (1024 * 1024)
+                results[f"body_{size}"] = summary
+        finally:
+            sock.close()
+        return results
+
+    def bench_burst(self, clients: int = 64) -> Dict[str, Any]:
+        """
+        A burst of simultaneous clients, each sending one request on its own connection.
+
+        Clients beyond the worker pool and its queue should be turned away quickly with
+        503, so latency of admitted requests stays flat instead of growing with the burst.
+        """
+        request = build_http_request("ping", extra_headers={"Connection": "close"})
+        admitted_ms: List[float] = []
+        rejected_ms: List[float] = []
+        failures: List[str] = []
+        lock = threading.Lock()
+        barrier = threading.Barrier(clients)
+
+        def client() -> None:
+            barrier.wait()
+            start = time.perf_counter()
+            try:
+                sock = self.open_connection()
+                try:
+                    sock.sendall(request)
+                    response = read_http_response(sock)
+                finally:
+                    sock.close()
+            except OSError as e:
+                with lock:
+                    failures.append(str(e))
+                return
+            elapsed = (time.perf_counter() - start) * 1000.0
+            with lock:
+                if response.startswith(b"HTTP/1.1 503"):
+                    rejected_ms.append(elapsed)
+                else:
+                    admitted_ms.append(elapsed)
+
+        for _ in range(max(1, self.iterations // clients)):
+            threads = [threading.Thread(target=client) for _ in range(clients)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            barrier.reset()
+
+        return {
+            "admitted": summarize(admitted_ms),
+            "rejected_503": summarize(rejected_ms),
+            "connection_failures": len(failures),
+            "worker_pool": self.server_stats().get("worker_pool", {}),
+        }
+
+    def bench_response(self) -> Dict[str, Any]:
+        """
+        Response path cost: small-call latency and the server's per-response copy counters.
+
+        The request id carries non-ASCII characters, which the server echoes back, so every
+        response also checks that Content-Length counts UTF-8 bytes rather than characters.
+        """
+        request_id = "응답-ü-✓"
+        request = build_http_request("prompts.list", request_id=request_id)
+        stats_before = self.server_stats()
+
+        samples: List[float] = []
+        body_bytes = 0
+        sock = self.open_connection()
+        try:
+            for _ in range(self.iterations):
+                start = time.perf_counter()
+                sock.sendall(request)
+                response = read_http_response(sock)
+                samples.append((time.perf_counter() - start) * 1000.0)
+
+                head, _, body = response.partition(b"\r\n\r\n")
+                declared = next((int(line.split(b":", 1)[1]) for line in head.split(b"\r\n")[1:]
+                                 if line.lower().startswith(b"content-length:")), -1)
+                if declared != len(body) or json.loads(body.decode("utf-8")).get("id") != request_id:
+                    raise RuntimeError(f"Content-Length {declared} does not frame the {len(body)} byte body")
+                body_bytes = len(body)
+        finally:
+            sock.close()
+
+        stats_after = self.server_stats()
+        sent = stats_after.get("responses_sent", 0) - stats_before.get("responses_sent", 0)
+        sent_bytes = stats_after.get("response_bytes_sent", 0) - stats_before.get("response_bytes_sent", 0)
+
+        return {
+            "prompts_list": summarize(samples),
+            "body_bytes": body_bytes,
+            "run_bytes_sent_per_response": (sent_bytes / sent) if sent else 0.0,
+            "bytes_copied_per_response": stats_after.get("bytes_copied_per_response", 0.0),
+            "allocations_per_response": stats_after.get("allocations_per_response", 0.0),
+        }
+
+    def bench_streaming(self, asset_count: int = 100000) -> Dict[str, Any]:
+        """
+        Time-to-first-byte and server memory for a very large listing.
+
+        Uses diagnostics.synthetic_assets (enable "Diagnostic Methods" in the plugin settings),
+        which streams resources.list-shaped entries without needing 100k real assets. With
+        chunked streaming the first bytes arrive before the listing is complete and the
+        server's peak memory should not grow with the listing size.
+        """
+        request = build_http_request("diagnostics.synthetic_assets", {"count": asset_count})
+        stats_before = self.server_stats()
+
+        ttfb_ms: List[float] = []
+        total_ms: List[float] = []
+        body_bytes = 0
+        chunked = False
+        for _ in range(max(3, self.iterations // 100)):
+            sock = self.open_connection()
+            try:
+                first_byte: List[float] = []
+                start = time.perf_counter()
+                sock.sendall(request)
+                response = read_http_response(sock, lambda: first_byte.append(time.perf_counter()))
+                done = time.perf_counter()
+            finally:
+                sock.close()
+
+            head, _, body = response.partition(b"\r\n\r\n")
+            result = json.loads(body.decode("utf-8")).get("result")
+            if not result or result.get("count") != asset_count or len(result.get("assets", [])) != asset_count:
+                raise RuntimeError("diagnostics.synthetic_assets failed; are diagnostic methods enabled?")
+
+            chunked = b"transfer-encoding: chunked" in head.lower()
+            body_bytes = len(body)
+            ttfb_ms.append(((first_byte[0] if first_byte else done) - start) * 1000.0)
+            total_ms.append((done - start) * 1000.0)
+
+        stats_after = self.server_stats()
+        return {
+            "time_to_first_byte": summarize(ttfb_ms),
+            "total": summarize(total_ms),
+            "asset_count": asset_count,
+            "body_bytes": body_bytes,
+            "chunked": chunked,
+            "server_peak_rss_before_mb": stats_before.get("process_peak_used_physical_bytes", 0) / (1024 * 1024),
+            "server_peak_rss_after_mb": stats_after.get("process_peak_used_physical_bytes", 0) / (1024 * 1024),
+        }
+
+    def bench_result_write(self, path: str = "/Game") -> Dict[str, Any]:
+        """
+        Cost of writing results: resources.list on a real folder, and synthetic listings of 1k,
+        10k and 100k assets (diagnostics.synthetic_assets; enable "Diagnostic Methods").
+
+        Besides client round trips, reports the FJsonValue nodes the server serialized per
+        request. A result written straight into the body costs one, for the id, however many
+        assets it lists; a handler that builds an FJsonObject costs several per asset, each a
+        heap allocation. The server's own server.stats responses are measured once and taken out.
+        """
+        def total_values(stats: Dict[str, Any]) -> float:
+            return stats.get("response_json_values_per_request", 0.0) * stats.get("requests_parsed", 0)
+
+        first = self.server_stats()
+        second = self.server_stats()
+        stats_call_values = total_values(second) - total_values(first)
+
+        cases = [("resources_list", "resources.list", {"path": path})]
+        cases += [(f"synthetic_{count}", "diagnostics.synthetic_assets", {"count": count}) for count in (1000, 10000, 100000)]
+
+        results: Dict[str, Any] = {}
+        sock = self.open_connection()
+        try:
+            for name, method, params in cases:
+                stats_before = self.server_stats()
+                samples: List[float] = []
+                body_bytes = 0
+                for _ in range(max(3, self.iterations // 50)):
+                    start = time.perf_counter()
+                    sock.sendall(build_http_request(method, params))
+                    response = read_http_response(sock)
+                    samples.append((time.perf_counter() - start) * 1000.0)
+
+                    _, _, body = response.partition(b"\r\n\r\n")
+                    if "result" not in json.loads(body.decode("utf-8")):
+                        raise RuntimeError(f"{method} failed; are diagnostic methods enabled?")
+                    body_bytes = len(body)
+
+                stats_after = self.server_stats()
+                parsed = stats_after.get("requests_parsed", 0) - stats_before.get("requests_parsed", 0) - 1
+                values = total_values(stats_after) - total_values(stats_before) - stats_call_values
+
+                summary = summarize(samples)
+                summary["body_bytes"] = body_bytes
+                summary["server_json_values"] = (values / parsed) if parsed > 0 else 0.0
+                summary["server_peak_rss_mb"] = stats_after.get("process_peak_used_physical_bytes", 0) / (1024 * 1024)
+                results[name] = summary
+        finally:
+            sock.close()
+        return results
+
+    def bench_result_cache(self, path: str = "/Game") -> Dict[str, Any]:
+        """
+        Latency of the cacheable read methods with the result cache on and off.
+
+        With the cache on, every sample after the first is a hit: resources.* skip the game
+        thread and prompts.* skip building their result. The "uncached" run sets
+        ResultCacheMegabytes to 0 through diagnostics.apply_settings (enable "Diagnostic
+        Methods"); without it only the cached run is reported.
+        """
+        cases = [
+            ("resources_list", "resources.list", {"path": path}),
+            ("resources_get", "resources.get", {"asset_path": f"{path}/NonExistentAsset"}),
+            ("prompts_get", "prompts.get", {"prompt_name": "create_player_character"}),
+        ]
+
+        def run(sock: socket.socket) -> Dict[str, Any]:
+            measured: Dict[str, Any] = {}
+            for name, method, params in cases:
+                request = build_http_request(method, params)
+                samples: List[float] = []
+                for _ in range(self.iterations):
+                    start = time.perf_counter()
+                    sock.sendall(request)
+                    read_http_response(sock)
+                    samples.append((time.perf_counter() - start) * 1000.0)
+                measured[name] = summarize(samples)
+            return measured
+
+        results: Dict[str, Any] = {}
+        sock = self.open_connection()
+        try:
+            before = self.server_stats().get("result_cache", {})
+            results["cached"] = run(sock)
+            after = self.server_stats().get("result_cache", {})
+            results["cache_hits"] = after.get("hits", 0) - before.get("hits", 0)
+            results["cache_bytes_held"] = after.get("bytes_held", 0)
+
+            disabled = self.call(sock, "diagnostics.apply_settings", {"ResultCacheMegabytes": 0})
+            if "ResultCacheMegabytes" in disabled.get("result", {}).get("applied", []):
+                try:
+                    results["uncached"] = run(sock)
+                finally:
+                    self.call(sock, "diagnostics.apply_settings", {})
+        finally:
+            sock.close()
+        return results
+
+    def bench_compression(self, asset_count: int = 2000) -> Dict[str, Any]:
+        """
+        Wire size and latency of a buffered listing with and without gzip.
+
+        HTTP/1.0 is used so the listing comes back as one buffered body (streamed bodies are
+        never compressed). Requires diagnostic methods to be enabled in the plugin settings.
+        """
+        base = build_http_request("diagnostics.synthetic_assets", {"count": asset_count})
+        base = base.replace(b" HTTP/1.1\r\n", b" HTTP/1.0\r\n", 1)
+        variants = {
+            "identity": base,
+            "gzip": base.replace(b"\r\n\r\n", b"\r\nAccept-Encoding: gzip\r\n\r\n", 1),
+        }
+
+        results: Dict[str, Any] = {}
+        for name, request in variants.items():
+            samples: List[float] = []
+            wire_bytes = 0
+            for _ in range(max(3, self.iterations // 10)):
+                sock = self.open_connection()
+                try:
+                    start = time.perf_counter()
+                    sock.sendall(request)
+                    response = read_http_response(sock)
+                    samples.append((time.perf_counter() - start) * 1000.0)
+                finally:
+                    sock.close()
+
+                head, _, body = response.partition(b"\r\n\r\n")
+                wire_bytes = len(body)
+                if b"content-encoding: gzip" in head.lower():
+                    body = gzip.decompress(body)
+                elif name == "gzip":
+                    raise RuntimeError("gzip was requested but the response is not compressed; is compression enabled?")
+                if json.loads(body.decode("utf-8")).get("result", {}).get("count") != asset_count:
+                    raise RuntimeError("diagnostics.synthetic_assets failed; are diagnostic methods enabled?")
+
+            summary = summarize(samples)
+            summary["wire_bytes"] = wire_bytes
+            results[name] = summary
+
+        stats = self.server_stats()
+        results["server_compression_ratio"] = stats.get("compression_ratio", 0.0)
+        results["server_compression_ms_per_response"] = stats.get("compression_ms_per_response", 0.0)
+        return results
+
+    def bench_batch(self, batch_size: int = 30) -> Dict[str, Any]:
+        """
+        N resources.get calls issued back to back vs. the same calls as one JSON-RPC batch.
+
+        Both variants use one persistent connection, so the difference is round trips and
+        game-thread hops rather than connection setup.
+        """
+        params = {"asset_path": "/Game/NonExistentAsset"}
+        batch = [{"jsonrpc": "2.0", "method": "resources.get", "params": params, "id": i} for i in range(batch_size)]
+        body = json.dumps(batch).encode("utf-8")
+        batch_request = (f"POST / HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\n"
+                         f"Content-Length: {len(body)}\r\n\r\n").encode("ascii") + body
+
+        sequential_ms: List[float] = []
+        batched_ms: List[float] = []
+        sock = self.open_connection()
+        try:
+            for _ in range(max(3, self.iterations // batch_size)):
+                start = time.perf_counter()
+                for _ in range(batch_size):
+                    self.call(sock, "resources.get", params)
+                sequential_ms.append((time.perf_counter() - start) * 1000.0)
+
+                start = time.perf_counter()
+                sock.sendall(batch_request)
+                response = read_http_response(sock)
+                batched_ms.append((time.perf_counter() - start) * 1000.0)
+
+                _, _, response_body = response.partition(b"\r\n\r\n")
+                if len(json.loads(response_body.decode("utf-8"))) != batch_size:
+                    raise RuntimeError("batch response does not contain one entry per request")
+        finally:
+            sock.close()
+
+        return {
+            "sequential": summarize(sequential_ms),
+            "batched": summarize(batched_ms),
+            "batch_size": batch_size,
+        }
+
+    def bench_game_thread(self, batch_size: int = 500, work_ms: float = 1.0) -> Dict[str, Any]:
+        """
+        Editor frame time while a batch of game-thread requests is drained.
+
+        Each entry of the batch busies the game thread for work_ms through
+        diagnostics.game_thread_work (enable "Diagnostic Methods"). The server drains them
+        within GameThreadBudgetMs per frame, so frame_ms should stay near the editor's
+        normal frame time plus the budget however large the batch is. Histogram figures are
+        computed from the server's buckets over this run only.
+        """
+        entries = [{"jsonrpc": "2.0", "method": "diagnostics.game_thread_work", "params": {"work_ms": work_ms}, "id": i}
+                   for i in range(batch_size)]
+        body = json.dumps(entries).encode("utf-8")
+        batch_request = (f"POST / HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\n"
+                         f"Content-Length: {len(body)}\r\n\r\n").encode("ascii") + body
+
+        def delta(after: Dict[str, Any], before: Dict[str, Any]) -> Dict[str, float]:
+            # Buckets are [upper bound in ms, samples]; percentiles are bucket upper bounds
+            counts: Dict[float, float] = {bound: count for bound, count in after.get("buckets", [])}
+            for bound, count in before.get("buckets", []):
+                counts[bound] = counts.get(bound, 0) - count
+            ordered = sorted((bound, count) for bound, count in counts.items() if count > 0)
+            total = sum(count for _, count in ordered)
+            if total == 0:
+                return {"count": 0}
+
+            def percentile(fraction: float) -> float:
+                seen = 0.0
+                for bound, count in ordered:
+                    seen += count
+                    if seen >= fraction * total:
+                        return bound
+                return ordered[-1][0]
+
+            return {"count": total, "p50_ms": percentile(0.50), "p90_ms": percentile(0.90),
+                    "p99_ms": percentile(0.99), "max_ms": ordered[-1][0]}
+
+        batch_ms: List[float] = []
+        sock = self.open_connection()
+        try:
+            if "error" in self.call(sock, "diagnostics.game_thread_work", {"work_ms": 0}):
+                return {"skipped": "diagnostics.game_thread_work is unavailable; enable Diagnostic Methods"}
+
+            before = self.server_stats().get("game_thread", {})
+            for _ in range(max(1, self.iterations // batch_size)):
+                start = time.perf_counter()
+                sock.sendall(batch_request)
+                response = read_http_response(sock)
+                batch_ms.append((time.perf_counter() - start) * 1000.0)
+
+                _, _, response_body = response.partition(b"\r\n\r\n")
+                if len(json.loads(response_body.decode("utf-8"))) != batch_size:
+                    raise RuntimeError("batch response does not contain one entry per request")
+            after = self.server_stats().get("game_thread", {})
+        finally:
+            sock.close()
+
+        return {
+            "batch": summarize(batch_ms),
+            "batch_size": batch_size,
+            "work_ms": work_ms,
+            "budget_ms": after.get("budget_ms", 0.0),
+            "drains": after.get("drains", 0) - before.get("drains", 0),
+            "max_tasks_per_drain": after.get("max_tasks_per_drain", 0),
+            "over_budget_drains": after.get("over_budget_drains", 0) - before.get("over_budget_drains", 0),
+            "frame_ms": delta(after.get("frame_ms", {}), before.get("frame_ms", {})),
+            "drain_ms": delta(after.get("drain_ms", {}), before.get("drain_ms", {})),
+            "queue_wait_ms": delta(after.get("queue_wait_ms", {}), before.get("queue_wait_ms", {})),
+            "execute_ms": delta(after.get("execute_ms", {}), before.get("execute_ms", {})),
+        }
+
+    def bench_game_thread_waits(self, requests_per_client: int = 50) -> Dict[str, Any]:
+        """
+        Throughput of game-thread requests from more keep-alive clients than there are workers.
+
+        Each request waits at least until the next editor frame drains the game-thread queue.
+        A worker that blocked for that wait would cap throughput at one request per worker per
+        frame. Workers now hand the connection back while the request waits, so more requests
+        share each drain. Uses diagnostics.game_thread_work (enable "Diagnostic Methods").
+        """
+        stats = self.server_stats()
+        workers = stats.get("worker_pool", {}).get("workers", 4)
+        clients = workers * 2
+        request = build_http_request("diagnostics.game_thread_work", {"work_ms": 0.1})
+
+        probe = self.open_connection()
+        try:
+            if "error" in self.call(probe, "diagnostics.game_thread_work", {"work_ms": 0}):
+                return {"skipped": "diagnostics.game_thread_work is unavailable; enable Diagnostic Methods"}
+        finally:
+            probe.close()
+
+        latencies_ms: List[float] = []
+        failures: List[str] = []
+        lock = threading.Lock()
+        barrier = threading.Barrier(clients)
+
+        def client() -> None:
+            samples: List[float] = []
+            try:
+                sock = self.open_connection()
+                try:
+                    barrier.wait()
+                    for _ in range(requests_per_client):
+                        start = time.perf_counter()
+                        sock.sendall(request)
+                        read_http_response(sock)
+                        samples.append((time.perf_counter() - start) * 1000.0)
+                finally:
+                    sock.close()
+            except (OSError, threading.BrokenBarrierError) as e:
+                with lock:
+                    failures.append(str(e))
+            with lock:
+                latencies_ms.extend(samples)
+
+        before = self.server_stats().get("game_thread", {})
+        start = time.perf_counter()
+        threads = [threading.Thread(target=client) for _ in range(clients)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        elapsed = time.perf_counter() - start
+        after = self.server_stats().get("game_thread", {})
+
+        return {
+            "workers": workers,
+            "clients": clients,
+            "latency": summarize(latencies_ms),
+            "requests_per_second": len(latencies_ms) / elapsed if elapsed > 0 else 0.0,
+            "deferred_requests": after.get("deferred_requests", 0) - before.get("deferred_requests", 0),
+            "max_tasks_per_drain": after.get("max_tasks_per_drain", 0),
+            "timeouts": after.get("timeouts", 0) - before.get("timeouts", 0),
+            "failures": len(failures),
+        }
+
+    def bench_tool_batch(self, members: int = 100, folder: str = "/Game/MCPBenchmark") -> Dict[str, Any]:
+        """
+        Build a Blueprint with N members (three variables to each function) one call at a time,
+        then build an identical one with a single tools.batch request.
+
+        The batch applies everything in one transaction and refreshes once. Single calls share
+        refreshes while the server's refresh delay is on, and each refreshes its Blueprint with
+        it off. Both timings end with a resources.get of the Blueprint, which runs any refresh
+        still pending, so it is counted. Creates two new Blueprints under folder per run.
+        """
+        stamp = int(time.time() * 1000)
+
+        def operations(blueprint_path: str) -> List[Dict[str, Any]]:
+            ops: List[Dict[str, Any]] = []
+            for index in range(members):
+                if index % 4 == 3:
+                    ops.append({"method": "tools.add_function",
+                                "params": {"blueprint_path": blueprint_path, "function_name": f"Function{index}"}})
+                else:
+                    ops.append({"method": "tools.add_variable",
+                                "params": {"blueprint_path": blueprint_path, "variable_name": f"Variable{index}",
+                                           "variable_type": ("float", "int", "bool")[index % 3]}})
+            return ops
+
+        results: Dict[str, Any] = {"members": members}
+        sock = self.open_connection()
+        try:
+            for variant in ("sequential", "batched"):
+                name = f"BP_ToolBatch_{variant}_{stamp}"
+                created = self.call(sock, "tools.create_blueprint",
+                                    {"blueprint_name": name, "path": folder, "parent_class": "Actor"})
+                if "error" in created.get("result", created):
+                    raise RuntimeError(f"could not create {folder}/{name}: {created}")
+                ops = operations(f"{folder}/{name}")
+
+                before = self.server_stats().get("blueprint_refresh", {})
+                start = time.perf_counter()
+                if variant == "sequential":
+                    for op in ops:
+                        self.call(sock, op["method"], op["params"])
+                else:
+                    response = self.call(sock, "tools.batch", {"operations": ops})
+                    if response.get("result", {}).get("status") != "success":
+                        raise RuntimeError(f"tools.batch failed: {response}")
+                self.call(sock, "resources.get", {"asset_path": f"{folder}/{name}.{name}"})
+                elapsed_ms = (time.perf_counter() - start) * 1000.0
+                after = self.server_stats().get("blueprint_refresh", {})
+
+                results[variant] = {
+                    "total_ms": elapsed_ms,
+                    "ms_per_member": elapsed_ms / members,
+                    "blueprint_refreshes": after.get("refreshes", 0) - before.get("refreshes", 0),
+                    "coalesced": after.get("coalesced", 0) - before.get("coalesced", 0),
+                }
+        finally:
+            sock.close()
+
+        results["speedup"] = results["sequential"]["total_ms"] / max(results["batched"]["total_ms"], 1e-6)
+        return results
+
+    def bench_registry_reads(self, path: str = "/Game", work_ms: float = 30.0, load_clients: int = 2) -> Dict[str, Any]:
+        """
+        resources.list and resources.get latency with an idle editor and under heavy frame load.
+
+        The load is load_clients connections keeping diagnostics.game_thread_work requests of
+        work_ms queued, so every editor frame takes at least that long. Registry reads are served
+        from the worker, so their p50/p99 should barely move under load; anything still waiting
+        for the game thread pays a frame or more. resources.get asks for an asset that does not
+        exist, which the registry answers without loading anything. The result cache is turned
+        off for the run through diagnostics.apply_settings (enable "Diagnostic Methods").
+        """
+        cases = [
+            ("resources_list", build_http_request("resources.list", {"path": path})),
+            ("resources_get", build_http_request("resources.get", {"asset_path": f"{path}/NonExistentAsset.NonExistentAsset"})),
+        ]
+        load_request = build_http_request("diagnostics.game_thread_work", {"work_ms": work_ms})
+
+        def run(sock: socket.socket) -> Dict[str, Any]:
+            measured: Dict[str, Any] = {}
+            for name, request in cases:
+                samples: List[float] = []
+                for _ in range(self.iterations):
+                    start = time.perf_counter()
+                    sock.sendall(request)
+                    read_http_response(sock)
+                    samples.append((time.perf_counter() - start) * 1000.0)
+                measured[name] = summarize(samples)
+            return measured
+
+        stop = threading.Event()
+        failures: List[str] = []
+        lock = threading.Lock()
+
+        def load() -> None:
+            try:
+                sock = self.open_connection()
+                try:
+                    while not stop.is_set():
+                        sock.sendall(load_request)
+                        read_http_response(sock)
+                finally:
+                    sock.close()
+            except OSError as e:
+                with lock:
+                    failures.append(str(e))
+
+        results: Dict[str, Any] = {"work_ms": work_ms, "load_clients": load_clients}
+        sock = self.open_connection()
+        try:
+            if "error" in self.call(sock, "diagnostics.game_thread_work", {"work_ms": 0}):
+                return {"skipped": "diagnostics.game_thread_work is unavailable; enable Diagnostic Methods"}
+            disabled = self.call(sock, "diagnostics.apply_settings", {"ResultCacheMegabytes": 0})
+            if "ResultCacheMegabytes" not in disabled.get("result", {}).get("applied", []):
+                return {"skipped": "could not turn the result cache off"}
+
+            try:
+                before = self.server_stats()
+                results["idle"] = run(sock)
+
+                threads = [threading.Thread(target=load, daemon=True) for _ in range(load_clients)]
+                for thread in threads:
+                    thread.start()
+                time.sleep(0.5)
+                try:
+                    results["loaded"] = run(sock)
+                finally:
+                    stop.set()
+                    for thread in threads:
+                        thread.join()
+                after = self.server_stats()
+            finally:
+                self.call(sock, "diagnostics.apply_settings", {})
+        finally:
+            sock.close()
+
+        for key in ("registry_worker_reads", "registry_game_thread_reads"):
+            results[key] = after.get(key, 0) - before.get(key, 0)
+        results["load_failures"] = len(failures)
+        return results
+
+    def bench_websocket(self) -> Dict[str, Any]:
+        """
+        ping round trips over one WebSocket session vs. one HTTP keep-alive connection.
+
+        Throughput pipelines a window of requests on each transport, which HTTP/1.1
+        clients rarely do but WebSocket clients get for free.
+        """
+        window = 32
+        payloads = [json.dumps({"jsonrpc": "2.0", "method": "ping", "id": i}).encode("utf-8")
+                    for i in range(self.iterations)]
+
+        ws = websocket_connect(self.host, self.port)
+        http = self.open_connection()
+        try:
+            ws_ms: List[float] = []
+            http_ms: List[float] = []
+            for payload in payloads:
+                start = time.perf_counter()
+                websocket_send(ws, payload)
+                websocket_recv(ws)
+                ws_ms.append((time.perf_counter() - start) * 1000.0)
+
+                start = time.perf_counter()
+                self.call(http, "ping")
+                http_ms.append((time.perf_counter() - start) * 1000.0)
+
+            start = time.perf_counter()
+            for first in range(0, len(payloads), window):
+                group = payloads[first:first + window]
+                for payload in group:
+                    websocket_send(ws, payload)
+                for _ in group:
+                    websocket_recv(ws)
+            ws_seconds = time.perf_counter() - start
+
+            start = time.perf_counter()
+            for first in range(0, len(payloads), window):
+                count = len(payloads[first:first + window])
+                http.sendall(build_http_request("ping") * count)
+                for _ in range(count):
+                    read_http_response(http)
+            http_seconds = time.perf_counter() - start
+        finally:
+            ws.close()
+            http.close()
+
+        return {
+            "websocket": summarize(ws_ms),
+            "http_keepalive": summarize(http_ms),
+            "websocket_requests_per_second": len(payloads) / ws_seconds if ws_seconds > 0 else 0.0,
+            "http_requests_per_second": len(payloads) / http_seconds if http_seconds > 0 else 0.0,
+        }
+
+    def bench_local(self, window: int = 32) -> Dict[str, Any]:
+        """
+        Loopback TCP vs. the Unix domain socket listener, same requests on both.
+
+        Latency is one ping at a time on a persistent connection plus the cost of a fresh
+        connection; throughput pipelines a window of pings.
+        """
+        results: Dict[str, Any] = {}
+        for name, connect in (("tcp", self.open_connection), ("unix", self.open_local_connection)):
+            persistent_ms: List[float] = []
+            per_call_ms: List[float] = []
+            sock = connect()
+            try:
+                for _ in range(self.iterations):
+                    start = time.perf_counter()
+                    self.call(sock, "ping")
+                    persistent_ms.append((time.perf_counter() - start) * 1000.0)
+
+                start = time.perf_counter()
+                for first in range(0, self.iterations, window):
+                    count = min(window, self.iterations - first)
+                    sock.sendall(build_http_request("ping") * count)
+                    for _ in range(count):
+                        read_http_response(sock)
+                seconds = time.perf_counter() - start
+            finally:
+                sock.close()
+
+            for _ in range(self.iterations):
+                start = time.perf_counter()
+                sock = connect()
+                try:
+                    self.call(sock, "ping", extra_headers={"Connection": "close"})
+                finally:
+                    sock.close()
+                per_call_ms.append((time.perf_counter() - start) * 1000.0)
+
+            results[f"{name}_persistent"] = summarize(persistent_ms)
+            results[f"{name}_connection_per_call"] = summarize(per_call_ms)
+            results[f"{name}_requests_per_second"] = self.iterations / seconds if seconds > 0 else 0.0
+
+        return results
+
+    def bench_idle(self, idle_connections: int = 1000) -> Dict[str, Any]:
+        """
+        Active-request latency while many other clients hold connections open.
+
+        Half of the extra connections finish a ping and then sit in keep-alive; the other
+        half send half a request and stall. None of them should take a worker away from
+        the measured connection, so latency should barely move and nothing gets a 503.
+        """
+        raise_open_file_limit(idle_connections + 256)
+
+        def measure() -> List[float]:
+            samples_ms: List[float] = []
+            sock = self.open_connection()
+            try:
+                for _ in range(self.iterations):
+                    start = time.perf_counter()
+                    self.call(sock, "ping")
+                    samples_ms.append((time.perf_counter() - start) * 1000.0)
+            finally:
+                sock.close()
+            return samples_ms
+
+        baseline_ms = measure()
+
+        request = build_http_request("ping")
+        idle: List[socket.socket] = []
+        open_failures = 0
+        rejected = 0
+        try:
+            for index in range(idle_connections):
+                try:
+                    sock = self.open_connection()
+                except OSError:
+                    open_failures += 1
+                    continue
+                idle.append(sock)
+                if index % 2 == 0:
+                    sock.sendall(request)
+                    rejected += read_http_response(sock).startswith(b"HTTP/1.1 503")
+                else:
+                    sock.sendall(request[: len(request) // 2])
+
+            stats = self.server_stats()
+            loaded_ms = measure()
+        finally:
+            for sock in idle:
+                sock.close()
+
+        return {
+            "baseline": summarize(baseline_ms),
+            "with_idle_connections": summarize(loaded_ms),
+            "idle_connections_open": len(idle),
+            "open_failures": open_failures,
+            "rejected_503": rejected,
+            "server_parked_connections": stats.get("reactor", {}).get("parked_connections", 0),
+            "server_active_workers": stats.get("worker_pool", {}).get("active_workers", 0),
+        }
+
+    def run(self, selected: List[str]) -> Dict[str, Dict[str, Any]]:
+        available = self.scenarios()
+        for name in selected or list(available.keys()):
+            if name not in available:
+                print(f"❌ Unknown scenario: {name} (available: {', '.join(available)})")
+                continue
+            print(f"\n⏱️  Running scenario: {name}")
+            self.results[name] = available[name]()
+            print(json.dumps(self.results[name], indent=2))
+        return self.results
+
+
+def compare_results(before: Dict[str, Any], after: Dict[str, Any]) -> None:
+    """Print p50/p99 deltas for every metric present in both runs"""
+    print("\n" + "=" * 60)
+    print("📊 COMPARISON (before -> after)")
+    print("=" * 60)
+    for scenario, metrics in after.items():
+        if scenario not in before:
+            continue
+        for metric, values in metrics.items():
+            old = before[scenario].get(metric)
+            if not isinstance(values, dict) or not isinstance(old, dict):
+                continue
+            for key in ("p50_ms", "p99_ms"):
+                if key in values and key in old:
+                    print(f"{scenario}.{metric}.{key}: {old[key]:.3f} -> {values[key]:.3f}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Benchmark the UnrealBlueprintMCP server")
+    parser.add_argument("scenarios", nargs="*", help="Scenarios to run (default: all)")
+    parser.add_argument("--host", default=DEFAULT_HOST)
+    parser.add_argument("--port", type=int, default=DEFAULT_PORT)
+    parser.add_argument("--iterations", type=int, default=500)
+    parser.add_argument("--unix-socket", help="Unix domain socket path for the local scenario (default: ask server.stats)")
+    parser.add_argument("--save", help="Write results to this JSON file")
+    parser.add_argument("--compare", help="Compare against results saved by a previous run")
+    args = parser.parse_args()
+
+    print("🎮 UnrealBlueprintMCP Server Benchmark")
+    print(f"🕒 Started at: {time.strftime('%Y-%m-%d %H:%M:%S')}")
+
+    benchmark = MCPServerBenchmark(args.host, args.port, args.iterations, args.unix_socket)
+    try:
+        results = benchmark.run(args.scenarios)
+    except OSError as e:
+        print(f"\n❌ Cannot reach server at {args.host}:{args.port}: {e}")
+        return 1
+
+    if args.save:
+        with open(args.save, "w", encoding="utf-8") as f:
+            json.dump(results, f, indent=2)
+        print(f"\n💾 Results saved to {args.save}")
+
+    if args.compare:
+        with open(args.compare, "r", encoding="utf-8") as f:
+            compare_results(json.load(f), results)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -10,10 +10,15 @@ Version: 1.3
 """
 
 import json
+import os
+import random
 import requests
+import socket
 import sys
+import threading
 import time
 from typing import Dict, Any, List, Optional
+from urllib.parse import urlparse
 
 class MCPApiTester:
     """Test class for UnrealBlueprintMCP JSON-RPC API"""
@@ -26,8 +31,32 @@ class MCPApiTester:
             server_url: The URL of the MCP server (default: http://localhost:8080)
         """
         self.server_url = server_url
+        parsed = urlparse(server_url)
+        self.host = parsed.hostname or "localhost"
+        self.port = parsed.port or 80
         self.request_id = 1
         self.test_results: List[Dict[str, Any]] = []
+
+    def _post(self, payload: Any, url: Optional[str] = None, timeout: float = 60) -> requests.Response:
+        """POST a raw JSON-RPC payload (a request, a notification or a batch array)"""
+        return requests.post(url or self.server_url, json=payload,
+                             headers={"Content-Type": "application/json"}, timeout=timeout)
+
+    def _call(self, method: str, params: Optional[Dict[str, Any]] = None,
+              url: Optional[str] = None, timeout: float = 60) -> Dict[str, Any]:
+        """Call a method and return the decoded response, errors included"""
+        payload = {"jsonrpc": "2.0", "method": method, "params": params or {}, "id": method}
+        return self._post(payload, url, timeout).json()
+
+    def _record(self, test_name: str, description: str, success: bool, error: str = "") -> None:
+        """Print and record the outcome of one check"""
+        print(f"\n🔍 Testing: {test_name}")
+        print(f"   Description: {description}")
+        print(f"   {'✅ SUCCESS' if success else '❌ FAILED: ' + error}")
+        result: Dict[str, Any] = {"method": test_name, "description": description, "success": success}
+        if not success:
+            result["error"] = error
+        self.test_results.append(result)
         
     def make_request(self, method: str, params: Optional[Dict[str, Any]] = None) -> Dict[str, Any]:
         """
@@ -187,6 +216,21 @@ class MCPApiTester:
         
         # Test getActors
         self.test_method("getActors", description="Get list of actors in current world")
+
+        # Test server.methods; the listing comes from the registry the server dispatches through
+        if self.test_method("server.methods", description="List registered methods"):
+            listed = {entry["name"] for entry in self.test_results[-1]["result"].get("methods", [])}
+            expected = {"ping", "getBlueprints", "getActors", "resources.list", "resources.get", "resources.create",
+                        "tools.create_blueprint", "tools.add_variable", "tools.add_function", "tools.edit_graph", "tools.batch",
+                        "prompts.list", "prompts.get", "server.stats", "server.methods"}
+            missing = sorted(expected - listed)
+            print(f"   {'✅ All built-in methods listed' if not missing else '❌ Missing: ' + ', '.join(missing)}")
+            self.test_results.append({
+                "method": "server.methods",
+                "description": "Listing covers the built-in methods",
+                "success": not missing,
+                **({"error": f"missing {missing}"} if missing else {})
+            })
     
     def test_resources_namespace(self):
         """Test resources namespace methods"""
@@ -365,6 +409,610 @@ class MCPApiTester:
         except Exception as e:
             print(f"   Error testing invalid version: {e}")
     
+    def test_params_validation(self):
+        """Test that typed params are validated with -32602 errors before the handler runs"""
+        print("\n" + "=" * 60)
+        print("🧾 TESTING PARAMS VALIDATION")
+        print("=" * 60)
+
+        cases = [
+            ("resources.get", None, "asset_path", "Missing params object"),
+            ("tools.add_variable", {"blueprint_path": "/Game/BP_Test", "variable_type": "bool"},
+             "variable_name", "Missing required field"),
+            ("tools.add_variable", {"blueprint_path": "/Game/BP_Test", "variable_name": "Flag",
+                                    "variable_type": "bool", "is_public": "yes"},
+             "is_public", "Wrong field type"),
+            ("tools.edit_graph", {"blueprint_path": "/Game/BP_Test", "graph_name": "EventGraph",
+                                  "nodes_to_add": [{"type": "PrintString"}, {"x": 10}]},
+             "nodes_to_add[1].type", "Missing field inside an array element"),
+            ("tools.add_function", ["/Game/BP_Test", "DoThing"], "params must be an object", "Positional params"),
+        ]
+
+        for method, params, field, description in cases:
+            payload: Dict[str, Any] = {"jsonrpc": "2.0", "method": method, "id": 1}
+            if params is not None:
+                payload["params"] = params
+            try:
+                response = self._post(payload, timeout=10).json()
+                error = response.get("error", {})
+                success = error.get("code") == -32602 and field in error.get("message", "")
+                self._record(method, description, success, f"unexpected response {response}")
+            except Exception as e:
+                self._record(method, description, False, str(e))
+
+    def test_batch_requests(self):
+        """Test JSON-RPC 2.0 batch requests (array bodies)"""
+        print("\n" + "=" * 60)
+        print("📦 TESTING BATCH REQUESTS")
+        print("=" * 60)
+
+        try:
+            # Mixed batch: worker-safe, game-thread, unknown, invalid entry and a notification
+            batch = [
+                {"jsonrpc": "2.0", "method": "ping", "id": "a"},
+                {"jsonrpc": "2.0", "method": "resources.list", "params": {"path": "/Game"}, "id": "b"},
+                {"jsonrpc": "2.0", "method": "invalid_method", "id": "c"},
+                42,
+                {"jsonrpc": "2.0", "method": "ping"},
+                {"jsonrpc": "2.0", "method": "prompts.list", "id": "d"},
+            ]
+            responses = self._post(batch).json()
+            ids = [r.get("id") for r in responses] if isinstance(responses, list) else []
+            ok = (ids == ["a", "b", "c", None, "d"]
+                  and "result" in responses[0] and "result" in responses[1]
+                  and responses[2].get("error", {}).get("code") == -32601
+                  and responses[3].get("error", {}).get("code") == -32600)
+            self._record("batch", "Mixed batch answered in order, notification omitted", ok, f"unexpected response: {responses}")
+
+            # Streamed methods write the same result inside a batch as on their own
+            single = self._post({"jsonrpc": "2.0", "method": "resources.list", "params": {"path": "/Game"}, "id": 1}).json()
+            batched = self._post([{"jsonrpc": "2.0", "method": "resources.list", "params": {"path": "/Game"}, "id": 1},
+                                  {"jsonrpc": "2.0", "method": "resources.get",
+                                   "params": {"asset_path": "/Game/NonExistentAsset"}, "id": 2}]).json()
+            ok = (isinstance(batched, list) and len(batched) == 2
+                  and batched[0].get("result") == single.get("result")
+                  and batched[1].get("result", {}).get("error") == "Asset not found")
+            self._record("batch", "Streamed resources.list and resources.get inside a batch", ok, f"unexpected response: {str(batched)[:200]}")
+
+            # Many reads collapsed into one round trip
+            batch = [{"jsonrpc": "2.0", "method": "resources.get",
+                      "params": {"asset_path": "/Game/NonExistentAsset"}, "id": i} for i in range(30)]
+            responses = self._post(batch).json()
+            ok = isinstance(responses, list) and [r.get("id") for r in responses] == list(range(30))
+            self._record("batch", "30 resources.get calls in one batch", ok, f"unexpected response: {str(responses)[:200]}")
+
+            # Empty batch is a single Invalid Request error
+            response = self._post([]).json()
+            ok = isinstance(response, dict) and response.get("error", {}).get("code") == -32600
+            self._record("batch", "Empty batch rejected", ok, f"unexpected response: {response}")
+
+            # Notifications only: nothing to answer
+            response = self._post([{"jsonrpc": "2.0", "method": "ping"}])
+            self._record("batch", "Notification-only batch returns no body", response.status_code == 204 and not response.content,
+                         f"HTTP {response.status_code}: {response.content[:200]!r}")
+        except Exception as e:
+            self._record("batch", "Batch requests", False, str(e))
+
+    def test_http_robustness(self, mutations_per_seed: int = 5):
+        """Replay the HTTP fuzz corpus (plus random mutations) and check the server survives"""
+        print("\n" + "=" * 60)
+        print("🧪 TESTING HTTP PARSER ROBUSTNESS")
+        print("=" * 60)
+
+        corpus_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fuzz_corpus", "http")
+        if not os.path.isdir(corpus_dir):
+            print(f"   ⚠️  Fuzz corpus not found at {corpus_dir}")
+            return
+
+        rng = random.Random(1234)
+
+        def send_raw(data: bytes) -> None:
+            try:
+                with socket.create_connection((self.host, self.port), timeout=2) as sock:
+                    sock.sendall(data)
+                    sock.shutdown(socket.SHUT_WR)
+                    while sock.recv(65536):
+                        pass
+            except OSError:
+                # Resets and timeouts are acceptable answers to garbage input
+                pass
+
+        def mutate(data: bytes) -> bytes:
+            buffer = bytearray(data)
+            for _ in range(rng.randint(1, 8)):
+                if not buffer:
+                    break
+                position = rng.randrange(len(buffer))
+                action = rng.randint(0, 2)
+                if action == 0:
+                    buffer[position] = rng.randrange(256)
+                elif action == 1:
+                    del buffer[position]
+                else:
+                    buffer.insert(position, rng.choice(b"\r\n: 0123456789"))
+            return bytes(buffer)
+
+        seeds = sorted(f for f in os.listdir(corpus_dir) if f.endswith(".http"))
+        for name in seeds:
+            with open(os.path.join(corpus_dir, name), "rb") as f:
+                seed = f.read()
+
+            send_raw(seed)
+            for _ in range(mutations_per_seed):
+                send_raw(mutate(seed))
+
+            # The server must still answer a well-formed request after every seed
+            self.test_method("ping", description=f"Server alive after fuzz seed '{name}'")
+
+    def test_settings_hot_apply(self, load_threads: int = 4):
+        """Change server settings under continuous load; no request may fail (needs diagnostic methods)"""
+        print("\n" + "=" * 60)
+        print("🔧 TESTING LIVE SETTINGS CHANGES")
+        print("=" * 60)
+
+        def apply(overrides: Dict[str, Any], url: Optional[str] = None) -> Dict[str, Any]:
+            return self._call("diagnostics.apply_settings", overrides, url)
+
+        probe = apply({})
+        if probe.get("error", {}).get("code") == -32601:
+            print("   ⚠️  diagnostics.apply_settings unavailable; enable diagnostic methods in the plugin settings")
+            return
+
+        # Stay within the smallest worker + queue budget below, so no request is turned away with 503
+        changes = [
+            {"MaxClientConnections": 4, "ConnectionQueueSize": 4},
+            {"ServerTimeoutSeconds": 10, "bEnableCORS": True},
+            {"CompressionLevel": "Smallest", "CompressionMinBytes": 0},
+            {"MaxRequestsPerConnection": 3},
+            {"MaxClientConnections": 16, "ConnectionQueueSize": 32, "bEnableCORS": False},
+            {"CompressionLevel": "Disabled", "MaxRequestsPerConnection": 100},
+        ]
+
+        stop = threading.Event()
+        counts = {"ok": 0, "failed": 0}
+        failures: List[str] = []
+        lock = threading.Lock()
+
+        def load() -> None:
+            session = requests.Session()
+            request_id = 0
+            while not stop.is_set():
+                request_id += 1
+                method = "ping" if request_id % 2 else "prompts.list"
+                try:
+                    response = session.post(self.server_url, json={"jsonrpc": "2.0", "method": method, "id": request_id}, timeout=10)
+                    ok = response.status_code == 200 and "result" in response.json()
+                    error = f"HTTP {response.status_code}: {response.text[:100]}"
+                except (requests.exceptions.RequestException, ValueError) as e:
+                    ok, error = False, str(e)
+                with lock:
+                    if ok:
+                        counts["ok"] += 1
+                    else:
+                        counts["failed"] += 1
+                        failures.append(error)
+
+        threads = [threading.Thread(target=load, daemon=True) for _ in range(load_threads)]
+        for thread in threads:
+            thread.start()
+
+        try:
+            for overrides in changes:
+                time.sleep(0.5)
+                response = apply(overrides)
+                rejected = response.get("result", {}).get("rejected", ["<no result>"])
+                self._record("diagnostics.apply_settings", f"Apply {overrides}", not rejected, f"rejected: {rejected} {response.get('error', '')}")
+            time.sleep(0.5)
+        finally:
+            stop.set()
+            for thread in threads:
+                thread.join()
+            apply({})
+
+        self._record("diagnostics.apply_settings", f"{counts['ok']} requests under load while settings changed, {counts['failed']} failed",
+                     counts["ok"] > 0 and counts["failed"] == 0, "; ".join(failures[:3]))
+
+        # A new port is listening before the old one closes, and the old port comes back on restore
+        base_url = self.server_url.rsplit(":", 1)[0]
+        old_port = self.port
+        new_port = old_port + 100
+        moved = apply({"ServerPort": new_port}).get("result", {}).get("port") == new_port
+        new_url = f"{base_url}:{new_port}"
+        try:
+            answered = moved and "result" in self._call("ping", url=new_url, timeout=5)
+        except requests.exceptions.RequestException:
+            answered = False
+        self._record("diagnostics.apply_settings", f"Listener moved to port {new_port}", moved and answered, "new port did not answer")
+        if moved:
+            apply({}, new_url)
+        self.test_method("ping", description=f"Server back on port {old_port} after restoring settings")
+
+    def test_slow_clients(self, timeout_seconds: int = 5):
+        """Stalled clients must not take workers away from others, and must be dropped after ServerTimeoutSeconds"""
+        print("\n" + "=" * 60)
+        print("🐌 TESTING SLOW CLIENTS")
+        print("=" * 60)
+
+        stats = self._call("server.stats").get("result", {})
+        if "reactor" not in stats:
+            print("   ⚠️  server.stats has no reactor section; server predates idle connection handling")
+            return
+        pool = stats.get("worker_pool", {})
+        stalled_count = pool.get("workers", 10) + pool.get("queue_capacity", 10) + 5
+
+        # More half-sent requests than the pool has workers and queue slots
+        body = json.dumps({"jsonrpc": "2.0", "method": "ping", "id": 1}).encode("utf-8")
+        request = (f"POST / HTTP/1.1\r\nHost: {self.host}\r\nContent-Type: application/json\r\n"
+                   f"Content-Length: {len(body)}\r\n\r\n").encode("ascii") + body
+        applied = self._call("diagnostics.apply_settings", {"ServerTimeoutSeconds": timeout_seconds}).get("result", {}).get("applied", [])
+        shortened = "ServerTimeoutSeconds" in applied
+        stalled: List[socket.socket] = []
+        try:
+            for _ in range(stalled_count):
+                sock = socket.create_connection((self.host, self.port), timeout=timeout_seconds * 3)
+                sock.sendall(request[: len(request) // 2])
+                stalled.append(sock)
+
+            try:
+                answered = "result" in self._call("ping", timeout=10)
+                error = ""
+            except (requests.exceptions.RequestException, ValueError) as e:
+                answered, error = False, str(e)
+            self._record("slow clients", f"Ping answered while {stalled_count} clients stall mid-request", answered, error)
+
+            if not shortened:
+                print("   ⚠️  diagnostics.apply_settings unavailable; skipping the read timeout check")
+                return
+
+            # Every stalled client is closed once its request is older than the timeout
+            time.sleep(timeout_seconds + 1)
+            closed = 0
+            for sock in stalled:
+                try:
+                    closed += sock.recv(1) == b""
+                except OSError:
+                    closed += 1
+            read_timeouts = self._call("server.stats").get("result", {}).get("reactor", {}).get("read_timeouts", 0)
+            self._record("slow clients", f"{closed}/{stalled_count} stalled clients closed after {timeout_seconds}s",
+                         closed == stalled_count and read_timeouts >= stalled_count, f"read_timeouts={read_timeouts}")
+        finally:
+            for sock in stalled:
+                sock.close()
+            if shortened:
+                self._call("diagnostics.apply_settings", {})
+
+    def test_result_cache(self):
+        """Read results are replayed from the server cache and dropped when the assets behind them change"""
+        print("\n" + "=" * 60)
+        print("🗃️  TESTING RESULT CACHE")
+        print("=" * 60)
+
+        def cache_stats() -> Dict[str, Any]:
+            return self._call("server.stats").get("result", {}).get("result_cache", {})
+
+        stats = cache_stats()
+        if not stats.get("budget_bytes"):
+            print("   ⚠️  server.stats reports no result cache, or ResultCacheMegabytes is 0")
+            return
+
+        try:
+            # Second call of the same prompt is a hit with an identical result
+            first = self._call("prompts.get", {"prompt_name": "setup_movement"})
+            before = cache_stats()
+            second = self._call("prompts.get", {"prompt_name": "setup_movement"})
+            after = cache_stats()
+            self._record("result cache", "Repeated prompts.get answered from the cache",
+                         "result" in first and first.get("result") == second.get("result") and after["hits"] > before["hits"],
+                         f"hits {before.get('hits')} -> {after.get('hits')}")
+
+            # Params are normalized: the default path and an explicit one share an entry
+            self._call("resources.list", {"path": "/Game"})
+            before = cache_stats()
+            implicit = self._call("resources.list")
+            after = cache_stats()
+            self._record("result cache", "resources.list with default params hits the entry for path /Game",
+                         "result" in implicit and after["hits"] > before["hits"], f"hits {before.get('hits')} -> {after.get('hits')}")
+
+            # Creating a Blueprint drops the cached listing of its folder
+            name = f"CacheTest_{int(time.time())}"
+            folder = "/Game/Blueprints"
+            self._call("resources.list", {"path": folder})
+            created = self._call("tools.create_blueprint", {"blueprint_name": name, "path": folder, "parent_class": "Actor"})
+            listed = self._call("resources.list", {"path": folder}).get("result", {}).get("assets", [])
+            self._record("result cache", "New Blueprint appears in a listing cached before it was created",
+                         "result" in created and any(asset.get("name") == name for asset in listed),
+                         f"{name} missing from {len(listed)} assets")
+
+            # A folder requested with a trailing slash is invalidated like the same folder without one
+            other = f"CacheSlashTest_{int(time.time())}"
+            self._call("resources.list", {"path": f"{folder}/"})
+            self._call("tools.create_blueprint", {"blueprint_name": other, "path": folder, "parent_class": "Actor"})
+            listing = self._call("resources.list", {"path": f"{folder}/"}).get("result", {})
+            self._record("result cache", "A listing requested as folder/ is dropped when an asset is added to folder",
+                         listing.get("path") == folder and any(asset.get("name") == other for asset in listing.get("assets", [])),
+                         f"path {listing.get('path')}, {other} missing from {listing.get('count')} assets")
+
+            # Editing it drops its cached resources.get result
+            asset_path = f"{folder}/{name}.{name}"
+            self._call("resources.get", {"asset_path": asset_path})
+            self._call("tools.add_variable", {"blueprint_path": f"{folder}/{name}", "variable_name": "CachedHealth", "variable_type": "float"})
+            details = self._call("resources.get", {"asset_path": asset_path}).get("result", {}).get("blueprint_details", {})
+            variables = [variable.get("name") for variable in details.get("variables", [])]
+            self._record("result cache", "resources.get reflects a variable added after it was cached", "CachedHealth" in variables, f"variables: {variables}")
+
+            stats = cache_stats()
+            self._record("result cache", f"Cache holds {stats.get('entries')} entries, {stats.get('bytes_held')} bytes, hit rate {stats.get('hit_rate', 0):.2f}",
+                         0 < stats.get("bytes_held", 0) <= stats.get("budget_bytes", 0), f"stats: {stats}")
+        except Exception as e:
+            self._record("result cache", "Result cache", False, str(e))
+
+    def test_game_thread_queue(self):
+        """Game-thread requests are drained in order within the per-frame budget"""
+        print("\n" + "=" * 60)
+        print("🎞️  TESTING GAME-THREAD QUEUE")
+        print("=" * 60)
+
+        def queue_stats() -> Dict[str, Any]:
+            return self._call("server.stats").get("result", {}).get("game_thread", {})
+
+        probe = self._call("diagnostics.game_thread_work", {"work_ms": 0})
+        if "result" not in probe:
+            print("   ⚠️  diagnostics.game_thread_work unavailable; enable Diagnostic Methods to run this test")
+            return
+
+        try:
+            # 200 entries of 2 ms cannot fit one frame's budget, so they must be spread over several drains
+            before = queue_stats()
+            batch = [{"jsonrpc": "2.0", "method": "diagnostics.game_thread_work", "params": {"work_ms": 2}, "id": i}
+                     for i in range(200)]
+            responses = self._post(batch).json()
+            after = queue_stats()
+
+            ids = [response.get("id") for response in responses if "result" in response]
+            self._record("game-thread queue", "Every entry of a 200-entry game-thread batch is answered",
+                         sorted(ids) == list(range(200)), f"{len(ids)} results")
+
+            drains = after.get("drains", 0) - before.get("drains", 0)
+            self._record("game-thread queue", f"Batch drained over {drains} frames within a {after.get('budget_ms')} ms budget",
+                         drains > 1 and after.get("tasks_executed", 0) - before.get("tasks_executed", 0) >= 200,
+                         f"stats: {after}")
+
+            drain_ms = after.get("drain_ms", {})
+            self._record("game-thread queue", f"Drain p99 {drain_ms.get('p99')} ms stays near the budget",
+                         drain_ms.get("p99", 0) <= 2 * after.get("budget_ms", 0) + 2, f"drain_ms: {drain_ms}")
+
+            # More clients than workers all wait on the game thread at once; none of them holds a worker
+            workers = self._call("server.stats").get("result", {}).get("worker_pool", {}).get("workers", 4)
+            clients = workers * 2
+            before = queue_stats()
+            answers: List[Any] = []
+            lock = threading.Lock()
+
+            def client(index: int) -> None:
+                payload = {"jsonrpc": "2.0", "method": "diagnostics.game_thread_work", "params": {"work_ms": 50}, "id": index}
+                answer = self._post(payload).json()
+                with lock:
+                    answers.append(answer)
+
+            threads = [threading.Thread(target=client, args=(index,)) for index in range(clients)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            after = queue_stats()
+
+            deferred = after.get("deferred_requests", 0) - before.get("deferred_requests", 0)
+            self._record("game-thread queue", f"{clients} concurrent game-thread requests with {workers} workers all answered, {deferred} deferred",
+                         sum(1 for answer in answers if "result" in answer) == clients and deferred >= clients,
+                         f"answers: {answers[:3]}, stats: {after}")
+
+            # Loading a Blueprint for resources.get does not hold a worker either. The Blueprint is
+            # new, and the game thread is kept busy meanwhile, so none of the requests is answered
+            # from the result cache.
+            name = f"QueueTest_{int(time.time())}"
+            created = self._call("tools.create_blueprint", {"blueprint_name": name, "path": "/Game/Blueprints", "parent_class": "Actor"})
+            if created.get("result", {}).get("status") != "success":
+                self._record("game-thread queue", "Create a Blueprint to read", False, str(created))
+                return
+            asset_path = f"/Game/Blueprints/{name}.{name}"
+            before = queue_stats()
+            answers = []
+
+            def reader(index: int) -> None:
+                payload = {"jsonrpc": "2.0", "method": "resources.get", "params": {"asset_path": asset_path}, "id": index}
+                answer = self._post(payload).json()
+                with lock:
+                    answers.append(answer)
+
+            busy = threading.Thread(target=self._call, args=("diagnostics.game_thread_work", {"work_ms": 200}))
+            busy.start()
+            time.sleep(0.05)
+            threads = [threading.Thread(target=reader, args=(index,)) for index in range(clients)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            busy.join()
+            after = queue_stats()
+
+            deferred = after.get("deferred_requests", 0) - before.get("deferred_requests", 0)
+            details = sum(1 for answer in answers if "blueprint_details" in answer.get("result", {}))
+            self._record("game-thread queue", f"{clients} concurrent Blueprint resources.get requests with {workers} workers all answered, {deferred} deferred",
+                         details == clients and deferred >= clients,
+                         f"answers: {answers[:3]}, stats: {after}")
+
+            # Methods that compile or create assets advertise a longer timeout than lookups
+            methods = self._call("server.methods").get("result", {}).get("methods", [])
+            timeouts = {method.get("name"): method.get("timeout_seconds") for method in methods}
+            self._record("game-thread queue", "tools.create_blueprint has a longer game-thread timeout than the 5 s default",
+                         (timeouts.get("tools.create_blueprint") or 0) > 5,
+                         f"timeouts: {timeouts}")
+        except Exception as e:
+            self._record("game-thread queue", "Game-thread queue", False, str(e))
+
+    def test_tools_batch(self):
+        """tools.batch applies its operations as one transaction and refreshes each Blueprint once"""
+        print("\n" + "=" * 60)
+        print("📦 TESTING TOOLS BATCH")
+        print("=" * 60)
+
+        def variables(asset_path: str) -> List[str]:
+            details = self._call("resources.get", {"asset_path": asset_path}).get("result", {}).get("blueprint_details", {})
+            return [variable.get("name") for variable in details.get("variables", [])]
+
+        try:
+            name = f"BatchTest_{int(time.time())}"
+            folder = "/Game/Blueprints"
+            blueprint_path = f"{folder}/{name}"
+            asset_path = f"{blueprint_path}.{name}"
+            created = self._call("tools.create_blueprint", {"blueprint_name": name, "path": folder, "parent_class": "Actor"})
+            if created.get("result", {}).get("status") != "success":
+                self._record("tools.batch", "Create a Blueprint to edit", False, str(created))
+                return
+
+            # Five variables and a function with nodes: seven operations, one refresh
+            operations = [{"method": "tools.add_variable",
+                           "params": {"blueprint_path": blueprint_path, "variable_name": f"BatchVar{i}", "variable_type": "int"}}
+                          for i in range(5)]
+            operations.append({"method": "tools.add_function",
+                               "params": {"blueprint_path": blueprint_path, "function_name": "BatchFunction"}})
+            operations.append({"method": "tools.edit_graph",
+                               "params": {"blueprint_path": blueprint_path, "graph_name": "BatchFunction",
+                                          "nodes_to_add": [{"type": "PrintString", "x": 200, "y": 0}]}})
+            # Reading the Blueprint back runs its refresh if it is still waiting for edits to pause
+            before = self._call("server.stats").get("result", {}).get("blueprint_refresh", {})
+            batch = self._call("tools.batch", {"operations": operations}).get("result", {})
+            listed = variables(asset_path)
+            after = self._call("server.stats").get("result", {}).get("blueprint_refresh", {})
+            refreshes = after.get("refreshes", 0) - before.get("refreshes", 0)
+            self._record("tools.batch", f"Seven operations applied with {refreshes} refresh",
+                         batch.get("status") == "success" and len(batch.get("results", [])) == 7 and refreshes == 1,
+                         f"result: {batch}, refreshes: {refreshes}")
+            self._record("tools.batch", "Batched variables are on the Blueprint", all(f"BatchVar{i}" in listed for i in range(5)), f"variables: {listed}")
+
+            # Single edits in a row share one refresh while the refresh delay is on
+            if after.get("delay_ms", 0) > 0:
+                before = after
+                for i in range(5):
+                    self._call("tools.add_variable", {"blueprint_path": blueprint_path, "variable_name": f"SingleVar{i}", "variable_type": "float"})
+                listed = variables(asset_path)
+                after = self._call("server.stats").get("result", {}).get("blueprint_refresh", {})
+                refreshes = after.get("refreshes", 0) - before.get("refreshes", 0)
+                coalesced = after.get("coalesced", 0) - before.get("coalesced", 0)
+                self._record("tools.batch", f"Five single edits refreshed {refreshes} time(s), {coalesced} coalesced",
+                             all(f"SingleVar{i}" in listed for i in range(5)) and refreshes < 5 and coalesced == 5 - refreshes,
+                             f"refresh stats: {after}, variables: {listed}")
+
+            # A failing operation undoes the ones before it
+            failing = self._call("tools.batch", {"operations": [
+                {"method": "tools.add_variable",
+                 "params": {"blueprint_path": blueprint_path, "variable_name": "RolledBack", "variable_type": "bool"}},
+                {"method": "tools.edit_graph",
+                 "params": {"blueprint_path": blueprint_path, "graph_name": "NoSuchGraph", "nodes_to_add": []}},
+            ]}).get("result", {})
+            listed = variables(asset_path)
+            self._record("tools.batch", "A failed batch is rolled back",
+                         failing.get("rolled_back") is True and failing.get("failed_operation") == 1 and "RolledBack" not in listed,
+                         f"result: {failing}, variables: {listed}")
+
+            # A variable name already on the Blueprint fails its operation instead of adding a duplicate
+            duplicate = self._call("tools.batch", {"operations": [
+                {"method": "tools.add_variable",
+                 "params": {"blueprint_path": blueprint_path, "variable_name": "BeforeDuplicate", "variable_type": "int"}},
+                {"method": "tools.add_variable",
+                 "params": {"blueprint_path": blueprint_path, "variable_name": "BatchVar0", "variable_type": "int"}},
+            ]}).get("result", {})
+            listed = variables(asset_path)
+            self._record("tools.batch", "A duplicate variable fails and rolls back its batch",
+                         duplicate.get("rolled_back") is True and duplicate.get("failed_operation") == 1
+                         and "BeforeDuplicate" not in listed and listed.count("BatchVar0") == 1,
+                         f"result: {duplicate}, variables: {listed}")
+
+            # So does a function name the Blueprint already has
+            duplicate = self._call("tools.batch", {"operations": [
+                {"method": "tools.add_variable",
+                 "params": {"blueprint_path": blueprint_path, "variable_name": "BeforeDuplicateFunction", "variable_type": "int"}},
+                {"method": "tools.add_function",
+                 "params": {"blueprint_path": blueprint_path, "function_name": "BatchFunction"}},
+            ]}).get("result", {})
+            listed = variables(asset_path)
+            self._record("tools.batch", "A duplicate function fails and rolls back its batch",
+                         duplicate.get("rolled_back") is True and duplicate.get("failed_operation") == 1
+                         and "already in use" in duplicate.get("error", "") and "BeforeDuplicateFunction" not in listed,
+                         f"result: {duplicate}, variables: {listed}")
+
+            # Bad entries are refused before anything is applied
+            refused = self._call("tools.batch", {"operations": [
+                {"method": "tools.add_variable", "params": {"blueprint_path": blueprint_path, "variable_name": "Unused"}},
+            ]}).get("result", {})
+            self._record("tools.batch", "Missing operation params are reported with the operation index",
+                         refused.get("failed_operation") == 0 and "variable_type" in refused.get("error", "") and "rolled_back" not in refused,
+                         f"result: {refused}")
+            refused = self._call("tools.batch", {"operations": [{"method": "tools.create_blueprint", "params": {}}]}).get("result", {})
+            self._record("tools.batch", "Methods tools.batch cannot apply are refused", "error" in refused, f"result: {refused}")
+
+            # Each operation is charged to the write limit. At 10 requests per second writes get 2,
+            # so a five-operation batch is never granted and is refused without a retry hint.
+            if "result" in self._call("diagnostics.apply_settings", {"RequestRateLimit": 10}):
+                try:
+                    oversized = self._call("tools.batch", {"operations": operations[:5]})
+                finally:
+                    self._call("diagnostics.apply_settings", {})
+                error = oversized.get("error", {})
+                self._record("tools.batch", "A batch costing more than the write limit allows is refused",
+                             error.get("code") == -32029 and error.get("data", {}).get("cost") == 5
+                             and "retry_after_ms" not in error.get("data", {}),
+                             f"response: {oversized}")
+        except Exception as e:
+            self._record("tools.batch", "Tools batch", False, str(e))
+
+    def test_registry_reads(self):
+        """resources.list and registry-only resources.get lookups are answered without the game thread"""
+        print("\n" + "=" * 60)
+        print("🗂️  TESTING REGISTRY READS")
+        print("=" * 60)
+
+        try:
+            methods = self._call("server.methods").get("result", {}).get("methods", [])
+            threading_of = {method.get("name"): method.get("threading") for method in methods}
+            self._record("registry reads", "resources.list and resources.get are served on worker threads",
+                         threading_of.get("resources.list") == "any_thread" and threading_of.get("resources.get") == "any_thread",
+                         f"threading: {threading_of.get('resources.list')}, {threading_of.get('resources.get')}")
+
+            # Fresh paths, so neither answer comes from the result cache
+            stamp = int(time.time() * 1000)
+            before = self._call("server.stats").get("result", {})
+            listed = self._call("resources.list", {"path": f"/Game/RegistryReadTest_{stamp}"}).get("result", {})
+            missing = self._call("resources.get", {"asset_path": f"/Game/RegistryReadTest_{stamp}/Missing.Missing"}).get("result", {})
+            after = self._call("server.stats").get("result", {})
+            worker_reads = after.get("registry_worker_reads", 0) - before.get("registry_worker_reads", 0)
+            game_thread_reads = after.get("registry_game_thread_reads", 0) - before.get("registry_game_thread_reads", 0)
+            self._record("registry reads", f"Two lookups: {worker_reads} on a worker, {game_thread_reads} on the game thread",
+                         listed.get("count") == 0 and missing.get("error") == "Asset not found" and worker_reads + game_thread_reads == 2,
+                         f"list: {listed}, get: {missing}")
+
+            # An existing Blueprint is looked up on the worker and loaded on the game thread, with the
+            # request parked meanwhile instead of holding its worker
+            name = f"RegistryReadTest_{stamp}"
+            created = self._call("tools.create_blueprint", {"blueprint_name": name, "path": "/Game/Blueprints", "parent_class": "Actor"})
+            if created.get("result", {}).get("status") == "success":
+                before = self._call("server.stats").get("result", {})
+                blueprint = self._call("resources.get", {"asset_path": f"/Game/Blueprints/{name}.{name}"}).get("result", {})
+                after = self._call("server.stats").get("result", {})
+                deferred = (after.get("game_thread", {}).get("deferred_requests", 0)
+                            - before.get("game_thread", {}).get("deferred_requests", 0))
+                self._record("registry reads", f"Blueprint details loaded through the deferred path ({deferred} deferred)",
+                             "blueprint_details" in blueprint and deferred >= 1, f"get: {blueprint}")
+            else:
+                self._record("registry reads", "Create a Blueprint to read", False, str(created))
+
+            # Folders are checked before the registry is asked
+            invalid = self._call("resources.list", {"path": "Game/NoLeadingSlash"}).get("result", {})
+            self._record("registry reads", "resources.list refuses a path that is not a content folder",
+                         "error" in invalid and "assets" not in invalid, f"result: {invalid}")
+        except Exception as e:
+            self._record("registry reads", "Registry reads", False, str(e))
+
     def generate_curl_examples(self):
         """Generate curl command examples for manual testing"""
         print("\n" + "=" * 60)
@@ -443,6 +1091,15 @@ def main():
     tester.test_tools_namespace()
     tester.test_prompts_namespace()
     tester.test_error_handling()
+    tester.test_params_validation()
+    tester.test_batch_requests()
+    tester.test_http_robustness()
+    tester.test_settings_hot_apply()
+    tester.test_slow_clients()
+    tester.test_result_cache()
+    tester.test_game_thread_queue()
+    tester.test_tools_batch()
+    tester.test_registry_reads()
     
     # Generate curl examples
     tester.generate_curl_examples()